@@ -0,0 +1,995 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SFML/Window/Context.hpp>
+
+#include "lib/Utilitron/Vector.hpp"
+#include "lib/Utilitron/VectorBatch.hpp"
+
+#include "src/omicron/Omicron.hpp"
+#include "src/omicron/audio/SoftwareMixer.hpp"
+#include "src/omicron/component/Camera.hpp"
+#include "src/omicron/component/Transform.hpp"
+#include "src/omicron/component/physics/CollisionDetector.hpp"
+#include "src/omicron/component/renderable/Renderable.hpp"
+#include "src/omicron/entity/Entity.hpp"
+#include "src/omicron/physics/bounding/BoundingCircle.hpp"
+#include "src/omicron/physics/collision_detect/CollisionDetect.hpp"
+#include "src/omicron/rendering/RenderLists.hpp"
+#include "src/omicron/resource/loader/Loaders.hpp"
+#include "src/omicron/scene/Scene.hpp"
+
+#include "src/entities/level/ShipGrid.hpp"
+
+#include "Benchmark.hpp"
+
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of vectors operated on by each vector benchmark
+static const unsigned VECTOR_COUNT = 1024;
+
+// the number of blocks in the ship used by the ship benchmarks
+static const unsigned SHIP_SIZE = 500;
+
+// the geometry files bundled with the game
+static const char* GEOMETRY_FILES[] = {
+
+    "res/gfx/geometry/level/engine_trail.obj",
+    "res/gfx/geometry/test/box.obj",
+    "res/gfx/geometry/test/monkey.obj",
+    "res/gfx/geometry/test/teapot.obj",
+    "res/gfx/geometry/test/human.obj"
+};
+
+// the explosion sequences bundled with the game and their number of frames
+static const char* EXPLOSION_SEQUENCES[] = {
+
+    "res/gfx/texture/level/fx/block_explosion_1/explosion.png",
+    "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png"
+};
+static const unsigned EXPLOSION_FRAMES = 19;
+
+//------------------------------------------------------------------------------
+//                                    CLASSES
+//------------------------------------------------------------------------------
+
+/******************************************************\
+| A renderable that draws nothing, used to fill lists. |
+\******************************************************/
+class NullRenderable : public omi::Renderable {
+public:
+
+    NullRenderable(int layer, omi::Transform* transform) :
+        omi::Renderable("", layer, transform, omi::Material()) {
+    }
+
+    /** #Override */
+    virtual void render(const omi::RenderView& view) {
+    }
+
+protected:
+
+    /** #Override */
+    virtual bool computeLocalBounds(util::vec::Vector3& centre, float& radius) {
+
+        centre = util::vec::Vector3();
+        radius = 0.5f;
+        return true;
+    }
+};
+
+/******************************************************************\
+| A synthetic entity that moves like a bullet and wraps at bounds. |
+\******************************************************************/
+class BenchEntity : public omi::Entity {
+public:
+
+    BenchEntity(bool parallel, const util::vec::Vector3& velocity) :
+        m_parallel (parallel),
+        m_velocity (velocity),
+        m_transform(NULL) {
+    }
+
+    /** #Override */
+    virtual void init() {
+
+        m_transform = new omi::Transform("",
+            util::vec::Vector3(
+                static_cast<float>(rand() % 120) - 60.0f,
+                static_cast<float>(rand() % 80)  - 40.0f,
+                0.0f),
+            util::vec::Vector3(),
+            util::vec::Vector3(1.0f, 1.0f, 1.0f));
+        m_components.add(m_transform);
+    }
+
+    /** #Override */
+    virtual void update() {
+
+        m_transform->translation += m_velocity;
+        m_transform->rotation.z += 1.0f;
+
+        // wrap around the level bounds
+        if (m_transform->translation.x > 62.0f) {
+
+            m_transform->translation.x -= 124.0f;
+        }
+        else if (m_transform->translation.x < -62.0f) {
+
+            m_transform->translation.x += 124.0f;
+        }
+        if (m_transform->translation.y > 40.0f) {
+
+            m_transform->translation.y -= 80.0f;
+        }
+        else if (m_transform->translation.y < -40.0f) {
+
+            m_transform->translation.y += 80.0f;
+        }
+
+        bench::keep(m_transform->getWorldMatrix());
+    }
+
+    /** #Override */
+    virtual bool isParallelSafe() const {
+
+        return m_parallel;
+    }
+
+private:
+
+    bool m_parallel;
+    util::vec::Vector3 m_velocity;
+    omi::Transform* m_transform;
+};
+
+/*****************************************************\
+| A ship block with only its neighbours and position. |
+\*****************************************************/
+struct BenchBlock {
+
+    BenchBlock(float x, float y) :
+        position (x, y),
+        traversed(false),
+        top      (NULL),
+        bottom   (NULL),
+        left     (NULL),
+        right    (NULL) {
+    }
+
+    util::vec::Vector2 position;
+    bool traversed;
+    BenchBlock* top;
+    BenchBlock* bottom;
+    BenchBlock* left;
+    BenchBlock* right;
+};
+
+/*********************************************\
+| A scene that holds only synthetic entities. |
+\*********************************************/
+class BenchScene : public omi::Scene {
+public:
+
+    BenchScene(unsigned count, bool parallel) :
+        m_count   (count),
+        m_parallel(parallel) {
+    }
+
+    /** #Override */
+    virtual void init() {
+
+        for (unsigned i = 0; i < m_count; ++i) {
+
+            addEntity(new BenchEntity(m_parallel, util::vec::Vector3(
+                static_cast<float>(rand() % 100) / 100.0f - 0.5f,
+                static_cast<float>(rand() % 100) / 100.0f - 0.5f,
+                0.0f)));
+        }
+    }
+
+    /** #Override */
+    virtual bool update() {
+
+        return false;
+    }
+
+    /** #Override */
+    virtual omi::Scene* nextScene() const {
+
+        return NULL;
+    }
+
+private:
+
+    unsigned m_count;
+    bool m_parallel;
+};
+
+/************************************\
+| The RGBA pixels of a loaded image. |
+\************************************/
+struct BenchImage {
+
+    unsigned width;
+    unsigned height;
+    std::vector<unsigned char> pixels;
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** @return a random vector with components between -100 and 100 */
+util::vec::Vector3 randomVector() {
+
+    return util::vec::Vector3(
+        static_cast<float>(rand() % 20000) / 100.0f - 100.0f,
+        static_cast<float>(rand() % 20000) / 100.0f - 100.0f,
+        static_cast<float>(rand() % 20000) / 100.0f - 100.0f);
+}
+
+/** @return the name of a benchmark with a size appended */
+std::string sized(const std::string& name, unsigned size) {
+
+    std::stringstream ss;
+    ss << name << "/" << size;
+    return ss.str();
+}
+
+/** Benchmarks the util::vec operations */
+void benchVectors(bench::Runner& runner) {
+
+    std::vector<util::vec::Vector3> a;
+    std::vector<util::vec::Vector3> b;
+    std::vector<util::vec::Vector3> out(VECTOR_COUNT);
+    std::vector<float> scalars(VECTOR_COUNT);
+    for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+        a.push_back(randomVector());
+        b.push_back(randomVector());
+    }
+
+    runner.run(sized("vec3/add", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            out[i] = a[i] + b[i];
+        }
+        bench::keep(out[0]);
+    });
+    runner.run(sized("vec3/scale", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            out[i] = a[i] * 0.5f;
+        }
+        bench::keep(out[0]);
+    });
+    runner.run(sized("vec3/dot", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            scalars[i] = util::vec::dot(a[i], b[i]);
+        }
+        bench::keep(scalars[0]);
+    });
+    runner.run(sized("vec3/cross", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            out[i] = util::vec::cross(a[i], b[i]);
+        }
+        bench::keep(out[0]);
+    });
+    runner.run(sized("vec3/normalise", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            out[i] = util::vec::normalise(a[i]);
+        }
+        bench::keep(out[0]);
+    });
+    runner.run(sized("vec3/distance", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            scalars[i] = util::vec::distance(a[i], b[i]);
+        }
+        bench::keep(scalars[0]);
+    });
+
+    // the same work done one vector at a time and as a batch
+    util::vec::Vector3Array points;
+    for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+        points.add(a[i]);
+    }
+    util::vec::Vector3 to(b[0]);
+    runner.run(sized("vec3/distance_squared", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            scalars[i] = util::vec::distanceSquared(a[i], to);
+        }
+        bench::keep(scalars[0]);
+    });
+    runner.run(sized("vec3/batch/distance_squared", VECTOR_COUNT), [&] () {
+
+        util::vec::distanceSquared(points, to, &scalars[0]);
+        bench::keep(scalars[0]);
+    });
+    runner.run(sized("vec3/translate", VECTOR_COUNT), [&] () {
+
+        for (unsigned i = 0; i < VECTOR_COUNT; ++i) {
+
+            a[i] += to;
+        }
+        bench::keep(a[0]);
+    });
+    runner.run(sized("vec3/batch/translate", VECTOR_COUNT), [&] () {
+
+        util::vec::translate(points, to);
+        bench::keep(points.x()[0]);
+    });
+    runner.run(sized("vec3/batch/bounds", VECTOR_COUNT), [&] () {
+
+        util::vec::Vector3 min;
+        util::vec::Vector3 max;
+        util::vec::bounds(points, min, max);
+        bench::keep(min);
+        bench::keep(max);
+    });
+}
+
+/** Benchmarks collision detection with varying numbers of detectors */
+void benchCollision(bench::Runner& runner) {
+
+    static const unsigned COUNTS[] = { 16, 64, 256, 1024 };
+
+    for (unsigned c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c) {
+
+        std::string name = sized("collision/update", COUNTS[c]);
+        if (!runner.selected(name)) {
+
+            continue;
+        }
+
+        // scatter detectors across the level
+        std::vector<std::unique_ptr<omi::Transform>> transforms;
+        std::vector<std::unique_ptr<omi::CollisionDetector>> detectors;
+        omi::CollisionDetect::checkGroup("bench", "bench");
+        for (unsigned i = 0; i < COUNTS[c]; ++i) {
+
+            util::vec::Vector3 pos = randomVector();
+            pos.z = 0.0f;
+            transforms.push_back(std::unique_ptr<omi::Transform>(
+                new omi::Transform("", pos * 0.5f, util::vec::Vector3(),
+                    util::vec::Vector3(1.0f, 1.0f, 1.0f))));
+            detectors.push_back(std::unique_ptr<omi::CollisionDetector>(
+                new omi::CollisionDetector("", "bench", NULL)));
+            detectors.back()->addBounding(
+                new omi::BoundingCircle(0.55f, transforms.back().get()));
+            omi::CollisionDetect::addDetector(detectors.back().get());
+        }
+
+        runner.run(name, [] () {
+
+            omi::CollisionDetect::update();
+        });
+
+        for (unsigned i = 0; i < detectors.size(); ++i) {
+
+            omi::CollisionDetect::removeDetector(detectors[i].get());
+        }
+        omi::CollisionDetect::clear();
+    }
+}
+
+/** Benchmarks adding, removing, and sorting render lists */
+void benchRenderLists(bench::Runner& runner) {
+
+    static const unsigned COUNTS[] = { 64, 1024 };
+    static const int LAYERS = 4;
+
+    for (unsigned c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c) {
+
+        std::vector<std::unique_ptr<omi::Transform>> transforms;
+        std::vector<std::unique_ptr<NullRenderable>> renderables;
+        for (unsigned i = 0; i < COUNTS[c]; ++i) {
+
+            transforms.push_back(std::unique_ptr<omi::Transform>(
+                new omi::Transform("", randomVector(), util::vec::Vector3(),
+                    util::vec::Vector3(1.0f, 1.0f, 1.0f))));
+            renderables.push_back(std::unique_ptr<NullRenderable>(
+                new NullRenderable(i % LAYERS, transforms.back().get())));
+        }
+
+        // add every renderable then remove them in the order they were added
+        runner.run(sized("render_lists/add_remove", COUNTS[c]), [&] () {
+
+            omi::RenderLists lists;
+            for (unsigned i = 0; i < renderables.size(); ++i) {
+
+                lists.addRenderable(renderables[i].get());
+            }
+            for (unsigned i = 0; i < renderables.size(); ++i) {
+
+                lists.removeRenderable(renderables[i].get());
+            }
+        });
+
+        // sort a layer by depth from the camera, starting from a shuffled
+        // order each time
+        omi::Transform cameraT("", util::vec::Vector3(0.0f, 0.0f, 50.0f),
+            util::vec::Vector3(), util::vec::Vector3(1.0f, 1.0f, 1.0f));
+        omi::Camera camera("", omi::cam::PERSPECTIVE, &cameraT);
+
+        // cull renderables scattered around the camera, some of which are out
+        // of view
+        omi::RenderLists cullLists;
+        for (unsigned i = 0; i < renderables.size(); ++i) {
+
+            cullLists.addRenderable(renderables[i].get());
+        }
+        runner.run(sized("render_lists/cull", COUNTS[c]), [&] () {
+
+            cullLists.cull(&camera);
+            bench::keep(cullLists.getDrawCount());
+        });
+
+        omi::RenderableDepthSorter sorter;
+        sorter.camera = &camera;
+        std::vector<omi::Renderable*> shuffled;
+        for (unsigned i = 0; i < renderables.size(); ++i) {
+
+            shuffled.push_back(renderables[i].get());
+        }
+        std::random_shuffle(shuffled.begin(), shuffled.end());
+        std::vector<omi::Renderable*> layer;
+        runner.run(sized("render_lists/sort", COUNTS[c]), [&] () {
+
+            layer = shuffled;
+            std::sort(layer.begin(), layer.end(), sorter);
+            bench::keep(layer[0]);
+        });
+    }
+}
+
+/** Benchmarks the component table */
+void benchComponentTable(bench::Runner& runner) {
+
+    static const unsigned COUNTS[] = { 4, 8, 16 };
+
+    for (unsigned c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c) {
+
+        unsigned count = COUNTS[c];
+        std::vector<std::string> ids;
+        for (unsigned i = 0; i < count; ++i) {
+
+            ids.push_back(sized("bench_component", i));
+        }
+
+        runner.run(sized("component_table/add_remove", count), [&] () {
+
+            omi::ComponentTable table;
+            for (unsigned i = 0; i < count; ++i) {
+
+                table.add(new omi::Transform(ids[i], util::vec::Vector3(),
+                    util::vec::Vector3(), util::vec::Vector3()));
+            }
+            for (unsigned i = 0; i < count; ++i) {
+
+                table.remove(ids[i]);
+            }
+        });
+
+        omi::ComponentTable table;
+        for (unsigned i = 0; i < count; ++i) {
+
+            table.add(new omi::Transform(ids[i], util::vec::Vector3(),
+                util::vec::Vector3(), util::vec::Vector3()));
+        }
+        unsigned next = 0;
+        runner.run(sized("component_table/get_by_id", count), [&] () {
+
+            bench::keep(table.get(ids[next]));
+            next = (next + 1) % count;
+        });
+        runner.run(sized("component_table/get_by_type", count), [&] () {
+
+            bench::keep(table.get<omi::Transform>());
+        });
+    }
+}
+
+/** Benchmarks loading the bundled geometry */
+void benchGeometry(bench::Runner& runner) {
+
+    for (unsigned i = 0;
+         i < sizeof(GEOMETRY_FILES) / sizeof(GEOMETRY_FILES[0]); ++i) {
+
+        std::string path(GEOMETRY_FILES[i]);
+        std::string name = "loader/geo_from_wavefront/" +
+            path.substr(path.find_last_of('/') + 1);
+        runner.run(name, [&path] () {
+
+            delete omi::loader::geoFromWavefront(path);
+        });
+    }
+}
+
+/** Benchmarks updating scenes of synthetic entities serially and across
+increasing numbers of worker threads */
+void benchScene(bench::Runner& runner) {
+
+    static const unsigned COUNTS[] = { 256, 4096 };
+    static const unsigned WORKERS[] = { 0, 1, 3, 7 };
+
+    for (unsigned c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c) {
+
+        std::string name = sized("scene/update_entities/serial", COUNTS[c]);
+        if (runner.selected(name)) {
+
+            BenchScene scene(COUNTS[c], false);
+            scene.init();
+            runner.run(name, [&scene] () {
+
+                scene.execute();
+            });
+        }
+
+        for (unsigned w = 0; w < sizeof(WORKERS) / sizeof(WORKERS[0]); ++w) {
+
+            std::string name = sized(sized(
+                "scene/update_entities/parallel", COUNTS[c]) + "/threads",
+                WORKERS[w] + 1);
+            if (!runner.selected(name)) {
+
+                continue;
+            }
+
+            omi::jobSystem.setWorkerCount(WORKERS[w]);
+            BenchScene scene(COUNTS[c], true);
+            scene.init();
+            runner.run(name, [&scene] () {
+
+                scene.execute();
+            });
+        }
+    }
+
+    omi::jobSystem.setWorkerCount(0);
+}
+
+/** Links the block to the blocks it is touching the way the player ship used to
+rebuild itself every frame, kept as a reference for the ship grid */
+void relinkFromContacts(
+        BenchBlock* block,
+        std::map<BenchBlock*, std::vector<BenchBlock*>>& contacts) {
+
+    if (block->traversed) {
+
+        return;
+    }
+    block->traversed = true;
+
+    std::vector<BenchBlock*>& touching = contacts[block];
+    for (unsigned i = 0; i < touching.size(); ++i) {
+
+        BenchBlock* collide = touching[i];
+        float angle = util::vec::angleBetween(
+            block->position, collide->position);
+        if (angle < 0.0f) {
+
+            angle += 360.0f;
+        }
+        if (angle > 45.0f && angle < 135.0f && block->top == NULL) {
+
+            collide->bottom = block;
+            block->top = collide;
+        }
+        else if (angle > 135.0f && angle < 225.0f && block->right == NULL) {
+
+            collide->left = block;
+            block->right = collide;
+        }
+        else if (angle > 225.0f && angle < 315.0f && block->bottom == NULL) {
+
+            collide->top = block;
+            block->bottom = collide;
+        }
+        else if ((angle <= 45.0f || angle >= 315.0f) && block->left == NULL) {
+
+            collide->right = block;
+            block->left = collide;
+        }
+    }
+
+    BenchBlock* neighbours[] = {
+        block->top, block->bottom, block->left, block->right
+    };
+    for (unsigned i = 0; i < 4; ++i) {
+
+        if (neighbours[i] != NULL) {
+
+            relinkFromContacts(neighbours[i], contacts);
+        }
+    }
+}
+
+/** Benchmarks maintaining the topology of a large player ship */
+void benchShip(bench::Runner& runner) {
+
+    // lay the blocks out in a square spiral around the hub
+    std::vector<BenchBlock*> blocks;
+    std::vector<std::pair<int, int>> cells;
+    int x = 0;
+    int y = 0;
+    int dx = 1;
+    int dy = 0;
+    int run = 1;
+    while (blocks.size() < SHIP_SIZE) {
+
+        for (int step = 0; step < run && blocks.size() < SHIP_SIZE; ++step) {
+
+            blocks.push_back(new BenchBlock(
+                static_cast<float>(x), static_cast<float>(y)));
+            cells.push_back(std::make_pair(x, y));
+            x += dx;
+            y += dy;
+        }
+        // turn left, the run grows every second turn
+        int turn = dx;
+        dx = -dy;
+        dy = turn;
+        if (dy == 0) {
+
+            ++run;
+        }
+    }
+
+    runner.run(sized("ship/grid/build", SHIP_SIZE), [&] () {
+
+        ShipGrid<BenchBlock> grid;
+        for (unsigned i = 0; i < blocks.size(); ++i) {
+
+            grid.attach(blocks[i], cells[i].first, cells[i].second);
+        }
+        bench::keep(grid.size());
+    });
+
+    ShipGrid<BenchBlock> grid;
+    for (unsigned i = 0; i < blocks.size(); ++i) {
+
+        grid.attach(blocks[i], cells[i].first, cells[i].second);
+    }
+
+    // a frame where nothing was destroyed
+    runner.run(sized("ship/grid/connectivity_clean", SHIP_SIZE), [&] () {
+
+        bench::keep(grid.removeDisconnected(blocks[0]).size());
+    });
+
+    // destroying a block, the detached blocks are put back afterwards
+    std::map<BenchBlock*, std::pair<int, int>> cellOf;
+    for (unsigned i = 0; i < blocks.size(); ++i) {
+
+        cellOf[blocks[i]] = cells[i];
+    }
+    unsigned next = 1;
+    runner.run(sized("ship/grid/destroy_block", SHIP_SIZE), [&] () {
+
+        BenchBlock* destroyed = blocks[next];
+        next = next % (SHIP_SIZE - 1) + 1;
+        grid.detach(destroyed);
+        std::vector<BenchBlock*> removed = grid.removeDisconnected(blocks[0]);
+        removed.push_back(destroyed);
+        for (unsigned i = 0; i < removed.size(); ++i) {
+
+            const std::pair<int, int>& cell = cellOf[removed[i]];
+            grid.attach(removed[i], cell.first, cell.second);
+        }
+    });
+
+    // the previous approach of relinking every block from its contacts
+    std::map<BenchBlock*, std::vector<BenchBlock*>> contacts;
+    for (unsigned i = 0; i < blocks.size(); ++i) {
+
+        for (unsigned j = 0; j < blocks.size(); ++j) {
+
+            if (i != j && util::vec::distanceSquared(
+                    blocks[i]->position, blocks[j]->position) < 1.21f) {
+
+                contacts[blocks[i]].push_back(blocks[j]);
+            }
+        }
+    }
+    runner.run(sized("ship/contacts/full_rebuild", SHIP_SIZE), [&] () {
+
+        for (unsigned i = 0; i < blocks.size(); ++i) {
+
+            blocks[i]->traversed = false;
+            blocks[i]->top = NULL;
+            blocks[i]->bottom = NULL;
+            blocks[i]->left = NULL;
+            blocks[i]->right = NULL;
+        }
+        relinkFromContacts(blocks[0], contacts);
+    });
+
+    for (unsigned i = 0; i < blocks.size(); ++i) {
+
+        delete blocks[i];
+    }
+}
+
+/** Benchmarks mixing a block of audio with increasing numbers of voices */
+void benchAudio(bench::Runner& runner) {
+
+    static const unsigned VOICES[] = { 8, 32, 128 };
+
+    // a second of noise at a different rate to the mixer so it is resampled
+    std::vector<short> samples(22050);
+    for (unsigned i = 0; i < samples.size(); ++i) {
+
+        samples[i] = static_cast<short>((rand() % 65536) - 32768);
+    }
+
+    for (unsigned v = 0; v < sizeof(VOICES) / sizeof(VOICES[0]); ++v) {
+
+        std::string name = sized("audio/mix/voices", VOICES[v]);
+        if (!runner.selected(name)) {
+
+            continue;
+        }
+
+        omi::SoftwareMixer mixer("");
+        unsigned sound = mixer.loadSamples(
+            &samples[0], static_cast<unsigned>(samples.size()), 1, 22050);
+        mixer.setVoiceCount(VOICES[v]);
+        for (unsigned i = 0; i < VOICES[v]; ++i) {
+
+            mixer.playVoice(i, sound, true, 0.5f);
+        }
+        std::vector<short> output(
+            omi::SoftwareMixer::BLOCK_FRAMES * omi::SoftwareMixer::CHANNELS);
+        runner.run(name, [&] () {
+
+            mixer.render(&output[0], omi::SoftwareMixer::BLOCK_FRAMES);
+            bench::keep(output[0]);
+        });
+    }
+}
+
+/** Loads every frame of an image sequence as RGBA pixels
+@param filePath the path of the sequence (omitting the frame number)
+@param frames the number of frames, starting from 1
+@param images returns the frames that could be loaded */
+void loadSequence(
+        const std::string&             filePath,
+              unsigned                 frames,
+              std::vector<BenchImage>& images) {
+
+    unsigned divider = filePath.find_last_of('.');
+    std::string filename  = filePath.substr(0, divider);
+    std::string extension = filePath.substr(divider + 1);
+
+    for (unsigned i = 1; i <= frames; ++i) {
+
+        std::stringstream ss;
+        ss << filename << "." << i << "." << extension;
+
+        ILuint imageId;
+        ilGenImages(1, &imageId);
+        ilBindImage(imageId);
+        if (ilLoadImage((ILstring) ss.str().c_str()) &&
+            ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE)) {
+
+            BenchImage image;
+            image.width  = ilGetInteger(IL_IMAGE_WIDTH);
+            image.height = ilGetInteger(IL_IMAGE_HEIGHT);
+            const unsigned char* data = ilGetData();
+            image.pixels.assign(
+                data, data + (image.width * image.height * 4));
+            images.push_back(image);
+        }
+        else {
+
+            std::cout << "unable to load " << ss.str() << std::endl;
+        }
+        ilBindImage(0);
+        ilDeleteImages(1, &imageId);
+    }
+}
+
+/** Benchmarks building the mip-map chains of the explosion sequences. With an
+OpenGL context the engine's chains are uploaded and compared against GLU
+building them.
+@param gl if there is an OpenGL context to upload to */
+void benchTextures(bench::Runner& runner, bool gl) {
+
+    static const unsigned WORKERS[] = { 0, 3 };
+
+    ilInit();
+
+    GLuint textureId = 0;
+    if (gl) {
+
+        glGenTextures(1, &textureId);
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    }
+
+    unsigned sequenceCount =
+        sizeof(EXPLOSION_SEQUENCES) / sizeof(EXPLOSION_SEQUENCES[0]);
+    for (unsigned s = 0; s < sequenceCount; ++s) {
+
+        std::string sequence(EXPLOSION_SEQUENCES[s]);
+        std::string directory = sequence.substr(0, sequence.find_last_of('/'));
+        std::string label = directory.substr(directory.find_last_of('/') + 1);
+
+        std::vector<BenchImage> images;
+        loadSequence(sequence, EXPLOSION_FRAMES, images);
+        if (images.empty()) {
+
+            continue;
+        }
+
+        for (unsigned w = 0; w < sizeof(WORKERS) / sizeof(WORKERS[0]); ++w) {
+
+            omi::jobSystem.setWorkerCount(WORKERS[w]);
+
+            std::string name = sized(
+                "texture/mips/omicron/" + label + "/threads", WORKERS[w] + 1);
+            if (runner.selected(name)) {
+
+                std::vector<std::vector<unsigned char> > levels;
+                runner.run(name, [&] () {
+
+                    for (unsigned i = 0; i < images.size(); ++i) {
+
+                        omi::loader::generateMipmaps(
+                            &images[i].pixels[0], images[i].width,
+                            images[i].height, levels);
+                    }
+                    bench::keep(levels.back()[0]);
+                });
+            }
+
+            name = sized(
+                "texture/mips/omicron_upload/" + label + "/threads",
+                WORKERS[w] + 1);
+            if (gl && runner.selected(name)) {
+
+                std::vector<std::vector<unsigned char> > levels;
+                runner.run(name, [&] () {
+
+                    for (unsigned i = 0; i < images.size(); ++i) {
+
+                        const BenchImage& image = images[i];
+                        glTexImage2D(
+                            GL_TEXTURE_2D, 0, GL_RGBA, image.width,
+                            image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                            &image.pixels[0]);
+                        omi::loader::generateMipmaps(
+                            &image.pixels[0], image.width, image.height,
+                            levels);
+                        for (unsigned l = 0; l < levels.size(); ++l) {
+
+                            glTexImage2D(
+                                GL_TEXTURE_2D, l + 1, GL_RGBA,
+                                std::max(image.width  >> (l + 1), 1U),
+                                std::max(image.height >> (l + 1), 1U), 0,
+                                GL_RGBA, GL_UNSIGNED_BYTE, &levels[l][0]);
+                        }
+                    }
+                    glFinish();
+                });
+            }
+        }
+        omi::jobSystem.setWorkerCount(0);
+
+        // the path the texture loader used to take
+        std::string name = "texture/mips/glu/" + label;
+        if (gl && runner.selected(name)) {
+
+            runner.run(name, [&] () {
+
+                for (unsigned i = 0; i < images.size(); ++i) {
+
+                    const BenchImage& image = images[i];
+                    glTexImage2D(
+                        GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height,
+                        0, GL_RGBA, GL_UNSIGNED_BYTE, &image.pixels[0]);
+                    gluBuild2DMipmaps(
+                        GL_TEXTURE_2D, GL_RGBA, image.width, image.height,
+                        GL_RGBA, GL_UNSIGNED_BYTE, &image.pixels[0]);
+                }
+                glFinish();
+            });
+        }
+    }
+
+    if (gl) {
+
+        glDeleteTextures(1, &textureId);
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                 MAIN FUNCTION
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+
+    // parse arguments:
+    //     --filter <text>  only runs benchmarks with names containing the text
+    //     --samples <n>    the minimum number of samples of each benchmark
+    //     --time <ms>      the minimum time spent sampling each benchmark
+    //     --gl             creates an OpenGL context for the benchmarks that
+    //                      upload textures
+    std::string filter;
+    unsigned samples = 50;
+    float minTime = 250.0f;
+    bool gl = false;
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg(argv[i]);
+        if (arg == "--filter" && i + 1 < argc) {
+
+            filter = argv[++i];
+        }
+        else if (arg == "--samples" && i + 1 < argc) {
+
+            samples = static_cast<unsigned>(atoi(argv[++i]));
+        }
+        else if (arg == "--time" && i + 1 < argc) {
+
+            minTime = static_cast<float>(atof(argv[++i]));
+        }
+        else if (arg == "--gl") {
+
+            gl = true;
+        }
+        else {
+
+            std::cout << "unknown argument: " << arg << std::endl;
+        }
+    }
+
+    // benchmarks never touch the window or audio, and only touch OpenGL
+    // through a context of their own when asked to
+    omi::systemSettings.setHeadless(true);
+    srand(0);
+    std::unique_ptr<sf::Context> context;
+    if (gl) {
+
+        context.reset(new sf::Context());
+    }
+
+    bench::Runner runner(filter, samples, minTime);
+    benchVectors(runner);
+    benchCollision(runner);
+    benchRenderLists(runner);
+    benchComponentTable(runner);
+    benchGeometry(runner);
+    benchScene(runner);
+    benchShip(runner);
+    benchAudio(runner);
+    benchTextures(runner, gl);
+
+    return 0;
+}
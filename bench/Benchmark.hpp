@@ -0,0 +1,185 @@
+#ifndef BENCH_BENCHMARK_H_
+#   define BENCH_BENCHMARK_H_
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+#include "lib/Utilitron/TimeUtil.hpp"
+
+namespace bench {
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Stops the compiler from optimising away the computation of a value
+@param value the value that must be computed */
+template <typename T>
+inline void keep(const T& value) {
+
+#ifdef __GNUC__
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/*****************************************************************************\
+| Times benchmarks and reports their statistics. Each sample times a batch of |
+| calls, the batch size is calibrated so that a sample is long enough to be   |
+| measured accurately. Results are written to standard output as one JSON     |
+| object per line.                                                            |
+\*****************************************************************************/
+class Runner {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(Runner);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new benchmark runner
+    @param filter only benchmarks with names containing this are run
+    @param minSamples the minimum number of samples taken of each benchmark
+    @param minTime the minimum time spent sampling each benchmark in
+                   milliseconds */
+    Runner(const std::string& filter, unsigned minSamples, float minTime) :
+        m_filter    (filter),
+        m_minSamples(minSamples),
+        m_minTime   (util::time::msToNs(minTime)) {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return if the benchmark with the given name should be run
+    @param name the name of the benchmark */
+    bool selected(const std::string& name) const {
+
+        return m_filter.empty() || name.find(m_filter) != std::string::npos;
+    }
+
+    /** Times the given function and reports the time taken by each call
+    @param name the name of the benchmark
+    @param f the function to time */
+    void run(const std::string& name, const std::function<void ()>& f) {
+
+        if (!selected(name)) {
+
+            return;
+        }
+
+        // warm up and find how many calls make a measurable sample
+        unsigned batch = 1;
+        while (timeBatch(f, batch) < MIN_SAMPLE_TIME && batch < MAX_BATCH) {
+
+            batch *= 2;
+        }
+
+        // take samples until there are enough and enough time has passed
+        std::vector<double> samples;
+        util::int64 begin = util::time::getMonotonicTime();
+        while (samples.size() < m_minSamples ||
+               (util::time::getMonotonicTime() - begin < m_minTime &&
+                samples.size() < MAX_SAMPLES)) {
+
+            samples.push_back(
+                static_cast<double>(timeBatch(f, batch)) / batch);
+        }
+
+        report(name, samples, batch);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // the shortest time a sample should take in nanoseconds
+    static const util::int64 MIN_SAMPLE_TIME = 20000;
+    // the largest number of calls in a single sample
+    static const unsigned MAX_BATCH = 1 << 20;
+    // the most samples that are taken of a single benchmark
+    static const unsigned MAX_SAMPLES = 100000;
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // only benchmarks with names containing this are run
+    std::string m_filter;
+    // the minimum number of samples to take
+    unsigned m_minSamples;
+    // the minimum time to spend sampling in nanoseconds
+    util::int64 m_minTime;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the time taken to call the function the given number of times
+    in nanoseconds */
+    util::int64 timeBatch(const std::function<void ()>& f, unsigned batch) {
+
+        util::int64 start = util::time::getMonotonicTime();
+        for (unsigned i = 0; i < batch; ++i) {
+
+            f();
+        }
+        return util::time::getMonotonicTime() - start;
+    }
+
+    /** Writes the statistics of a benchmark's samples to standard output
+    @param name the name of the benchmark
+    @param samples the time each call took in each sample in nanoseconds
+    @param batch the number of calls in each sample */
+    void report(
+            const std::string&         name,
+                  std::vector<double>& samples,
+                  unsigned             batch) {
+
+        std::sort(samples.begin(), samples.end());
+
+        double total = 0.0;
+        for (unsigned i = 0; i < samples.size(); ++i) {
+
+            total += samples[i];
+        }
+
+        std::cout << "{\"name\":\"" << name << "\"" <<
+            ",\"iterations\":" <<
+                static_cast<unsigned long long>(samples.size()) * batch <<
+            ",\"samples\":" << samples.size() <<
+            ",\"median_ns\":" << percentile(samples, 0.5) <<
+            ",\"p99_ns\":" << percentile(samples, 0.99) <<
+            ",\"mean_ns\":" << total / samples.size() <<
+            ",\"min_ns\":" << samples.front() << "}" << std::endl;
+    }
+
+    /** @return the value at the given percentile of sorted samples
+    @param samples the sorted samples
+    @param p the percentile between 0 and 1 */
+    static double percentile(const std::vector<double>& samples, double p) {
+
+        unsigned index = static_cast<unsigned>(p * (samples.size() - 1) + 0.5);
+        return samples[index];
+    }
+};
+
+} // namespace bench
+
+#endif
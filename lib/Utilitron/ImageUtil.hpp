@@ -0,0 +1,647 @@
+#ifndef UTILITRON_IMAGEUTIL_H_
+#   define UTILITRON_IMAGEUTIL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// SSE2 is the baseline on x86-64
+#if defined __SSE2__ || defined _M_X64 || \
+    (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define UTILITRON_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace util {
+
+/*****************************************************************************\
+| Utility functions for 8 bit RGBA images. Images can be halved to build      |
+| mip-maps and encoded to and decoded from the BC1 (DXT1) and BC3 (DXT5)      |
+| block compressed formats. Images of any size are supported, the blocks on   |
+| the right and top edges repeat the last column and row of the image.        |
+|                                                                             |
+| Halving averages the channels as they are, so images with alpha should be   |
+| premultiplied first or transparent pixels will bleed into their neighbours. |
+\*****************************************************************************/
+namespace img {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+//! the number of bytes in a pixel
+static const unsigned PIXEL_BYTES = 4;
+//! the width and height of a compressed block in pixels
+static const unsigned BLOCK_SIZE = 4;
+//! the number of bytes in a BC1 block
+static const unsigned BC1_BLOCK_BYTES = 8;
+//! the number of bytes in a BC3 block
+static const unsigned BC3_BLOCK_BYTES = 16;
+
+//------------------------------------------------------------------------------
+//                                HIDDEN FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** #Hidden
+Packs an 8 bit per channel colour into 5:6:5 bits */
+inline unsigned short packColour(const unsigned char* rgb) {
+
+    return static_cast<unsigned short>(
+        ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+}
+
+/** #Hidden
+Unpacks a 5:6:5 colour to 8 bits per channel */
+inline void unpackColour(unsigned short colour, unsigned char* rgb) {
+
+    unsigned r = (colour >> 11) & 31;
+    unsigned g = (colour >> 5)  & 63;
+    unsigned b =  colour        & 31;
+    rgb[0] = static_cast<unsigned char>((r << 3) | (r >> 2));
+    rgb[1] = static_cast<unsigned char>((g << 2) | (g >> 4));
+    rgb[2] = static_cast<unsigned char>((b << 3) | (b >> 2));
+}
+
+/** #Hidden
+Copies the pixels of a block out of an image, repeating the edge pixels
+@param image the image to copy from
+@param width the width of the image
+@param height the height of the image
+@param bx the column of the block
+@param by the row of the block
+@param block returns the 16 pixels of the block */
+inline void fetchBlock(
+        const unsigned char* image,
+              unsigned       width,
+              unsigned       height,
+              unsigned       bx,
+              unsigned       by,
+              unsigned char* block) {
+
+    for (unsigned y = 0; y < BLOCK_SIZE; ++y) {
+
+        unsigned sy = std::min(by * BLOCK_SIZE + y, height - 1);
+        for (unsigned x = 0; x < BLOCK_SIZE; ++x) {
+
+            unsigned sx = std::min(bx * BLOCK_SIZE + x, width - 1);
+            std::copy(image + (sy * width + sx) * PIXEL_BYTES,
+                      image + (sy * width + sx + 1) * PIXEL_BYTES,
+                      block + (y * BLOCK_SIZE + x) * PIXEL_BYTES);
+        }
+    }
+}
+
+/** #Hidden
+Copies the pixels of a block into an image, skipping those past the edges */
+inline void storeBlock(
+        const unsigned char* block,
+              unsigned       width,
+              unsigned       height,
+              unsigned       bx,
+              unsigned       by,
+              unsigned char* image) {
+
+    for (unsigned y = 0; y < BLOCK_SIZE; ++y) {
+
+        unsigned iy = by * BLOCK_SIZE + y;
+        for (unsigned x = 0; x < BLOCK_SIZE; ++x) {
+
+            unsigned ix = bx * BLOCK_SIZE + x;
+            if (ix < width && iy < height) {
+
+                std::copy(block + (y * BLOCK_SIZE + x) * PIXEL_BYTES,
+                          block + (y * BLOCK_SIZE + x + 1) * PIXEL_BYTES,
+                          image + (iy * width + ix) * PIXEL_BYTES);
+            }
+        }
+    }
+}
+
+/** #Hidden
+Encodes the colour of a block into 8 bytes. The end points are the corners of
+the block's bounding box, inset slightly since the ends of the box are rarely
+the colours that are used the most. */
+inline void encodeColour(const unsigned char* block, unsigned char* out) {
+
+    unsigned char min[3] = { 255, 255, 255 };
+    unsigned char max[3] = { 0, 0, 0 };
+    for (unsigned i = 0; i < 16; ++i) {
+
+        for (unsigned c = 0; c < 3; ++c) {
+
+            min[c] = std::min(min[c], block[i * PIXEL_BYTES + c]);
+            max[c] = std::max(max[c], block[i * PIXEL_BYTES + c]);
+        }
+    }
+    for (unsigned c = 0; c < 3; ++c) {
+
+        int inset = (max[c] - min[c]) >> 4;
+        min[c] = static_cast<unsigned char>(min[c] + inset);
+        max[c] = static_cast<unsigned char>(max[c] - inset);
+    }
+
+    // the first colour must be greater for the block to use four colours
+    unsigned short colour0 = packColour(max);
+    unsigned short colour1 = packColour(min);
+    if (colour0 < colour1) {
+
+        std::swap(colour0, colour1);
+    }
+
+    unsigned indices = 0;
+    if (colour0 != colour1) {
+
+        unsigned char palette[4][3];
+        unpackColour(colour0, palette[0]);
+        unpackColour(colour1, palette[1]);
+        for (unsigned c = 0; c < 3; ++c) {
+
+            palette[2][c] = static_cast<unsigned char>(
+                (2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<unsigned char>(
+                (palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+
+        // pick the closest palette entry for each pixel
+        for (unsigned i = 0; i < 16; ++i) {
+
+            unsigned best = 0;
+            int bestDistance = 0;
+            for (unsigned p = 0; p < 4; ++p) {
+
+                int distance = 0;
+                for (unsigned c = 0; c < 3; ++c) {
+
+                    int d = block[i * PIXEL_BYTES + c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (p == 0 || distance < bestDistance) {
+
+                    best = p;
+                    bestDistance = distance;
+                }
+            }
+            indices |= best << (2 * i);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(colour0 & 0xFF);
+    out[1] = static_cast<unsigned char>(colour0 >> 8);
+    out[2] = static_cast<unsigned char>(colour1 & 0xFF);
+    out[3] = static_cast<unsigned char>(colour1 >> 8);
+    for (unsigned i = 0; i < 4; ++i) {
+
+        out[4 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+/** #Hidden
+Decodes 8 bytes of colour into a block
+@param in the encoded colour
+@param fourColours if the block always uses four colours, as BC3 does
+@param block returns the 16 pixels of the block, alpha is only written for
+             BC1 */
+inline void decodeColour(
+        const unsigned char* in,
+              bool           fourColours,
+              unsigned char* block) {
+
+    unsigned short colour0 = static_cast<unsigned short>(in[0] | (in[1] << 8));
+    unsigned short colour1 = static_cast<unsigned short>(in[2] | (in[3] << 8));
+
+    unsigned char palette[4][4];
+    unpackColour(colour0, palette[0]);
+    unpackColour(colour1, palette[1]);
+    for (unsigned p = 0; p < 4; ++p) {
+
+        palette[p][3] = 255;
+    }
+    for (unsigned c = 0; c < 3; ++c) {
+
+        if (fourColours || colour0 > colour1) {
+
+            palette[2][c] = static_cast<unsigned char>(
+                (2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<unsigned char>(
+                (palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+        else {
+
+            palette[2][c] = static_cast<unsigned char>(
+                (palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+    }
+    if (!fourColours && colour0 <= colour1) {
+
+        palette[3][3] = 0;
+    }
+
+    for (unsigned i = 0; i < 16; ++i) {
+
+        unsigned index = (in[4 + i / 4] >> (2 * (i % 4))) & 3;
+        std::copy(palette[index], palette[index] + 3, block + i * PIXEL_BYTES);
+        if (!fourColours) {
+
+            block[i * PIXEL_BYTES + 3] = palette[index][3];
+        }
+    }
+}
+
+/** #Hidden
+Encodes the alpha of a block into 8 bytes using the full range of alpha in
+the block */
+inline void encodeAlpha(const unsigned char* block, unsigned char* out) {
+
+    unsigned char min = 255;
+    unsigned char max = 0;
+    for (unsigned i = 0; i < 16; ++i) {
+
+        min = std::min(min, block[i * PIXEL_BYTES + 3]);
+        max = std::max(max, block[i * PIXEL_BYTES + 3]);
+    }
+
+    out[0] = max;
+    out[1] = min;
+    unsigned long long indices = 0;
+    if (max != min) {
+
+        // the first alpha is greater so the block uses eight alphas
+        unsigned char palette[8];
+        palette[0] = max;
+        palette[1] = min;
+        for (unsigned p = 2; p < 8; ++p) {
+
+            palette[p] = static_cast<unsigned char>(
+                ((8 - p) * max + (p - 1) * min) / 7);
+        }
+        for (unsigned i = 0; i < 16; ++i) {
+
+            unsigned best = 0;
+            int bestDistance = 256;
+            for (unsigned p = 0; p < 8; ++p) {
+
+                int distance =
+                    std::abs(block[i * PIXEL_BYTES + 3] - palette[p]);
+                if (distance < bestDistance) {
+
+                    best = p;
+                    bestDistance = distance;
+                }
+            }
+            indices |= static_cast<unsigned long long>(best) << (3 * i);
+        }
+    }
+    for (unsigned i = 0; i < 6; ++i) {
+
+        out[2 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+/** #Hidden
+Decodes 8 bytes of alpha into a block */
+inline void decodeAlpha(const unsigned char* in, unsigned char* block) {
+
+    unsigned char palette[8];
+    palette[0] = in[0];
+    palette[1] = in[1];
+    if (in[0] > in[1]) {
+
+        for (unsigned p = 2; p < 8; ++p) {
+
+            palette[p] = static_cast<unsigned char>(
+                ((8 - p) * in[0] + (p - 1) * in[1]) / 7);
+        }
+    }
+    else {
+
+        for (unsigned p = 2; p < 6; ++p) {
+
+            palette[p] = static_cast<unsigned char>(
+                ((6 - p) * in[0] + (p - 1) * in[1]) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    unsigned long long indices = 0;
+    for (unsigned i = 0; i < 6; ++i) {
+
+        indices |= static_cast<unsigned long long>(in[2 + i]) << (8 * i);
+    }
+    for (unsigned i = 0; i < 16; ++i) {
+
+        block[i * PIXEL_BYTES + 3] = palette[(indices >> (3 * i)) & 7];
+    }
+}
+
+/** #Hidden
+Compresses an image into blocks of the given size
+@param alpha if the blocks are BC3 and store alpha, otherwise they are BC1 */
+inline void compress(
+        const unsigned char*              image,
+              unsigned                    width,
+              unsigned                    height,
+              bool                        alpha,
+              std::vector<unsigned char>& out) {
+
+    unsigned blockBytes = alpha ? BC3_BLOCK_BYTES : BC1_BLOCK_BYTES;
+    unsigned columns = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    unsigned rows = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    out.resize(columns * rows * blockBytes);
+
+    unsigned char block[16 * PIXEL_BYTES];
+    unsigned char* next = out.empty() ? NULL : &out[0];
+    for (unsigned by = 0; by < rows; ++by) {
+
+        for (unsigned bx = 0; bx < columns; ++bx) {
+
+            fetchBlock(image, width, height, bx, by, block);
+            if (alpha) {
+
+                encodeAlpha(block, next);
+                next += 8;
+            }
+            encodeColour(block, next);
+            next += 8;
+        }
+    }
+}
+
+/** #Hidden
+Decompresses blocks of the given size into an image */
+inline void decompress(
+        const unsigned char*              blocks,
+              unsigned                    width,
+              unsigned                    height,
+              bool                        alpha,
+              std::vector<unsigned char>& out) {
+
+    unsigned columns = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    unsigned rows = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    out.assign(width * height * PIXEL_BYTES, 255);
+
+    unsigned char block[16 * PIXEL_BYTES];
+    std::fill(block, block + 16 * PIXEL_BYTES, 255);
+    for (unsigned by = 0; by < rows; ++by) {
+
+        for (unsigned bx = 0; bx < columns; ++bx) {
+
+            if (alpha) {
+
+                decodeAlpha(blocks, block);
+                blocks += 8;
+            }
+            decodeColour(blocks, alpha, block);
+            blocks += 8;
+            storeBlock(block, width, height, bx, by, &out[0]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** @return the number of bytes an image takes once block compressed
+@param width the width of the image
+@param height the height of the image
+@param blockBytes the number of bytes in each block of the format */
+inline unsigned compressedSize(
+        unsigned width, unsigned height, unsigned blockBytes) {
+
+    return ((width  + BLOCK_SIZE - 1) / BLOCK_SIZE) *
+           ((height + BLOCK_SIZE - 1) / BLOCK_SIZE) * blockBytes;
+}
+
+/** Compresses an image to BC1, alpha is ignored
+@param image the pixels of the image
+@param width the width of the image
+@param height the height of the image
+@param out returns the compressed blocks */
+inline void compressBC1(
+        const unsigned char*              image,
+              unsigned                    width,
+              unsigned                    height,
+              std::vector<unsigned char>& out) {
+
+    compress(image, width, height, false, out);
+}
+
+/** Compresses an image to BC3
+@param image the pixels of the image
+@param width the width of the image
+@param height the height of the image
+@param out returns the compressed blocks */
+inline void compressBC3(
+        const unsigned char*              image,
+              unsigned                    width,
+              unsigned                    height,
+              std::vector<unsigned char>& out) {
+
+    compress(image, width, height, true, out);
+}
+
+/** Decompresses a BC1 image
+@param blocks the compressed blocks
+@param width the width of the image
+@param height the height of the image
+@param out returns the pixels of the image */
+inline void decompressBC1(
+        const unsigned char*              blocks,
+              unsigned                    width,
+              unsigned                    height,
+              std::vector<unsigned char>& out) {
+
+    decompress(blocks, width, height, false, out);
+}
+
+/** Decompresses a BC3 image
+@param blocks the compressed blocks
+@param width the width of the image
+@param height the height of the image
+@param out returns the pixels of the image */
+inline void decompressBC3(
+        const unsigned char*              blocks,
+              unsigned                    width,
+              unsigned                    height,
+              std::vector<unsigned char>& out) {
+
+    decompress(blocks, width, height, true, out);
+}
+
+/** @return the root mean square difference between every channel of two
+images of the same size
+@param a the pixels of the first image
+@param b the pixels of the second image
+@param pixels the number of pixels in each image
+@param alpha if the alpha channel should be compared */
+inline float rootMeanSquareError(
+        const unsigned char* a,
+        const unsigned char* b,
+              unsigned       pixels,
+              bool           alpha) {
+
+    if (pixels == 0) {
+
+        return 0.0f;
+    }
+
+    unsigned channels = alpha ? 4 : 3;
+    double sum = 0.0;
+    for (unsigned i = 0; i < pixels; ++i) {
+
+        for (unsigned c = 0; c < channels; ++c) {
+
+            double d = static_cast<double>(a[i * PIXEL_BYTES + c]) -
+                       static_cast<double>(b[i * PIXEL_BYTES + c]);
+            sum += d * d;
+        }
+    }
+    return static_cast<float>(std::sqrt(sum / (pixels * channels)));
+}
+
+/** @return if every pixel of the image is fully opaque
+@param image the pixels of the image
+@param pixels the number of pixels in the image */
+inline bool isOpaque(const unsigned char* image, unsigned pixels) {
+
+    for (unsigned i = 0; i < pixels; ++i) {
+
+        if (image[i * PIXEL_BYTES + 3] != 255) {
+
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Multiplies the colour of every pixel by its alpha
+@param image the pixels of the image
+@param pixels the number of pixels in the image */
+inline void premultiply(unsigned char* image, unsigned pixels) {
+
+    for (unsigned i = 0; i < pixels; ++i) {
+
+        unsigned char* pixel = image + i * PIXEL_BYTES;
+        unsigned alpha = pixel[3];
+        for (unsigned c = 0; c < 3; ++c) {
+
+            pixel[c] = static_cast<unsigned char>(
+                (pixel[c] * alpha + 127) / 255);
+        }
+    }
+}
+
+/** Divides the colour of every pixel by its alpha, undoing premultiply as
+closely as the precision allows. Fully transparent pixels are left black.
+@param image the pixels of the image
+@param pixels the number of pixels in the image */
+inline void unpremultiply(unsigned char* image, unsigned pixels) {
+
+    for (unsigned i = 0; i < pixels; ++i) {
+
+        unsigned char* pixel = image + i * PIXEL_BYTES;
+        unsigned alpha = pixel[3];
+        if (alpha == 0 || alpha == 255) {
+
+            continue;
+        }
+        for (unsigned c = 0; c < 3; ++c) {
+
+            pixel[c] = static_cast<unsigned char>(
+                std::min((pixel[c] * 255 + alpha / 2) / alpha, 255U));
+        }
+    }
+}
+
+/** Halves a range of rows of an image by averaging each 2x2 square of
+pixels. This allows the rows of one image to be split between threads.
+@param image the pixels of the image
+@param width the width of the image
+@param height the height of the image
+@param out the pixels of the halved image, this must already be the size of
+           the halved image
+@param firstRow the first row of the halved image to write
+@param endRow one past the last row of the halved image to write */
+inline void halveRows(
+        const unsigned char* image,
+              unsigned       width,
+              unsigned       height,
+              unsigned char* out,
+              unsigned       firstRow,
+              unsigned       endRow) {
+
+    unsigned halfWidth = std::max(width / 2, 1U);
+    for (unsigned y = firstRow; y < endRow; ++y) {
+
+        const unsigned char* row0 =
+            image + std::min(y * 2,     height - 1) * width * PIXEL_BYTES;
+        const unsigned char* row1 =
+            image + std::min(y * 2 + 1, height - 1) * width * PIXEL_BYTES;
+        unsigned char* outRow = out + y * halfWidth * PIXEL_BYTES;
+
+        unsigned x = 0;
+#ifdef UTILITRON_SSE2
+        // two output pixels at a time from four pixels of each row, summed
+        // as 16 bit values so the average is exact
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i two = _mm_set1_epi16(2);
+        for (; x * 2 + 4 <= width && x + 2 <= halfWidth; x += 2) {
+
+            __m128i a = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(row0 + x * 2 * PIXEL_BYTES));
+            __m128i b = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(row1 + x * 2 * PIXEL_BYTES));
+            __m128i low = _mm_add_epi16(
+                _mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            __m128i high = _mm_add_epi16(
+                _mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+            high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+            __m128i sum = _mm_unpacklo_epi64(low, high);
+            sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i*>(outRow + x * PIXEL_BYTES),
+                _mm_packus_epi16(sum, zero));
+        }
+#endif
+        for (; x < halfWidth; ++x) {
+
+            unsigned x0 = std::min(x * 2,     width - 1) * PIXEL_BYTES;
+            unsigned x1 = std::min(x * 2 + 1, width - 1) * PIXEL_BYTES;
+            for (unsigned c = 0; c < PIXEL_BYTES; ++c) {
+
+                unsigned sum = row0[x0 + c] + row0[x1 + c] +
+                               row1[x0 + c] + row1[x1 + c];
+                outRow[x * PIXEL_BYTES + c] =
+                    static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+/** Halves the size of an image by averaging each 2x2 square of pixels, a
+dimension that is already 1 stays 1
+@param image the pixels of the image
+@param width the width of the image
+@param height the height of the image
+@param out returns the pixels of the halved image */
+inline void halve(
+        const unsigned char*              image,
+              unsigned                    width,
+              unsigned                    height,
+              std::vector<unsigned char>& out) {
+
+    unsigned halfWidth  = std::max(width  / 2, 1U);
+    unsigned halfHeight = std::max(height / 2, 1U);
+    out.resize(halfWidth * halfHeight * PIXEL_BYTES);
+    halveRows(image, width, height, &out[0], 0, halfHeight);
+}
+
+} // namespace img
+
+} // namespace util
+
+#endif
\ No newline at end of file
@@ -0,0 +1,420 @@
+#ifndef UTILITRON_MATRIX_H_
+#   define UTILITRON_MATRIX_H_
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include "MathUtil.hpp"
+#include "Vector.hpp"
+
+namespace util {
+
+/****************************************\
+| Mutable matrix classes and matrix math |
+\****************************************/
+namespace mat {
+
+/******************************************************************************\
+| A 4x4 matrix of floats stored in column-major order so that it can be passed |
+| directly to OpenGL.                                                          |
+\******************************************************************************/
+class Matrix4 {
+
+    //--------------------------------------------------------------------------
+    //                              FRIEND FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Prints this matrix to the output stream
+    @param output the output steam to print to
+    @param m the matrix to print
+    @return the modified output stream */
+    inline friend std::ostream& operator <<(std::ostream& output,
+        const Matrix4& m) {
+
+        output << m.toString();
+
+        return output;
+    }
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    //! the values of the matrix in column-major order
+    float m[16];
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /** Creates a new identity matrix */
+    inline Matrix4() {
+
+        setIdentity();
+    }
+
+    /** Creates a new matrix by copying the values from the given matrix
+    @param other the matrix to copy from */
+    inline Matrix4(const Matrix4& other) {
+
+        for (unsigned i = 0; i < 16; ++i) {
+
+            m[i] = other.m[i];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    inline ~Matrix4() {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    //--------------------------------ASSIGNMENT--------------------------------
+
+    /** Sets the values of this matrix by copying the values from the other
+    given matrix
+    @param other the matrix to copy from */
+    inline Matrix4& operator =(const Matrix4& other) {
+
+        for (unsigned i = 0; i < 16; ++i) {
+
+            m[i] = other.m[i];
+        }
+
+        return *this;
+    }
+
+    //---------------------------------EQUALITY---------------------------------
+
+    /** @return if this matrix and the other given matrix are equal */
+    inline bool operator ==(const Matrix4& other) const {
+
+        for (unsigned i = 0; i < 16; ++i) {
+
+            if (m[i] != other.m[i]) {
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /** @return if this matrix and the other given matrix are not equal */
+    inline bool operator !=(const Matrix4& other) const {
+
+        return !((*this) == other);
+    }
+
+    //------------------------------MULTIPLICATION------------------------------
+
+    /** Creates a new matrix as the result of multiplying this matrix by the
+    other given matrix
+    @param other the matrix to multiply by
+    @return the result of the multiplication */
+    inline Matrix4 operator *(const Matrix4& other) const {
+
+        Matrix4 result;
+        for (unsigned col = 0; col < 4; ++col) {
+
+            for (unsigned row = 0; row < 4; ++row) {
+
+                result.m[col * 4 + row] =
+                    (m[row     ] * other.m[col * 4    ]) +
+                    (m[row + 4 ] * other.m[col * 4 + 1]) +
+                    (m[row + 8 ] * other.m[col * 4 + 2]) +
+                    (m[row + 12] * other.m[col * 4 + 3]);
+            }
+        }
+
+        return result;
+    }
+
+    /** Multiplies this matrix by the other given matrix
+    @param other the matrix to multiply by */
+    inline void operator *=(const Matrix4& other) {
+
+        *this = (*this) * other;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    //-----------------------STATIC CONSTRUCTOR FUNCTIONS-----------------------
+
+    /** @return the identity matrix */
+    inline static Matrix4 identity() {
+
+        return Matrix4();
+    }
+
+    /** @param t the translation the matrix will apply
+    @return a translation matrix */
+    inline static Matrix4 translation(const vec::Vector3& t) {
+
+        Matrix4 result;
+        result.m[12] = t.x;
+        result.m[13] = t.y;
+        result.m[14] = t.z;
+
+        return result;
+    }
+
+    /** @param angle the rotation in degrees around the x axis
+    @return a rotation matrix around the x axis */
+    inline static Matrix4 rotationX(float angle) {
+
+        float s = math::sind(angle);
+        float c = math::cosd(angle);
+
+        Matrix4 result;
+        result.m[5]  =  c;
+        result.m[6]  =  s;
+        result.m[9]  = -s;
+        result.m[10] =  c;
+
+        return result;
+    }
+
+    /** @param angle the rotation in degrees around the y axis
+    @return a rotation matrix around the y axis */
+    inline static Matrix4 rotationY(float angle) {
+
+        float s = math::sind(angle);
+        float c = math::cosd(angle);
+
+        Matrix4 result;
+        result.m[0]  =  c;
+        result.m[2]  = -s;
+        result.m[8]  =  s;
+        result.m[10] =  c;
+
+        return result;
+    }
+
+    /** @param angle the rotation in degrees around the z axis
+    @return a rotation matrix around the z axis */
+    inline static Matrix4 rotationZ(float angle) {
+
+        float s = math::sind(angle);
+        float c = math::cosd(angle);
+
+        Matrix4 result;
+        result.m[0] =  c;
+        result.m[1] =  s;
+        result.m[4] = -s;
+        result.m[5] =  c;
+
+        return result;
+    }
+
+    /** @param s the scale the matrix will apply
+    @return a scale matrix */
+    inline static Matrix4 scale(const vec::Vector3& s) {
+
+        Matrix4 result;
+        result.m[0]  = s.x;
+        result.m[5]  = s.y;
+        result.m[10] = s.z;
+
+        return result;
+    }
+
+    /** Builds a matrix that applies scale, then rotation around the z, y, and
+    x axes, then translation. This matches the order of OpenGL calls
+    glTranslate, glRotate(x), glRotate(y), glRotate(z), glScale.
+    @param t the translation
+    @param r the rotation in degrees around each axis
+    @param s the scale
+    @return the composed transformation matrix */
+    inline static Matrix4 compose(
+            const vec::Vector3& t,
+            const vec::Vector3& r,
+            const vec::Vector3& s) {
+
+        Matrix4 result(translation(t));
+        // skip the rotations that have no effect since most things in the
+        // engine only ever rotate around the z axis
+        if (r.x != 0.0f) {
+
+            result *= rotationX(r.x);
+        }
+        if (r.y != 0.0f) {
+
+            result *= rotationY(r.y);
+        }
+        if (r.z != 0.0f) {
+
+            result *= rotationZ(r.z);
+        }
+        result *= scale(s);
+
+        return result;
+    }
+
+    /** Builds a perspective projection matrix, the same as gluPerspective
+    @param fov the vertical field of view in degrees
+    @param aspect the width of the view divided by the height
+    @param nearPlane the distance to the near clipping plane
+    @param farPlane the distance to the far clipping plane
+    @return the projection matrix */
+    inline static Matrix4 perspective(
+            float fov,
+            float aspect,
+            float nearPlane,
+            float farPlane) {
+
+        float f = 1.0f / tan(fov * math::DEGREES_TO_RADIANS / 2.0f);
+
+        Matrix4 result;
+        result.m[0]  = f / aspect;
+        result.m[5]  = f;
+        result.m[10] = (farPlane + nearPlane) / (nearPlane - farPlane);
+        result.m[11] = -1.0f;
+        result.m[14] = (2.0f * farPlane * nearPlane) / (nearPlane - farPlane);
+        result.m[15] = 0.0f;
+
+        return result;
+    }
+
+    /** Builds an orthographic projection matrix, the same as glOrtho
+    @param left the left edge of the view
+    @param right the right edge of the view
+    @param bottom the bottom edge of the view
+    @param top the top edge of the view
+    @param nearPlane the distance to the near clipping plane
+    @param farPlane the distance to the far clipping plane
+    @return the projection matrix */
+    inline static Matrix4 orthographic(
+            float left,
+            float right,
+            float bottom,
+            float top,
+            float nearPlane,
+            float farPlane) {
+
+        Matrix4 result;
+        result.m[0]  =  2.0f / (right - left);
+        result.m[5]  =  2.0f / (top - bottom);
+        result.m[10] = -2.0f / (farPlane - nearPlane);
+        result.m[12] = -(right + left) / (right - left);
+        result.m[13] = -(top + bottom) / (top - bottom);
+        result.m[14] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+
+        return result;
+    }
+
+    //----------------------------MUTATOR FUNCTIONS-----------------------------
+
+    /** Sets this matrix to the identity matrix */
+    inline void setIdentity() {
+
+        for (unsigned i = 0; i < 16; ++i) {
+
+            m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        }
+    }
+
+    //-----------------------------ACCESS FUNCTIONS-----------------------------
+
+    /** @return the translation component of this matrix */
+    inline vec::Vector3 getTranslation() const {
+
+        return vec::Vector3(m[12], m[13], m[14]);
+    }
+
+    /** Transforms the given point by this matrix
+    @param p the point to transform
+    @return the transformed point */
+    inline vec::Vector3 transformPoint(const vec::Vector3& p) const {
+
+        return vec::Vector3(
+            (m[0] * p.x) + (m[4] * p.y) + (m[8]  * p.z) + m[12],
+            (m[1] * p.x) + (m[5] * p.y) + (m[9]  * p.z) + m[13],
+            (m[2] * p.x) + (m[6] * p.y) + (m[10] * p.z) + m[14]);
+    }
+
+    /** @return a pointer to the column-major values of this matrix */
+    inline const float* data() const {
+
+        return m;
+    }
+
+    /** Computes the matrix used to transform normals, which is the inverse
+    transpose of the upper 3x3 of this matrix, the same as gl_NormalMatrix
+    @param out the 9 column-major values of the normal matrix */
+    inline void getNormalMatrix(float* out) const {
+
+        // the upper 3x3 by row and column
+        float a00 = m[0], a01 = m[4], a02 = m[8];
+        float a10 = m[1], a11 = m[5], a12 = m[9];
+        float a20 = m[2], a21 = m[6], a22 = m[10];
+
+        // the cofactors, which are the inverse transpose once divided by the
+        // determinant
+        float c00 = (a11 * a22) - (a12 * a21);
+        float c01 = (a12 * a20) - (a10 * a22);
+        float c02 = (a10 * a21) - (a11 * a20);
+        float c10 = (a02 * a21) - (a01 * a22);
+        float c11 = (a00 * a22) - (a02 * a20);
+        float c12 = (a01 * a20) - (a00 * a21);
+        float c20 = (a01 * a12) - (a02 * a11);
+        float c21 = (a02 * a10) - (a00 * a12);
+        float c22 = (a00 * a11) - (a01 * a10);
+
+        float det = (a00 * c00) + (a01 * c01) + (a02 * c02);
+        float inv = det != 0.0f ? 1.0f / det : 0.0f;
+
+        out[0] = c00 * inv;
+        out[1] = c10 * inv;
+        out[2] = c20 * inv;
+        out[3] = c01 * inv;
+        out[4] = c11 * inv;
+        out[5] = c21 * inv;
+        out[6] = c02 * inv;
+        out[7] = c12 * inv;
+        out[8] = c22 * inv;
+    }
+
+    //---------------------------FORMATING FUNCTIONS----------------------------
+
+    /** @return the matrix in string format */
+    inline std::string toString() const {
+
+        std::stringstream ss;
+        for (unsigned row = 0; row < 4; ++row) {
+
+            ss << "[";
+            for (unsigned col = 0; col < 4; ++col) {
+
+                ss << m[col * 4 + row];
+                if (col < 3) {
+
+                    ss << ", ";
+                }
+            }
+            ss << "]";
+            if (row < 3) {
+
+                ss << "\n";
+            }
+        }
+
+        return ss.str();
+    }
+};
+
+} // namespace mat
+
+} // namespace util
+
+#endif
@@ -93,6 +93,22 @@ inline std::vector<std::string>& split(
     return elements; 
 }
 
+/** Hashes a string using 64 bit FNV-1a. This is stable between runs and
+platforms so it can be used to name files.
+@param str the string to hash
+@return the hash of the string */
+inline unsigned long long hash(const std::string& str) {
+
+    unsigned long long h = 14695981039346656037ULL;
+    for (unsigned i = 0; i < str.size(); ++i) {
+
+        h ^= static_cast<unsigned char>(str[i]);
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
 /** Generates a string containing a string repeated a given amount of times
 @param str the string to repeat
 @param n the number of times to repeat the character
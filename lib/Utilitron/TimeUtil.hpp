@@ -3,8 +3,10 @@
 
 #include <boost/date_time/date.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <chrono>
+#include <cmath>
 
-#include "lib/Utilitron/TypeUtil.hpp"
+#include "TypeUtil.hpp"
 
 namespace util {
 
@@ -19,6 +21,10 @@ namespace time {
 
 //! the number of milliseconds in a second
 static const float MS_IN_SEC = 1000.0f;
+//! the number of nanoseconds in a millisecond
+static const util::int64 NS_IN_MS = 1000000;
+//! the number of nanoseconds in a second
+static const util::int64 NS_IN_SEC = 1000000000;
 
 //------------------------------------------------------------------------------
 //                                   FUNCTIONS
@@ -30,7 +36,9 @@ inline boost::posix_time::ptime getEpoch() {
     return boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
 }
 
-/** @return time passed in milliseconds since epoch */
+/** #NOTE: this is wall clock time which jumps when the system clock is
+changed, use getMonotonicTime to measure durations
+@return time passed in milliseconds since epoch */
 inline util::int64 getCurrentTime() {
 
     // epoch
@@ -46,6 +54,33 @@ inline util::int64 getCurrentTime() {
     return diff.total_milliseconds();
 }
 
+/** @return a time in nanoseconds from a clock that never goes backwards and is
+unaffected by changes to the system clock. The clock has no fixed epoch so
+the time is only useful for measuring durations. */
+inline util::int64 getMonotonicTime() {
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** @return the given number of nanoseconds in milliseconds
+@param ns the number of nanoseconds */
+inline float nsToMs(util::int64 ns) {
+
+    return static_cast<float>(
+        static_cast<double>(ns) / static_cast<double>(NS_IN_MS));
+}
+
+/** @return the given number of milliseconds in nanoseconds, rounded to the
+nearest nanosecond
+@param ms the number of milliseconds */
+inline util::int64 msToNs(float ms) {
+
+    return static_cast<util::int64>(
+        std::floor(static_cast<double>(ms) * static_cast<double>(NS_IN_MS) +
+        0.5));
+}
+
 } // namespace time
 
 } // namespace util
@@ -1827,6 +1827,45 @@ inline float distance(const Vector4& a, const Vector4& b) {
         pow(a.z - b.z, 2.0f) + pow(a.w - b.w, 2.0f));
 }
 
+/** Calculates the squared distance between the two vectors, which is cheaper
+than distance when only comparing distances
+@param a the first vector
+@param b the second vector
+@return the squared distance between the vectors */
+inline float distanceSquared(const Vector2& a, const Vector2& b) {
+
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return (dx * dx) + (dy * dy);
+}
+
+/** Calculates the squared distance between the two vectors, which is cheaper
+than distance when only comparing distances
+@param a the first vector
+@param b the second vector
+@return the squared distance between the vectors */
+inline float distanceSquared(const Vector3& a, const Vector3& b) {
+
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    float dz = a.z - b.z;
+    return (dx * dx) + (dy * dy) + (dz * dz);
+}
+
+/** Calculates the squared distance between the two vectors, which is cheaper
+than distance when only comparing distances
+@param a the first vector
+@param b the second vector
+@return the squared distance between the vectors */
+inline float distanceSquared(const Vector4& a, const Vector4& b) {
+
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    float dz = a.z - b.z;
+    float dw = a.w - b.w;
+    return (dx * dx) + (dy * dy) + (dz * dz) + (dw * dw);
+}
+
 /** @return the angle between the two vectors
 @param a the first vector
 @param b the second vector
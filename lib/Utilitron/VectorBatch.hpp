@@ -0,0 +1,690 @@
+#ifndef UTILITRON_VECTORBATCH_H_
+#   define UTILITRON_VECTORBATCH_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include "MacroUtil.hpp"
+#include "Vector.hpp"
+
+// SSE2 is the baseline on x86-64, AVX is only used when the compiler is told
+// the target supports it (-mavx)
+#if defined __SSE2__ || defined _M_X64 || \
+    (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define UTILITRON_SSE2
+#   include <emmintrin.h>
+#endif
+#if defined UTILITRON_SSE2 && defined __AVX__
+#   define UTILITRON_AVX
+#   include <immintrin.h>
+#endif
+
+namespace util {
+
+namespace vec {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+//! the byte alignment of packed float storage, wide enough for AVX
+static const unsigned PACKED_ALIGNMENT = 32;
+//! the widest number of floats operated on at once
+static const unsigned PACKED_LANES = 8;
+
+/*****************************************************************************\
+| Four floats packed into a single SIMD register where supported. Used for    |
+| vector math on 3d and 4d values without going through the component        |
+| references of Vector3 and Vector4.                                          |
+\*****************************************************************************/
+class Packed4 {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /** Creates a new packed value with all lanes as zero */
+    inline Packed4() {
+
+#ifdef UTILITRON_SSE2
+        m_v = _mm_setzero_ps();
+#else
+        m_v[0] = m_v[1] = m_v[2] = m_v[3] = 0.0f;
+#endif
+    }
+
+    /** Creates a new packed value with all lanes as the given value
+    @param s the value of every lane */
+    inline explicit Packed4(float s) {
+
+#ifdef UTILITRON_SSE2
+        m_v = _mm_set1_ps(s);
+#else
+        m_v[0] = m_v[1] = m_v[2] = m_v[3] = s;
+#endif
+    }
+
+    /** Creates a new packed value from the given lanes
+    @param x the first lane
+    @param y the second lane
+    @param z the third lane
+    @param w the fourth lane */
+    inline Packed4(float x, float y, float z, float w) {
+
+#ifdef UTILITRON_SSE2
+        m_v = _mm_setr_ps(x, y, z, w);
+#else
+        m_v[0] = x;
+        m_v[1] = y;
+        m_v[2] = z;
+        m_v[3] = w;
+#endif
+    }
+
+    /** Creates a new packed value from a 3d vector
+    @param v the vector to copy the first three lanes from
+    @param w the fourth lane */
+    inline explicit Packed4(const Vector3& v, float w = 0.0f) {
+
+        *this = Packed4(v.x, v.y, v.z, w);
+    }
+
+    /** Creates a new packed value from a 4d vector
+    @param v the vector to copy the lanes from */
+    inline explicit Packed4(const Vector4& v) {
+
+        *this = Packed4(v.x, v.y, v.z, v.w);
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /** @return the lane-wise sum of this and the other packed value */
+    inline Packed4 operator +(const Packed4& other) const {
+
+#ifdef UTILITRON_SSE2
+        return Packed4(_mm_add_ps(m_v, other.m_v));
+#else
+        return Packed4(m_v[0] + other.m_v[0], m_v[1] + other.m_v[1],
+                       m_v[2] + other.m_v[2], m_v[3] + other.m_v[3]);
+#endif
+    }
+
+    /** @return the lane-wise difference of this and the other packed value */
+    inline Packed4 operator -(const Packed4& other) const {
+
+#ifdef UTILITRON_SSE2
+        return Packed4(_mm_sub_ps(m_v, other.m_v));
+#else
+        return Packed4(m_v[0] - other.m_v[0], m_v[1] - other.m_v[1],
+                       m_v[2] - other.m_v[2], m_v[3] - other.m_v[3]);
+#endif
+    }
+
+    /** @return the lane-wise product of this and the other packed value */
+    inline Packed4 operator *(const Packed4& other) const {
+
+#ifdef UTILITRON_SSE2
+        return Packed4(_mm_mul_ps(m_v, other.m_v));
+#else
+        return Packed4(m_v[0] * other.m_v[0], m_v[1] * other.m_v[1],
+                       m_v[2] * other.m_v[2], m_v[3] * other.m_v[3]);
+#endif
+    }
+
+    /** @return every lane of this multiplied by the given scalar */
+    inline Packed4 operator *(float s) const {
+
+        return (*this) * Packed4(s);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Writes the lanes of this packed value to the given array
+    @param out the array of at least four floats to write to */
+    inline void store(float* out) const {
+
+#ifdef UTILITRON_SSE2
+        _mm_storeu_ps(out, m_v);
+#else
+        memcpy(out, m_v, 4 * sizeof(float));
+#endif
+    }
+
+    /** @return the lane at the given index */
+    inline float get(unsigned index) const {
+
+        float lanes[4];
+        store(lanes);
+        return lanes[index];
+    }
+
+    /** @return the sum of every lane */
+    inline float sum() const {
+
+        float lanes[4];
+        store(lanes);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    /** @return the first three lanes as a 3d vector */
+    inline Vector3 toVector3() const {
+
+        float lanes[4];
+        store(lanes);
+        return Vector3(lanes[0], lanes[1], lanes[2]);
+    }
+
+    /** @return the lanes as a 4d vector */
+    inline Vector4 toVector4() const {
+
+        float lanes[4];
+        store(lanes);
+        return Vector4(lanes[0], lanes[1], lanes[2], lanes[3]);
+    }
+
+    //--------------------------------------------------------------------------
+    //                              STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the packed value read from the given array
+    @param in the array of at least four floats to read from */
+    inline static Packed4 load(const float* in) {
+
+#ifdef UTILITRON_SSE2
+        return Packed4(_mm_loadu_ps(in));
+#else
+        return Packed4(in[0], in[1], in[2], in[3]);
+#endif
+    }
+
+    /** @return the lane-wise minimum of the two packed values */
+    inline static Packed4 min(const Packed4& a, const Packed4& b) {
+
+#ifdef UTILITRON_SSE2
+        return Packed4(_mm_min_ps(a.m_v, b.m_v));
+#else
+        return Packed4(
+            a.m_v[0] < b.m_v[0] ? a.m_v[0] : b.m_v[0],
+            a.m_v[1] < b.m_v[1] ? a.m_v[1] : b.m_v[1],
+            a.m_v[2] < b.m_v[2] ? a.m_v[2] : b.m_v[2],
+            a.m_v[3] < b.m_v[3] ? a.m_v[3] : b.m_v[3]);
+#endif
+    }
+
+    /** @return the lane-wise maximum of the two packed values */
+    inline static Packed4 max(const Packed4& a, const Packed4& b) {
+
+#ifdef UTILITRON_SSE2
+        return Packed4(_mm_max_ps(a.m_v, b.m_v));
+#else
+        return Packed4(
+            a.m_v[0] > b.m_v[0] ? a.m_v[0] : b.m_v[0],
+            a.m_v[1] > b.m_v[1] ? a.m_v[1] : b.m_v[1],
+            a.m_v[2] > b.m_v[2] ? a.m_v[2] : b.m_v[2],
+            a.m_v[3] > b.m_v[3] ? a.m_v[3] : b.m_v[3]);
+#endif
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+#ifdef UTILITRON_SSE2
+    // the packed lanes
+    __m128 m_v;
+
+    //--------------------------------------------------------------------------
+    //                            PRIVATE CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /** Creates a new packed value from a register */
+    inline explicit Packed4(__m128 v) :
+        m_v(v) {
+    }
+#else
+    // the packed lanes
+    float m_v[4];
+#endif
+};
+
+/*****************************************************************************\
+| A growable array of 3d points stored as separate aligned x, y and z arrays  |
+| so that batch operations can process several points per instruction.        |
+\*****************************************************************************/
+class Vector3Array {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(Vector3Array);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /** Creates a new empty array */
+    inline Vector3Array() :
+        m_x       (NULL),
+        m_y       (NULL),
+        m_z       (NULL),
+        m_size    (0),
+        m_capacity(0) {
+    }
+
+    /** Creates a new array of the given number of zero points
+    @param size the number of points in the array */
+    inline explicit Vector3Array(unsigned size) :
+        m_x       (NULL),
+        m_y       (NULL),
+        m_z       (NULL),
+        m_size    (0),
+        m_capacity(0) {
+
+        resize(size);
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    inline ~Vector3Array() {
+
+        release(m_x);
+        release(m_y);
+        release(m_z);
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the number of points in the array */
+    inline unsigned size() const {
+
+        return m_size;
+    }
+
+    /** @return if there are no points in the array */
+    inline bool empty() const {
+
+        return m_size == 0;
+    }
+
+    /** Removes every point from the array, keeping the storage */
+    inline void clear() {
+
+        m_size = 0;
+    }
+
+    /** Makes sure there is storage for at least the given number of points
+    @param capacity the number of points to have storage for */
+    inline void reserve(unsigned capacity) {
+
+        if (capacity <= m_capacity) {
+
+            return;
+        }
+
+        // round up to a whole number of the widest packed registers
+        capacity = (capacity + PACKED_LANES - 1) & ~(PACKED_LANES - 1);
+        m_x = grow(m_x, capacity);
+        m_y = grow(m_y, capacity);
+        m_z = grow(m_z, capacity);
+        m_capacity = capacity;
+    }
+
+    /** Sets the number of points in the array, new points are zero
+    @param size the new number of points */
+    inline void resize(unsigned size) {
+
+        reserve(size);
+        for (unsigned i = m_size; i < size; ++i) {
+
+            m_x[i] = m_y[i] = m_z[i] = 0.0f;
+        }
+        m_size = size;
+    }
+
+    /** Adds a point to the end of the array
+    @param v the point to add */
+    inline void add(const Vector3& v) {
+
+        if (m_size == m_capacity) {
+
+            reserve(m_capacity == 0 ? PACKED_LANES : m_capacity * 2);
+        }
+        set(m_size++, v);
+    }
+
+    /** @return the point at the given index */
+    inline Vector3 get(unsigned index) const {
+
+        return Vector3(m_x[index], m_y[index], m_z[index]);
+    }
+
+    /** Sets the point at the given index
+    @param index the index of the point
+    @param v the new value of the point */
+    inline void set(unsigned index, const Vector3& v) {
+
+        m_x[index] = v.x;
+        m_y[index] = v.y;
+        m_z[index] = v.z;
+    }
+
+    /** @return the aligned x components */
+    inline float* x() {
+
+        return m_x;
+    }
+
+    /** @return the aligned x components */
+    inline const float* x() const {
+
+        return m_x;
+    }
+
+    /** @return the aligned y components */
+    inline float* y() {
+
+        return m_y;
+    }
+
+    /** @return the aligned y components */
+    inline const float* y() const {
+
+        return m_y;
+    }
+
+    /** @return the aligned z components */
+    inline float* z() {
+
+        return m_z;
+    }
+
+    /** @return the aligned z components */
+    inline const float* z() const {
+
+        return m_z;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the x components
+    float* m_x;
+    // the y components
+    float* m_y;
+    // the z components
+    float* m_z;
+    // the number of points in the array
+    unsigned m_size;
+    // the number of points there is storage for
+    unsigned m_capacity;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return new aligned storage holding the current components of the
+    given storage, which is released
+    @param old the current storage
+    @param capacity the number of floats in the new storage */
+    inline float* grow(float* old, unsigned capacity) {
+
+#ifdef UTILITRON_SSE2
+        float* storage = static_cast<float*>(
+            _mm_malloc(capacity * sizeof(float), PACKED_ALIGNMENT));
+#else
+        float* storage = static_cast<float*>(
+            malloc(capacity * sizeof(float)));
+#endif
+        if (old != NULL) {
+
+            memcpy(storage, old, m_size * sizeof(float));
+            release(old);
+        }
+        return storage;
+    }
+
+    /** Frees storage allocated by grow
+    @param storage the storage to free */
+    inline static void release(float* storage) {
+
+#ifdef UTILITRON_SSE2
+        _mm_free(storage);
+#else
+        free(storage);
+#endif
+    }
+};
+
+//------------------------------------------------------------------------------
+//                             BATCH MATH FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Computes the squared distance from every point in the array to a single
+point
+@param points the points to measure from
+@param to the point to measure to
+@param out the array of at least points.size() floats to write the squared
+           distances to */
+inline void distanceSquared(
+        const Vector3Array& points,
+        const Vector3&      to,
+              float*        out) {
+
+    const float* px = points.x();
+    const float* py = points.y();
+    const float* pz = points.z();
+    unsigned n = points.size();
+    unsigned i = 0;
+
+#ifdef UTILITRON_AVX
+    __m256 tx8 = _mm256_set1_ps(to.x);
+    __m256 ty8 = _mm256_set1_ps(to.y);
+    __m256 tz8 = _mm256_set1_ps(to.z);
+    for (; i + 8 <= n; i += 8) {
+
+        __m256 dx = _mm256_sub_ps(_mm256_load_ps(px + i), tx8);
+        __m256 dy = _mm256_sub_ps(_mm256_load_ps(py + i), ty8);
+        __m256 dz = _mm256_sub_ps(_mm256_load_ps(pz + i), tz8);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+            _mm256_mul_ps(dz, dz)));
+    }
+#endif
+#ifdef UTILITRON_SSE2
+    __m128 tx4 = _mm_set1_ps(to.x);
+    __m128 ty4 = _mm_set1_ps(to.y);
+    __m128 tz4 = _mm_set1_ps(to.z);
+    for (; i + 4 <= n; i += 4) {
+
+        __m128 dx = _mm_sub_ps(_mm_load_ps(px + i), tx4);
+        __m128 dy = _mm_sub_ps(_mm_load_ps(py + i), ty4);
+        __m128 dz = _mm_sub_ps(_mm_load_ps(pz + i), tz4);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+    }
+#endif
+    for (; i < n; ++i) {
+
+        float dx = px[i] - to.x;
+        float dy = py[i] - to.y;
+        float dz = pz[i] - to.z;
+        out[i] = (dx * dx + dy * dy) + dz * dz;
+    }
+}
+
+/** Moves every point in the array by the given offset
+@param points the points to move
+@param offset the offset to add to every point */
+inline void translate(Vector3Array& points, const Vector3& offset) {
+
+    float* px = points.x();
+    float* py = points.y();
+    float* pz = points.z();
+    unsigned n = points.size();
+    unsigned i = 0;
+
+#ifdef UTILITRON_AVX
+    __m256 ox8 = _mm256_set1_ps(offset.x);
+    __m256 oy8 = _mm256_set1_ps(offset.y);
+    __m256 oz8 = _mm256_set1_ps(offset.z);
+    for (; i + 8 <= n; i += 8) {
+
+        _mm256_store_ps(px + i, _mm256_add_ps(_mm256_load_ps(px + i), ox8));
+        _mm256_store_ps(py + i, _mm256_add_ps(_mm256_load_ps(py + i), oy8));
+        _mm256_store_ps(pz + i, _mm256_add_ps(_mm256_load_ps(pz + i), oz8));
+    }
+#endif
+#ifdef UTILITRON_SSE2
+    __m128 ox4 = _mm_set1_ps(offset.x);
+    __m128 oy4 = _mm_set1_ps(offset.y);
+    __m128 oz4 = _mm_set1_ps(offset.z);
+    for (; i + 4 <= n; i += 4) {
+
+        _mm_store_ps(px + i, _mm_add_ps(_mm_load_ps(px + i), ox4));
+        _mm_store_ps(py + i, _mm_add_ps(_mm_load_ps(py + i), oy4));
+        _mm_store_ps(pz + i, _mm_add_ps(_mm_load_ps(pz + i), oz4));
+    }
+#endif
+    for (; i < n; ++i) {
+
+        px[i] += offset.x;
+        py[i] += offset.y;
+        pz[i] += offset.z;
+    }
+}
+
+/** Finds the component-wise minimum and maximum of the points in the array
+@param points the points to find the bounds of
+@param min is set to the smallest x, y and z of the points
+@param max is set to the largest x, y and z of the points
+@return false and leaves min and max unchanged if the array is empty */
+inline bool bounds(const Vector3Array& points, Vector3& min, Vector3& max) {
+
+    if (points.empty()) {
+
+        return false;
+    }
+
+    const float* px = points.x();
+    const float* py = points.y();
+    const float* pz = points.z();
+    unsigned n = points.size();
+    unsigned i = 0;
+    float minX = px[0], minY = py[0], minZ = pz[0];
+    float maxX = px[0], maxY = py[0], maxZ = pz[0];
+
+#ifdef UTILITRON_SSE2
+    // reduce whole registers then fold the lanes together
+    if (n >= 4) {
+
+        __m128 minX4 = _mm_load_ps(px), maxX4 = minX4;
+        __m128 minY4 = _mm_load_ps(py), maxY4 = minY4;
+        __m128 minZ4 = _mm_load_ps(pz), maxZ4 = minZ4;
+        i = 4;
+#ifdef UTILITRON_AVX
+        if (n >= 8) {
+
+            __m256 minX8 = _mm256_load_ps(px), maxX8 = minX8;
+            __m256 minY8 = _mm256_load_ps(py), maxY8 = minY8;
+            __m256 minZ8 = _mm256_load_ps(pz), maxZ8 = minZ8;
+            for (i = 8; i + 8 <= n; i += 8) {
+
+                __m256 x8 = _mm256_load_ps(px + i);
+                __m256 y8 = _mm256_load_ps(py + i);
+                __m256 z8 = _mm256_load_ps(pz + i);
+                minX8 = _mm256_min_ps(minX8, x8);
+                maxX8 = _mm256_max_ps(maxX8, x8);
+                minY8 = _mm256_min_ps(minY8, y8);
+                maxY8 = _mm256_max_ps(maxY8, y8);
+                minZ8 = _mm256_min_ps(minZ8, z8);
+                maxZ8 = _mm256_max_ps(maxZ8, z8);
+            }
+
+            // fold the upper half of each register onto the lower half
+            minX4 = _mm_min_ps(_mm256_castps256_ps128(minX8),
+                               _mm256_extractf128_ps(minX8, 1));
+            maxX4 = _mm_max_ps(_mm256_castps256_ps128(maxX8),
+                               _mm256_extractf128_ps(maxX8, 1));
+            minY4 = _mm_min_ps(_mm256_castps256_ps128(minY8),
+                               _mm256_extractf128_ps(minY8, 1));
+            maxY4 = _mm_max_ps(_mm256_castps256_ps128(maxY8),
+                               _mm256_extractf128_ps(maxY8, 1));
+            minZ4 = _mm_min_ps(_mm256_castps256_ps128(minZ8),
+                               _mm256_extractf128_ps(minZ8, 1));
+            maxZ4 = _mm_max_ps(_mm256_castps256_ps128(maxZ8),
+                               _mm256_extractf128_ps(maxZ8, 1));
+        }
+#endif
+        for (; i + 4 <= n; i += 4) {
+
+            __m128 x4 = _mm_load_ps(px + i);
+            __m128 y4 = _mm_load_ps(py + i);
+            __m128 z4 = _mm_load_ps(pz + i);
+            minX4 = _mm_min_ps(minX4, x4);
+            maxX4 = _mm_max_ps(maxX4, x4);
+            minY4 = _mm_min_ps(minY4, y4);
+            maxY4 = _mm_max_ps(maxY4, y4);
+            minZ4 = _mm_min_ps(minZ4, z4);
+            maxZ4 = _mm_max_ps(maxZ4, z4);
+        }
+
+        float lanes[6][4];
+        _mm_storeu_ps(lanes[0], minX4);
+        _mm_storeu_ps(lanes[1], minY4);
+        _mm_storeu_ps(lanes[2], minZ4);
+        _mm_storeu_ps(lanes[3], maxX4);
+        _mm_storeu_ps(lanes[4], maxY4);
+        _mm_storeu_ps(lanes[5], maxZ4);
+        for (unsigned l = 0; l < 4; ++l) {
+
+            minX = lanes[0][l] < minX ? lanes[0][l] : minX;
+            minY = lanes[1][l] < minY ? lanes[1][l] : minY;
+            minZ = lanes[2][l] < minZ ? lanes[2][l] : minZ;
+            maxX = lanes[3][l] > maxX ? lanes[3][l] : maxX;
+            maxY = lanes[4][l] > maxY ? lanes[4][l] : maxY;
+            maxZ = lanes[5][l] > maxZ ? lanes[5][l] : maxZ;
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+
+        minX = px[i] < minX ? px[i] : minX;
+        minY = py[i] < minY ? py[i] : minY;
+        minZ = pz[i] < minZ ? pz[i] : minZ;
+        maxX = px[i] > maxX ? px[i] : maxX;
+        maxY = py[i] > maxY ? py[i] : maxY;
+        maxZ = pz[i] > maxZ ? pz[i] : maxZ;
+    }
+
+    min.x = minX;
+    min.y = minY;
+    min.z = minZ;
+    max.x = maxX;
+    max.y = maxY;
+    max.z = maxZ;
+    return true;
+}
+
+} // namespace vec
+
+} // namespace util
+
+#endif
@@ -1,14 +1,20 @@
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <stdlib.h>
 #include <time.h>
+#include <vector>
 
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
 
+#include "../ImageUtil.hpp"
 #include "../MacroUtil.hpp"
 #include "../MathUtil.hpp"
+#include "../Matrix.hpp"
 #include "../StringUtil.hpp"
+#include "../TimeUtil.hpp"
+#include "../VectorBatch.hpp"
 
 //the amount of times we test each case
 #define TEST_CYCLES 10
@@ -51,9 +57,365 @@ BOOST_AUTO_TEST_CASE(math_util_tests) {
     });
 }
 
+BOOST_AUTO_TEST_CASE(matrix_tests) {
+
+    printTitle("Testing Matrices");
+
+    //IDENTITY
+    //transforming by the identity does nothing
+    test([] () {
+
+        util::vec::Vector3 p(generateFloat(), generateFloat(), generateFloat());
+        util::vec::Vector3 r(util::mat::Matrix4().transformPoint(p));
+
+        BOOST_CHECK_EQUAL(r.x, p.x);
+        BOOST_CHECK_EQUAL(r.y, p.y);
+        BOOST_CHECK_EQUAL(r.z, p.z);
+    });
+
+    //COMPOSITION
+    //a child offset is rotated and translated by its parent
+    util::mat::Matrix4 parent(util::mat::Matrix4::compose(
+        util::vec::Vector3(2.0f, 3.0f, 0.0f),
+        util::vec::Vector3(0.0f, 0.0f, 180.0f),
+        util::vec::Vector3(1.0f, 1.0f, 1.0f)
+    ));
+    util::mat::Matrix4 child(util::mat::Matrix4::translation(
+        util::vec::Vector3(0.0f, 1.0f, 0.0f)));
+    util::vec::Vector3 world((parent * child).getTranslation());
+
+    BOOST_CHECK_CLOSE(world.x, 2.0f, 0.001f);
+    BOOST_CHECK_CLOSE(world.y, 2.0f, 0.001f);
+    BOOST_CHECK_SMALL(world.z, 0.001f);
+
+    //scale is applied before translation
+    util::mat::Matrix4 scaled(util::mat::Matrix4::compose(
+        util::vec::Vector3(1.0f, 0.0f, 0.0f),
+        util::vec::Vector3(),
+        util::vec::Vector3(2.0f, 2.0f, 2.0f)
+    ));
+    util::vec::Vector3 p(scaled.transformPoint(
+        util::vec::Vector3(1.0f, 1.0f, 1.0f)));
+
+    BOOST_CHECK_CLOSE(p.x, 3.0f, 0.001f);
+    BOOST_CHECK_CLOSE(p.y, 2.0f, 0.001f);
+    BOOST_CHECK_CLOSE(p.z, 2.0f, 0.001f);
+
+    //PROJECTION
+    //perspective maps the near and far planes to -1 and 1
+    util::mat::Matrix4 perspective(
+        util::mat::Matrix4::perspective(90.0f, 2.0f, 1.0f, 10.0f));
+    for (unsigned i = 0; i < 2; ++i) {
+
+        float depth = i == 0 ? 1.0f : 10.0f;
+        const float* m = perspective.data();
+        float clipZ = (m[10] * -depth) + m[14];
+        float clipW = (m[11] * -depth) + m[15];
+        BOOST_CHECK_CLOSE(clipZ / clipW, i == 0 ? -1.0f : 1.0f, 0.001f);
+    }
+    //a 90 degree field of view puts the top edge at 1
+    BOOST_CHECK_CLOSE(perspective.data()[5], 1.0f, 0.001f);
+    BOOST_CHECK_CLOSE(perspective.data()[0], 0.5f, 0.001f);
+
+    //orthographic maps the view box to the unit cube
+    util::mat::Matrix4 ortho(util::mat::Matrix4::orthographic(
+        -2.0f, 2.0f, -1.0f, 1.0f, 0.0f, 10.0f));
+    util::vec::Vector3 corner(
+        ortho.transformPoint(util::vec::Vector3(2.0f, -1.0f, -10.0f)));
+    BOOST_CHECK_CLOSE(corner.x,  1.0f, 0.001f);
+    BOOST_CHECK_CLOSE(corner.y, -1.0f, 0.001f);
+    BOOST_CHECK_CLOSE(corner.z,  1.0f, 0.001f);
+
+    //NORMAL MATRIX
+    //is the inverse transpose of the rotation and scale
+    test([] () {
+
+        util::mat::Matrix4 m(util::mat::Matrix4::compose(
+            util::vec::Vector3(generateFloat(), generateFloat(), 0.0f),
+            util::vec::Vector3(generateFloat(), generateFloat(),
+                generateFloat()),
+            util::vec::Vector3(2.0f, 0.5f, 3.0f)));
+        float n[9];
+        m.getNormalMatrix(n);
+        for (unsigned row = 0; row < 3; ++row) {
+
+            for (unsigned col = 0; col < 3; ++col) {
+
+                float sum = 0.0f;
+                for (unsigned k = 0; k < 3; ++k) {
+
+                    sum += n[row * 3 + k] * m.m[col * 4 + k];
+                }
+                BOOST_CHECK_SMALL(sum - (row == col ? 1.0f : 0.0f), 0.001f);
+            }
+        }
+    });
+}
+
+BOOST_AUTO_TEST_CASE(vector_batch_tests) {
+
+    printTitle("Testing Vector Batches");
+
+    //PACKED
+    //lane-wise operations match the scalar vector operations
+    test([] () {
+
+        util::vec::Vector3 a(generateFloat(), generateFloat(), generateFloat());
+        util::vec::Vector3 b(generateFloat(), generateFloat(), generateFloat());
+        util::vec::Packed4 d(util::vec::Packed4(a) - util::vec::Packed4(b));
+
+        BOOST_CHECK_CLOSE((d * d).sum(),
+            util::vec::distanceSquared(a, b), 0.001f);
+
+        util::vec::Vector3 lo(util::vec::Packed4::min(
+            util::vec::Packed4(a), util::vec::Packed4(b)).toVector3());
+        BOOST_CHECK_EQUAL(lo.x, std::min(a.x, b.x));
+        BOOST_CHECK_EQUAL(lo.y, std::min(a.y, b.y));
+        BOOST_CHECK_EQUAL(lo.z, std::min(a.z, b.z));
+    });
+
+    //ARRAYS
+    //sizes that are not a multiple of the packed width use the scalar tail
+    static const unsigned SIZES[] = { 0, 1, 3, 4, 7, 8, 9, 37 };
+    for (unsigned s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+
+        unsigned n = SIZES[s];
+        util::vec::Vector3Array points;
+        std::vector<util::vec::Vector3> reference;
+        for (unsigned i = 0; i < n; ++i) {
+
+            reference.push_back(util::vec::Vector3(
+                generateFloat(), generateFloat(), generateFloat()));
+            points.add(reference.back());
+        }
+        BOOST_CHECK_EQUAL(points.size(), n);
+
+        //distance squared matches the scalar function
+        util::vec::Vector3 to(generateFloat(), generateFloat(), generateFloat());
+        std::vector<float> out(n + 1, -1.0f);
+        util::vec::distanceSquared(points, to, &out[0]);
+        for (unsigned i = 0; i < n; ++i) {
+
+            BOOST_CHECK_CLOSE(out[i],
+                util::vec::distanceSquared(reference[i], to), 0.001f);
+        }
+        //nothing is written past the end
+        BOOST_CHECK_EQUAL(out[n], -1.0f);
+
+        //translating moves every point
+        util::vec::Vector3 offset(
+            generateFloat(), generateFloat(), generateFloat());
+        util::vec::translate(points, offset);
+        for (unsigned i = 0; i < n; ++i) {
+
+            util::vec::Vector3 moved(reference[i] + offset);
+            BOOST_CHECK_EQUAL(points.get(i).x, moved.x);
+            BOOST_CHECK_EQUAL(points.get(i).y, moved.y);
+            BOOST_CHECK_EQUAL(points.get(i).z, moved.z);
+            reference[i] = moved;
+        }
+
+        //bounds match a scalar search
+        util::vec::Vector3 min;
+        util::vec::Vector3 max;
+        BOOST_CHECK_EQUAL(util::vec::bounds(points, min, max), n > 0);
+        for (unsigned i = 0; i < n; ++i) {
+
+            BOOST_CHECK(min.x <= reference[i].x && reference[i].x <= max.x);
+            BOOST_CHECK(min.y <= reference[i].y && reference[i].y <= max.y);
+            BOOST_CHECK(min.z <= reference[i].z && reference[i].z <= max.z);
+        }
+        if (n > 0) {
+
+            bool foundX = false;
+            bool foundY = false;
+            bool foundZ = false;
+            for (unsigned i = 0; i < n; ++i) {
+
+                foundX = foundX || reference[i].x == min.x;
+                foundY = foundY || reference[i].y == max.y;
+                foundZ = foundZ || reference[i].z == min.z;
+            }
+            BOOST_CHECK(foundX && foundY && foundZ);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(image_util_tests) {
+
+    printTitle("Testing Image Utilities");
+
+    //SIZES
+    //partial blocks still take a whole block
+    BOOST_CHECK_EQUAL(util::img::compressedSize(4, 4, 8), 8);
+    BOOST_CHECK_EQUAL(util::img::compressedSize(5, 3, 8), 16);
+    BOOST_CHECK_EQUAL(util::img::compressedSize(1, 1, 16), 16);
+
+    //HALVING
+    //each pixel is the average of a 2x2 square
+    unsigned char square[] = {
+        0,   0,   0,   255,  100, 0,   0,   255,
+        0,   200, 0,   255,  0,   0,   40,  255
+    };
+    std::vector<unsigned char> half;
+    util::img::halve(square, 2, 2, half);
+    BOOST_CHECK_EQUAL(half.size(), 4);
+    BOOST_CHECK_EQUAL(half[0], 25);
+    BOOST_CHECK_EQUAL(half[1], 50);
+    BOOST_CHECK_EQUAL(half[2], 10);
+    BOOST_CHECK_EQUAL(half[3], 255);
+    //a single pixel stays the same
+    util::img::halve(square, 1, 1, half);
+    BOOST_CHECK_EQUAL(half.size(), 4);
+    BOOST_CHECK_EQUAL(half[1], 0);
+    //the vectorised rows match a plain 2x2 average for any size
+    static const unsigned HALVE_SIZES[][2] = {
+        { 1, 7 }, { 2, 2 }, { 3, 5 }, { 8, 8 }, { 13, 6 }, { 64, 33 }
+    };
+    for (unsigned s = 0; s < sizeof(HALVE_SIZES) / sizeof(HALVE_SIZES[0]);
+         ++s) {
+
+        unsigned w = HALVE_SIZES[s][0];
+        unsigned h = HALVE_SIZES[s][1];
+        std::vector<unsigned char> image(w * h * 4);
+        for (unsigned i = 0; i < image.size(); ++i) {
+
+            image[i] = static_cast<unsigned char>(rand() % 256);
+        }
+        util::img::halve(&image[0], w, h, half);
+        unsigned hw = std::max(w / 2, 1U);
+        unsigned hh = std::max(h / 2, 1U);
+        BOOST_CHECK_EQUAL(half.size(), hw * hh * 4);
+        bool matches = true;
+        for (unsigned y = 0; y < hh; ++y) {
+
+            for (unsigned x = 0; x < hw; ++x) {
+
+                unsigned x0 = std::min(x * 2, w - 1);
+                unsigned x1 = std::min(x * 2 + 1, w - 1);
+                unsigned y0 = std::min(y * 2, h - 1);
+                unsigned y1 = std::min(y * 2 + 1, h - 1);
+                for (unsigned c = 0; c < 4; ++c) {
+
+                    unsigned sum = image[(y0 * w + x0) * 4 + c] +
+                                   image[(y0 * w + x1) * 4 + c] +
+                                   image[(y1 * w + x0) * 4 + c] +
+                                   image[(y1 * w + x1) * 4 + c];
+                    matches = matches &&
+                        half[(y * hw + x) * 4 + c] == (sum + 2) / 4;
+                }
+            }
+        }
+        BOOST_CHECK(matches);
+    }
+
+    //PREMULTIPLIED ALPHA
+    //transparent pixels don't darken their neighbours once halved
+    unsigned char edge[] = {
+        255, 255, 255, 255,  0, 0, 0, 0,
+        255, 255, 255, 255,  0, 0, 0, 0
+    };
+    util::img::premultiply(edge, 4);
+    util::img::halve(edge, 2, 2, half);
+    util::img::unpremultiply(&half[0], 1);
+    BOOST_CHECK_EQUAL(half[0], 255);
+    BOOST_CHECK_EQUAL(half[3], 128);
+    //opaque pixels are unchanged
+    unsigned char opaque[] = { 10, 20, 30, 255 };
+    util::img::premultiply(opaque, 1);
+    util::img::unpremultiply(opaque, 1);
+    BOOST_CHECK_EQUAL(opaque[0], 10);
+    BOOST_CHECK_EQUAL(opaque[2], 30);
+
+    //COMPRESSION
+    //colours that fit in 5:6:5 bits survive exactly
+    std::vector<unsigned char> solid(8 * 8 * 4);
+    for (unsigned i = 0; i < 8 * 8; ++i) {
+
+        solid[i * 4 + 0] = 255;
+        solid[i * 4 + 1] = 0;
+        solid[i * 4 + 2] = 255;
+        solid[i * 4 + 3] = 255;
+    }
+    std::vector<unsigned char> blocks;
+    std::vector<unsigned char> decoded;
+    util::img::compressBC1(&solid[0], 8, 8, blocks);
+    BOOST_CHECK_EQUAL(blocks.size(), 32);
+    util::img::decompressBC1(&blocks[0], 8, 8, decoded);
+    BOOST_CHECK(decoded == solid);
+    BOOST_CHECK(util::img::isOpaque(&decoded[0], 8 * 8));
+
+    //smooth gradients of odd sizes stay close to the original
+    static const unsigned WIDTH = 37;
+    static const unsigned HEIGHT = 21;
+    std::vector<unsigned char> gradient(WIDTH * HEIGHT * 4);
+    for (unsigned y = 0; y < HEIGHT; ++y) {
+
+        for (unsigned x = 0; x < WIDTH; ++x) {
+
+            unsigned char* pixel = &gradient[(y * WIDTH + x) * 4];
+            pixel[0] = static_cast<unsigned char>(x * 255 / WIDTH);
+            pixel[1] = static_cast<unsigned char>(y * 255 / HEIGHT);
+            pixel[2] = 128;
+            pixel[3] = static_cast<unsigned char>((x + y) * 255 /
+                (WIDTH + HEIGHT));
+        }
+    }
+    BOOST_CHECK(!util::img::isOpaque(&gradient[0], WIDTH * HEIGHT));
+
+    util::img::compressBC1(&gradient[0], WIDTH, HEIGHT, blocks);
+    BOOST_CHECK_EQUAL(blocks.size(),
+        util::img::compressedSize(WIDTH, HEIGHT, util::img::BC1_BLOCK_BYTES));
+    util::img::decompressBC1(&blocks[0], WIDTH, HEIGHT, decoded);
+    BOOST_CHECK_EQUAL(decoded.size(), gradient.size());
+    BOOST_CHECK(util::img::rootMeanSquareError(
+        &gradient[0], &decoded[0], WIDTH * HEIGHT, false) < 8.0f);
+
+    util::img::compressBC3(&gradient[0], WIDTH, HEIGHT, blocks);
+    BOOST_CHECK_EQUAL(blocks.size(),
+        util::img::compressedSize(WIDTH, HEIGHT, util::img::BC3_BLOCK_BYTES));
+    util::img::decompressBC3(&blocks[0], WIDTH, HEIGHT, decoded);
+    BOOST_CHECK(util::img::rootMeanSquareError(
+        &gradient[0], &decoded[0], WIDTH * HEIGHT, true) < 8.0f);
+}
+
 BOOST_AUTO_TEST_CASE(string_util_tests) {
 
     printTitle("Testing String Utilities");
+
+    //HASHING
+    //matches the published FNV-1a values
+    BOOST_CHECK_EQUAL(util::str::hash(""), 14695981039346656037ULL);
+    BOOST_CHECK_EQUAL(util::str::hash("a"), 0xAF63DC4C8601EC8CULL);
+    BOOST_CHECK(util::str::hash("ab") != util::str::hash("ba"));
+}
+
+BOOST_AUTO_TEST_CASE(time_util_tests) {
+
+    printTitle("Testing Time Utilities");
+
+    //MONOTONIC TIME
+    //never goes backwards
+    util::int64 last = util::time::getMonotonicTime();
+    for (unsigned i = 0; i < 10000; ++i) {
+
+        util::int64 now = util::time::getMonotonicTime();
+        BOOST_CHECK(now >= last);
+        last = now;
+    }
+
+    //CONVERSION
+    //sub-millisecond precision is kept
+    BOOST_CHECK_CLOSE(util::time::nsToMs(16666667), 16.666667f, 0.001f);
+    BOOST_CHECK_EQUAL(util::time::msToNs(0.5f), 500000);
+    //converting there and back keeps sub-microsecond precision for frame
+    //length durations
+    test([] () {
+
+        util::int64 ns = (rand() % 100000) * 1000;
+        util::int64 error = util::time::msToNs(util::time::nsToMs(ns)) - ns;
+        BOOST_CHECK(error > -100 && error < 100);
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -4,6 +4,11 @@
 //                                   VARIABLES
 //------------------------------------------------------------------------------
 
+// the model view, projection, and normal matrices
+uniform mat4 u_modelViewMatrix;
+uniform mat4 u_projectionMatrix;
+uniform mat3 u_normalMatrix;
+
 // the position of the engine trails
 uniform vec3 u_trailPositions[9];
 uniform float u_trailFade;
@@ -40,12 +45,12 @@ void main() {
     trailPos.y += u_trailPositions[trailIndex].y;
 
     //set the vertex coord
-    v_vertex = vec3(gl_ModelViewMatrix * trailPos);
+    v_vertex = vec3(u_modelViewMatrix * trailPos);
     //set the normal
-    v_normal = normalize(gl_NormalMatrix * gl_Normal);
+    v_normal = normalize(u_normalMatrix * gl_Normal);
     //set the texture coords
     v_texCoord = vec2(gl_MultiTexCoord0);
 
     //set the position
-    gl_Position = gl_ModelViewProjectionMatrix * trailPos;
+    gl_Position = u_projectionMatrix * u_modelViewMatrix * trailPos;
 }
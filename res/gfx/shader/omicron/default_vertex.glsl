@@ -4,6 +4,11 @@
 //                                   VARIABLES
 //------------------------------------------------------------------------------
 
+// the model view, projection, and normal matrices
+uniform mat4 u_modelViewMatrix;
+uniform mat4 u_projectionMatrix;
+uniform mat3 u_normalMatrix;
+
 // the vertex coords 
 varying vec3 v_vertex;
 // the texture coords
@@ -18,12 +23,12 @@ varying vec3 v_normal;
 void main() {
     
     //set the vertex coord
-    v_vertex = vec3(gl_ModelViewMatrix * gl_Vertex);
+    v_vertex = vec3(u_modelViewMatrix * gl_Vertex);
     //set the normal
-    v_normal = normalize(gl_NormalMatrix * gl_Normal);
+    v_normal = normalize(u_normalMatrix * gl_Normal);
     //set the texture coords
     v_texCoord = vec2(gl_MultiTexCoord0);
 
     //set the position
-    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    gl_Position = u_projectionMatrix * u_modelViewMatrix * gl_Vertex;
 }
@@ -29,6 +29,8 @@ EnemyShip::EnemyShip(const util::vec::Vector3 pos, float diff) :
 //------------------------------------------------------------------------------
 
 EnemyShip::~EnemyShip() {
+
+    omi::CollisionDetect::removeHandler(m_bulletHandler);
 }
 
 //------------------------------------------------------------------------------
@@ -40,14 +42,13 @@ void EnemyShip::init() {
     m_components.add(m_shipT);
 
     buildShip();
+    addCollisionHandler();
 }
 
 void EnemyShip::update() {
 
     movement();
 
-    collisions();
-
     if (m_health <= 0.0f) {
 
         destroy();
@@ -100,36 +101,26 @@ void EnemyShip::movement() {
             m_right = true;
         }
     }
-
-    // pass the position to the hub
-    for(std::vector<Block*>::iterator it = m_blocks.begin();
-        it != m_blocks.end(); ++it) {
-        (*it)->traversed = false;
-    }
-    m_hub->setPosition(m_shipT->translation);
 }
 
-void EnemyShip::collisions() {
-
-    // check over the collisions of the blocks contained withing this
-    for (std::vector<Block*>::iterator it = m_blocks.begin();
-         it != m_blocks.end(); ++it) {
+void EnemyShip::addCollisionHandler() {
 
-        // get collision data from each block
-        for (std::vector<omi::CollisionData>::iterator data =
-            (*it)->m_collisionDetect->getCollisionData().begin();
-            data != (*it)->m_collisionDetect->getCollisionData().end();
-            ++data) {
+    // take damage when bullets hit any of the blocks of this ship
+    m_bulletHandler = omi::CollisionDetect::addHandler(
+        "enemy_block", "player_bullet", omi::collision::BEGIN,
+        [this] (const omi::CollisionEvent& event) {
 
-            if (!data->group.compare("player_bullet")) {
+        Block* block = static_cast<Block*>(event.ownerA);
+        if (find(m_blocks.begin(), m_blocks.end(), block) == m_blocks.end()) {
 
-                // cast the entity to a bullet
-                Bullet* bullet = static_cast<Bullet*>(data->entity);
-                bullet->destroy();
-                m_health -= bullet->getDamage();
-            }
+            return;
         }
-    }
+
+        // cast the entity to a bullet
+        Bullet* bullet = static_cast<Bullet*>(event.ownerB);
+        bullet->destroy();
+        m_health -= bullet->getDamage();
+    });
 }
 
 void EnemyShip::destroy() {
@@ -138,6 +129,7 @@ void EnemyShip::destroy() {
     for(std::vector<Block*>::iterator it = m_blocks.begin();
         it != m_blocks.end(); ++it) {
 
+        (*it)->leaveShip();
         (*it)->setOwner(block::NONE);
         (*it)->attach(false);
         (*it)->top = NULL;
@@ -165,43 +157,73 @@ void EnemyShip::destroy() {
 
 void EnemyShip::buildShip() {
 
+    // randomly select a ship
+    const ShipBlueprint* blueprint = NULL;
+    if (ShipBlueprint::count() > 0) {
+
+        blueprint = &ShipBlueprint::get(rand() % ShipBlueprint::count());
+    }
+
     // create the hub
-    m_hub = new EnemyHub(m_shipT->translation);
-    m_hub->attach(true);
+    m_hub = new EnemyHub(util::vec::Vector3());
+    m_hub->joinShip(m_shipT, 0, 0);
+    if (blueprint == NULL) {
+
+        m_hub->attach(true);
+        m_blocks.push_back(m_hub);
+        addEntity(m_hub);
+        return;
+    }
+
+    // create the blocks, the material rolls come from the bits of a single
+    // random number that is refreshed when they run out
+    const std::vector<ShipBlueprint::Cell>& cells = blueprint->getCells();
+    m_blocks.reserve(cells.size());
     m_blocks.push_back(m_hub);
-    addEntity(m_hub);
+    int bits = 0;
+    for (unsigned i = 1; i < cells.size(); ++i) {
 
-    // randomly select a ship
-    int rnd = rand() % 5;
+        if ((i - 1) % 15 == 0) {
 
-    if (rnd == 0) {
+            bits = rand();
+        }
+        float roll = static_cast<float>(1 + (bits & 1) + cells[i].tier);
+        bits >>= 1;
 
-        buildShip1();
+        Block* block = getBlock(util::vec::Vector3(), roll);
+        block->joinShip(m_shipT, cells[i].x, cells[i].y);
+        m_blocks.push_back(block);
     }
-    else if (rnd == 1) {
 
-        buildShip2();
-    }
-    else if (rnd == 2) {
+    // link the blocks using the neighbours found by the blueprint
+    for (unsigned i = 0; i < cells.size(); ++i) {
 
-        buildShip3();
-    }
-    else if (rnd == 3) {
+        const ShipBlueprint::Cell& cell = cells[i];
+        Block* block = m_blocks[i];
+        if (cell.top != ShipBlueprint::NO_NEIGHBOUR) {
 
-        buildShip4();
-    }
-    else if (rnd == 4) {
+            block->top = m_blocks[cell.top];
+        }
+        if (cell.bottom != ShipBlueprint::NO_NEIGHBOUR) {
 
-        buildShip5();
+            block->bottom = m_blocks[cell.bottom];
+        }
+        if (cell.left != ShipBlueprint::NO_NEIGHBOUR) {
+
+            block->left = m_blocks[cell.left];
+        }
+        if (cell.right != ShipBlueprint::NO_NEIGHBOUR) {
+
+            block->right = m_blocks[cell.right];
+        }
+        block->attach(true);
+        addEntity(block);
     }
 }
 
-Block* EnemyShip::getBlock(const util::vec::Vector3& pos) {
+Block* EnemyShip::getBlock(const util::vec::Vector3& pos, float roll) {
 
-    float rnd = static_cast<float>(rand() % 2);
-    rnd += 1.0f;
-    rnd *= m_diff;
-    rnd = fabs(rnd);
+    float rnd = fabs(roll * m_diff);
 
     if (rnd < 2.0f) {
 
@@ -233,278 +255,4 @@ Block* EnemyShip::getBlock(const util::vec::Vector3& pos) {
         m_health += 2.5f;
         return new GoldBlock(pos, block::ENEMY);
     }
-}
-
-void EnemyShip::buildShip1() {
-
-    Block* block1 = getBlock(util::vec::Vector3(-1.0f, 0.0f, 0.0f));
-    m_hub->left = block1;
-    block1->right = m_hub;
-    block1->attach(true);
-    m_blocks.push_back(block1);
-    addEntity(block1);
-
-    Block* block2 = getBlock(util::vec::Vector3(-2.0f, 0.0f, 0.0f));
-    block1->left = block2;
-    block2->right = block1;
-    block2->attach(true);
-    m_blocks.push_back(block2);
-    addEntity(block2);
-
-    Block* block3 = getBlock(util::vec::Vector3(-2.0f, -1.0f, 0.0f));
-    block2->bottom = block3;
-    block3->top = block2;
-    block3->attach(true);
-    m_blocks.push_back(block3);
-    addEntity(block3);
-
-    Block* block4 = getBlock(util::vec::Vector3(-2.0f, 1.0f, 0.0f));
-    block2->top = block4;
-    block4->bottom = block2;
-    block4->attach(true);
-    m_blocks.push_back(block4);
-    addEntity(block4);
-
-    Block* block5 = getBlock(util::vec::Vector3(1.0f, 0.0f, 0.0f));
-    m_hub->right = block5;
-    block5->left = m_hub;
-    block5->attach(true);
-    m_blocks.push_back(block5);
-    addEntity(block5);
-
-    Block* block6 = getBlock(util::vec::Vector3(2.0f, 0.0f, 0.0f));
-    block5->right = block6;
-    block6->left = block5;
-    block6->attach(true);
-    m_blocks.push_back(block6);
-    addEntity(block6);
-
-    Block* block7 = getBlock(util::vec::Vector3(2.0f, -1.0f, 0.0f));
-    block6->bottom = block7;
-    block7->top = block6;
-    block7->attach(true);
-    m_blocks.push_back(block7);
-    addEntity(block7);
-
-    Block* block8 = getBlock(util::vec::Vector3(2.0f, 1.0f, 0.0f));
-    block6->top = block8;
-    block8->bottom = block6;
-    block8->attach(true);
-    m_blocks.push_back(block8);
-    addEntity(block8);
-}
-
-void EnemyShip::buildShip2() {
-
-    Block* block1 = getBlock(util::vec::Vector3(0.0f, 1.0f, 0.0f));
-    m_hub->top = block1;
-    block1->bottom = m_hub;
-    block1->attach(true);
-    m_blocks.push_back(block1);
-    addEntity(block1);
-
-    Block* block2 = getBlock(util::vec::Vector3(0.0f, 2.0f, 0.0f));
-    block1->top = block2;
-    block2->bottom = block1;
-    block2->attach(true);
-    m_blocks.push_back(block2);
-    addEntity(block2);
-
-    Block* block3 = getBlock(util::vec::Vector3(0.0f, -1.0f, 0.0f));
-    m_hub->bottom = block3;
-    block3->top = m_hub;
-    block3->attach(true);
-    m_blocks.push_back(block3);
-    addEntity(block3);
-
-
-
-    Block* block4 = getBlock(util::vec::Vector3(1.0f, 0.0f, 0.0f));
-    m_hub->right = block4;
-    block4->left = m_hub;
-    block4->attach(true);
-    m_blocks.push_back(block4);
-    addEntity(block4);
-
-    Block* block5 = getBlock(util::vec::Vector3(1.0f, 1.0f, 0.0f));
-    block1->right = block5;
-    block5->left = block1;
-    block4->top = block5;
-    block5->bottom = block4;
-    block5->attach(true);
-    m_blocks.push_back(block5);
-    addEntity(block5);
-
-
-    Block* block6 = getBlock(util::vec::Vector3(-1.0f, 0.0f, 0.0f));
-    m_hub->left = block6;
-    block6->right = m_hub;
-    block6->attach(true);
-    m_blocks.push_back(block6);
-    addEntity(block6);
-
-    Block* block7 = getBlock(util::vec::Vector3(-1.0f, 1.0f, 0.0f));
-    block1->left = block7;
-    block7->right = block1;
-    block6->top = block7;
-    block7->bottom = block6;
-    block7->attach(true);
-    m_blocks.push_back(block7);
-    addEntity(block7);
-}
-
-void EnemyShip::buildShip3() {
-
-    Block* block1 = getBlock(util::vec::Vector3(0.0f, 1.0f, 0.0f));
-    m_hub->top = block1;
-    block1->bottom = m_hub;
-    block1->attach(true);
-    m_blocks.push_back(block1);
-    addEntity(block1);
-
-    Block* block2 = getBlock(util::vec::Vector3(0.0f, 2.0f, 0.0f));
-    block1->top = block2;
-    block2->bottom = block1;
-    block2->attach(true);
-    m_blocks.push_back(block2);
-    addEntity(block2);
-
-    Block* block3 = getBlock(util::vec::Vector3(0.0f, -1.0f, 0.0f));
-    m_hub->bottom = block3;
-    block3->top = m_hub;
-    block3->attach(true);
-    m_blocks.push_back(block3);
-    addEntity(block3);
-
-    Block* block5 = getBlock(util::vec::Vector3(1.0f, 1.0f, 0.0f));
-    block1->right = block5;
-    block5->left = block1;
-    block5->attach(true);
-    m_blocks.push_back(block5);
-    addEntity(block5);
-
-    Block* block7 = getBlock(util::vec::Vector3(-1.0f, 1.0f, 0.0f));
-    block1->left = block7;
-    block7->right = block1;
-    block7->attach(true);
-    m_blocks.push_back(block7);
-    addEntity(block7);
-}
-
-void EnemyShip::buildShip4() {
-
-    Block* block1 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    m_hub->bottom = block1;
-    block1->top = m_hub;
-    block1->attach(true);
-    m_blocks.push_back(block1);
-    addEntity(block1);
-
-    Block* block2 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block1->left = block2;
-    block2->right = block1;
-    block2->attach(true);
-    m_blocks.push_back(block2);
-    addEntity(block2);
-
-    Block* block3 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block1->right = block3;
-    block3->left = block1;
-    block3->attach(true);
-    m_blocks.push_back(block3);
-    addEntity(block3);
-
-    Block* block4 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    m_hub->top = block4;
-    block4->bottom = m_hub;
-    block4->attach(true);
-    m_blocks.push_back(block4);
-    addEntity(block4);
-
-    Block* block5 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block4->left = block5;
-    block5->right = block4;
-    block5->attach(true);
-    m_blocks.push_back(block5);
-    addEntity(block5);
-
-    Block* block6 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block4->right = block6;
-    block6->left = block4;
-    block6->attach(true);
-    m_blocks.push_back(block6);
-    addEntity(block6);
-
-    Block* block7 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block5->left = block7;
-    block7->right = block5;
-    block7->attach(true);
-    m_blocks.push_back(block7);
-    addEntity(block7);
-
-    Block* block8 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block6->right = block8;
-    block8->left = block6;
-    block8->attach(true);
-    m_blocks.push_back(block8);
-    addEntity(block8);
-}
-
-void EnemyShip::buildShip5() {
-
-    Block* block1 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    m_hub->bottom = block1;
-    block1->top = m_hub;
-    block1->attach(true);
-    m_blocks.push_back(block1);
-    addEntity(block1);
-
-    Block* block2 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    m_hub->left = block2;
-    block2->right = m_hub;
-    block2->attach(true);
-    m_blocks.push_back(block2);
-    addEntity(block2);
-
-    Block* block3 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block2->left = block3;
-    block3->right = block2;
-    block3->attach(true);
-    m_blocks.push_back(block3);
-    addEntity(block3);
-
-    Block* block3a = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block3->bottom = block3a;
-    block3a->top = block3;
-    block3a->attach(true);
-    m_blocks.push_back(block3a);
-    addEntity(block3a);
-
-    Block* block4 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    m_hub->right = block4;
-    block4->left = m_hub;
-    block4->attach(true);
-    m_blocks.push_back(block4);
-    addEntity(block4);
-
-    Block* block5 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block4->right = block5;
-    block5->left = block4;
-    block5->attach(true);
-    m_blocks.push_back(block5);
-    addEntity(block5);
-
-    Block* block6 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    block5->bottom = block6;
-    block6->top = block5;
-    block6->attach(true);
-    m_blocks.push_back(block6);
-    addEntity(block6);
-
-    Block* block7 = getBlock(util::vec::Vector3(0.0f, 0.0f, 0.0f));
-    m_hub->top = block7;
-    block7->bottom = m_hub;
-    block7->attach(true);
-    m_blocks.push_back(block7);
-    addEntity(block7);
-}
+}
\ No newline at end of file
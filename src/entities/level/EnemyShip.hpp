@@ -2,7 +2,9 @@
 #    define BOF_LEVEL_ENEMYSHIP_H_
 
 #include "src/omicron/entity/Entity.hpp"
+#include "src/omicron/physics/collision_detect/CollisionDetect.hpp"
 
+#include "src/entities/level/ShipBlueprint.hpp"
 #include "src/entities/level/block/EnemyHub.hpp"
 #include "src/entities/level/block/SteelBlock.hpp"
 #include "src/entities/level/block/RustyBlock.hpp"
@@ -57,29 +59,27 @@ private:
 
     float m_diff;
 
+    // the id of the bullet collision handler
+    unsigned m_bulletHandler;
+
     //--------------------------------------------------------------------------
     //                          PRIVATE MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
     void movement();
 
-    void collisions();
+    void addCollisionHandler();
 
     void destroy();
 
+    /** Spawns the blocks of a randomly chosen blueprint */
     void buildShip();
 
-    Block* getBlock(const util::vec::Vector3& pos);
-
-    void buildShip1();
-
-    void buildShip2();
-
-    void buildShip3();
-
-    void buildShip4();
-
-    void buildShip5();
+    /** Creates a block with a material that depends on the difficulty
+    @param pos the position of the block
+    @param roll the random part of the material roll, 1 or 2
+    @return the new block */
+    Block* getBlock(const util::vec::Vector3& pos, float roll);
 };
 
 #endif
@@ -1,22 +1,63 @@
 #include "Explosion.hpp"
 
+#include <cstring>
+
 //------------------------------------------------------------------------------
-//                                  CONSTRUCTOR
+//                                   VARIABLES
 //------------------------------------------------------------------------------
 
-Explosion::Explosion(const util::vec::Vector3& pos, const std::string& name) :
-    m_timer(0.0f) {
+namespace {
+
+// the explosion entity of the current scene
+static Explosion* instance = NULL;
+
+// the resource ids of the particle systems of each explosion effect
+static const char* EFFECTS[] = {
+    "bullet_explosion_1",
+    "bullet_explosion_2",
+    "bullet_explosion_3",
+    "bullet_explosion_4",
+    "bullet_explosion_5",
+    "block_explosion_1"
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Picks a random looking rotation for an explosion from its position.
+Explosions are created by entities that update in parallel, so using rand()
+here would make the random sequence depend on thread timing and break replays.
+@param pos the position of the explosion
+@return a rotation in whole degrees between 0 and 359 */
+float rotationFromPosition(const util::vec::Vector3& pos) {
+
+    unsigned x = 0;
+    unsigned y = 0;
+    memcpy(&x, &pos.x, sizeof(x));
+    memcpy(&y, &pos.y, sizeof(y));
+
+    unsigned hash = (x * 73856093u) ^ (y * 19349663u);
+    hash ^= hash >> 13;
+    hash *= 0x5bd1e995u;
+    hash ^= hash >> 15;
+
+    return static_cast<float>(hash % 360);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
 
-    float rnd = 0.0f + int((360.0 * rand()) / (RAND_MAX + 1.0));
+Explosion::Explosion() {
 
-    m_transform = new omi::Transform(
-        "", pos,
-        util::vec::Vector3(0.0f, 0.0f, rnd),
-        util::vec::Vector3(1.0f, 1.0f, 1.0f)
-    );
+    for (unsigned i = 0; i < sizeof(EFFECTS) / sizeof(EFFECTS[0]); ++i) {
 
-    m_sprite = omi::ResourceManager::getSprite(
-        name, "", m_transform);
+        m_systems[EFFECTS[i]] =
+            omi::ResourceManager::getParticleSystem(EFFECTS[i], "");
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -24,6 +65,11 @@ Explosion::Explosion(const util::vec::Vector3& pos, const std::string& name) :
 //------------------------------------------------------------------------------
 
 Explosion::~Explosion() {
+
+    if (instance == this) {
+
+        instance = NULL;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -32,19 +78,43 @@ Explosion::~Explosion() {
 
 void Explosion::init() {
 
-    m_components.add(m_transform);
-    m_components.add(m_sprite);
+    for (std::map<std::string, omi::ParticleSystem*>::iterator it =
+         m_systems.begin(); it != m_systems.end(); ++it) {
+
+        m_components.add(it->second);
+    }
+    instance = this;
 }
 
 void Explosion::update() {
 
-    m_transform->translation.y -=
-        value::DOWN_SPEED * omi::fpsManager.getTimeScale();
-
-    m_timer += 0.02f * omi::fpsManager.getTimeScale();
-    if (m_timer > 1.0f) {
+    for (std::map<std::string, omi::ParticleSystem*>::iterator it =
+         m_systems.begin(); it != m_systems.end(); ++it) {
 
-        remove();
+        it->second->update();
     }
 }
 
+//------------------------------------------------------------------------------
+//                            STATIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Explosion::spawn(const util::vec::Vector3& pos, const std::string& name) {
+
+    if (instance == NULL) {
+
+        return;
+    }
+
+    std::map<std::string, omi::ParticleSystem*>::iterator system =
+        instance->m_systems.find(name);
+    if (system == instance->m_systems.end()) {
+
+        std::cout << "EXPLOSION: unknown explosion " << name << std::endl;
+        return;
+    }
+
+    system->second->emit(
+        pos, util::vec::Vector2(0.0f, -value::DOWN_SPEED),
+        rotationFromPosition(pos));
+}
\ No newline at end of file
@@ -1,8 +1,15 @@
 #ifndef BOF_LEVEL_EXPLOSION_H_
 #    define BOF_LEVEL_EXPLOSION_H_
 
+#include <map>
+
 #include "src/omicron/entity/Entity.hpp"
 
+/******************************************************************************\
+| Draws every explosion in the level. Explosions are particles in one particle |
+| system per effect rather than entities of their own, so spawning one is      |
+| cheap enough to do for every bullet hit.                                     |
+\******************************************************************************/
 class Explosion : public omi::Entity {
 public:
 
@@ -10,7 +17,7 @@ public:
     //                                CONSTRUCTOR
     //--------------------------------------------------------------------------
 
-    Explosion(const util::vec::Vector3& pos, const std::string& name);
+    Explosion();
 
     //--------------------------------------------------------------------------
     //                                 DESTRUCTOR
@@ -28,16 +35,24 @@ public:
     /** #Override */
     void update();
 
+    //--------------------------------------------------------------------------
+    //                          STATIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Spawns a new explosion, this may be called by entities that update in
+    parallel. Does nothing if there is no explosion entity in the scene.
+    @param pos the position of the explosion
+    @param name the resource id of the explosion's particle system */
+    static void spawn(const util::vec::Vector3& pos, const std::string& name);
+
 private:
 
     //--------------------------------------------------------------------------
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    omi::Transform* m_transform;
-    omi::Sprite* m_sprite;
-
-    float m_timer;
+    // the particle system of each explosion effect
+    std::map<std::string, omi::ParticleSystem*> m_systems;
 };
 
-#endif
+#endif
\ No newline at end of file
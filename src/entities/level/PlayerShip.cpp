@@ -15,7 +15,6 @@ static const float MOVE_SPEED = 0.25f;
 //------------------------------------------------------------------------------
 
 PlayerShip::PlayerShip() :
-    m_first(true),
     m_start(false),
     m_coinTimer(0.0f) {
 }
@@ -25,6 +24,12 @@ PlayerShip::PlayerShip() :
 //------------------------------------------------------------------------------
 
 PlayerShip::~PlayerShip() {
+
+    for (std::vector<unsigned>::iterator it = m_handlers.begin();
+         it != m_handlers.end(); ++it) {
+
+        omi::CollisionDetect::removeHandler(*it);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -33,8 +38,10 @@ PlayerShip::~PlayerShip() {
 
 void PlayerShip::init() {
 
-    buildShip();
+    // the blocks are placed relative to the ship's transform
     initComponents();
+    buildShip();
+    addCollisionHandlers();
 }
 
 void PlayerShip::update() {
@@ -62,15 +69,6 @@ void PlayerShip::update() {
         m_music->play();
     }
 
-    if (!m_first) {
-
-        rebuild();
-    }
-    else {
-
-        m_first = false;
-    }
-
     processBlockGrab();
 
     // process input
@@ -83,229 +81,92 @@ void PlayerShip::update() {
 //                            PRIVATE MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
-void PlayerShip::processBlockGrab() {
-
-    std::vector<Block*> newBlocks;
-    // check over the collisions of the blocks contained withing this
-    for (std::vector<Block*>::iterator it = m_blocks.begin();
-         it != m_blocks.end(); ++it) {
-
-        // get collision data from each block
-        for (std::vector<omi::CollisionData>::iterator data =
-            (*it)->m_collisionDetect->getCollisionData().begin();
-            data != (*it)->m_collisionDetect->getCollisionData().end();
-            ++data) {
-
-            if (data->group.compare("none_block")) {
-
-                continue;
-            }
-
-            // cast the entity to a block
-            Block* block = static_cast<Block*>(data->entity);
-
-            // add to the list of new blocks
-            if (block->getOwner() == block::NONE &&
-                find(newBlocks.begin(), newBlocks.end(), block) == 
-                newBlocks.end()) {
-
-                // add to the list of new entities;
-                newBlocks.push_back(block);
-            }
-        }
-    }
-
-    // process the new blocks
-    for (std::vector<Block*>::iterator it = newBlocks.begin();
-         it != newBlocks.end(); ++it) {
-
-        // find the closet block
-        Block* closet = 0;
-        float distance = 10000000.0f;
-        for (std::vector<Block*>::iterator block = m_blocks.begin();
-             block != m_blocks.end(); ++block) {
+void PlayerShip::addCollisionHandlers() {
 
-            if ((*block)->top != NULL && (*block)->bottom != NULL &&
-                (*block)->left != NULL && (*block)->right != NULL) {
+    // free blocks that touch the ship are grabbed on the next update
+    m_handlers.push_back(omi::CollisionDetect::addHandler(
+        "player_block", "none_block",
+        omi::collision::BEGIN | omi::collision::PERSIST,
+        [this] (const omi::CollisionEvent& event) {
 
-                continue;
-            }
+        if (ownsBlock(static_cast<Block*>(event.ownerA))) {
 
-            if (util::vec::distance(
-                (*it)->m_transform->translation,
-                (*block)->m_transform->translation) <
-                distance) {
-
-                distance = util::vec::distance(
-                    (*it)->m_transform->translation,
-                    (*block)->m_transform->translation);
-                closet = *block;
-            }
+            m_grabbed.push_back(static_cast<Block*>(event.ownerB));
         }
-        // calculate the angle between the blocks
-        float angle = util::vec::angleBetween(
-            (*it)->m_transform->translation.xy(),
-            closet->m_transform->translation.xy());
-        if (angle < 0.0) {
+    }));
 
-            angle += 360.0f;
-        }
-        else if (angle >= 360.0f) {
+    // blocks are destroyed by crashing into enemy blocks
+    m_handlers.push_back(omi::CollisionDetect::addHandler(
+        "player_block", "enemy_block",
+        omi::collision::BEGIN | omi::collision::PERSIST,
+        [this] (const omi::CollisionEvent& event) {
 
-            angle -= 360.0f;
-        }
-        // attach to the closet block
-        if (angle > 45.0f &&  angle < 135.0f) {
+        Block* block = static_cast<Block*>(event.ownerA);
+        if (ownsBlock(block)) {
 
-            closet->bottom = *it;
-            (*it)->top = closet;
+            block->m_health = -1000.0f;
         }
-        else if (angle > 135.0f &&  angle < 225.0f) {
+    }));
 
-            closet->left = *it;
-            (*it)->right = closet;
-        }
-        else if (angle > 225.0f &&  angle < 315.0f) {
+    // blocks are damaged by enemy bullets
+    m_handlers.push_back(omi::CollisionDetect::addHandler(
+        "player_block", "enemy_bullet", omi::collision::BEGIN,
+        [this] (const omi::CollisionEvent& event) {
 
-            closet->top = *it;
-            (*it)->bottom = closet;
-        }
-        else {
+        Block* block = static_cast<Block*>(event.ownerA);
+        if (ownsBlock(block)) {
 
-            closet->right = *it;
-            (*it)->left = closet;
+            Bullet* bullet = static_cast<Bullet*>(event.ownerB);
+            bullet->destroy();
+            block->m_health -= bullet->getDamage() * 1.0f;
         }
-    }
-    for (std::vector<Block*>::iterator it = newBlocks.begin();
-         it != newBlocks.end(); ++it) {
-
-        (*it)->setOwner(block::PLAYER);
-        (*it)->attach(true);
-        m_blocks.push_back(*it);
-    }
+    }));
 }
 
-void PlayerShip::rebuild() {
-    
-    for (unsigned i = 0; i < m_blocks.size(); ++i) {
-
-        m_blocks[i]->traversed = false;
-        m_blocks[i]->top = NULL;
-        m_blocks[i]->bottom = NULL;
-        m_blocks[i]->left = NULL;
-        m_blocks[i]->right = NULL;
-    }
-    rebuildRec(m_hub);
-    // destroy any blocks that have not been connected
-    for (std::vector<Block*>::iterator it = m_blocks.begin();
-         it != m_blocks.end();) {
-
-        if (!(*it)->traversed) {
+bool PlayerShip::ownsBlock(Block* block) const {
 
-            (*it)->destroy();
-            it = m_blocks.erase(it);
-        }
-        else {
-
-            ++it;
-        }
-    }
+    return m_grid.contains(block);
 }
 
-void PlayerShip::rebuildRec(Block* block) {
-
-    if (block->traversed) {
-
-        return;
-    }
-    block->traversed = true;
-
-    // get collision data from each block
-    for (std::vector<omi::CollisionData>::iterator data =
-        block->m_collisionDetect->getCollisionData().begin();
-        data != block->m_collisionDetect->getCollisionData().end();
-        ++data) {
-
-        if (data->group.compare("player_block")) {
-
-            continue;
-        }
-
-        // cast the entity to a block
-        Block* collide = static_cast<Block*>(data->entity);
-
-        // find the side it's nearest too
-        float angle = util::vec::angleBetween(
-            block->m_transform->translation.xy(),
-            collide->m_transform->translation.xy());
-        if (angle < 0.0) {
-
-            angle += 360.0f;
-        }
-        else if (angle >= 360.0f) {
-
-            angle -= 360.0f;
-        }
-        // attach to the closet block
-        if (angle > 45.0f &&  angle < 135.0f) {
-
-            if (block->top != NULL) {
-
-                continue;
-            }
-
-            collide->bottom = block;
-            block->top = collide;
-        }
-        else if (angle > 135.0f &&  angle < 225.0f) {
-
-            if (block->right != NULL) {
-
-                continue;
-            }
-
-            collide->left = block;
-            block->right = collide;
-        }
-        else if (angle > 225.0f &&  angle < 315.0f) {
-
-            if (block->bottom != NULL) {
-
-                continue;
-            }
-
-            collide->top = block;
-            block->bottom = collide;
-        }
-        else {
+void PlayerShip::processBlockGrab() {
 
-            if (block->left != NULL) {
+    std::vector<Block*> newBlocks;
+    // check over the free blocks that have touched the ship
+    for (std::vector<Block*>::iterator it = m_grabbed.begin();
+         it != m_grabbed.end(); ++it) {
 
-                continue;
-            }
+        // add to the list of new blocks
+        if ((*it)->getOwner() == block::NONE &&
+            find(newBlocks.begin(), newBlocks.end(), *it) ==
+            newBlocks.end()) {
 
-            collide->right = block;
-            block->left = collide;
+            // add to the list of new entities;
+            newBlocks.push_back(*it);
         }
     }
+    m_grabbed.clear();
 
-    // rebuild neighbors
-    if (block->top != NULL) {
+    // attach each new block in the free cell closest to where it touched
+    for (std::vector<Block*>::iterator it = newBlocks.begin();
+         it != newBlocks.end(); ++it) {
 
-        rebuildRec(block->top);
-    }
-    if (block->bottom != NULL) {
+        util::vec::Vector3 offset =
+            (*it)->m_transform->translation - m_shipT->translation;
+        int x = 0;
+        int y = 0;
+        if (m_grid.findNearestFree(offset.xy(), x, y)) {
 
-        rebuildRec(block->bottom);
+            (*it)->setOwner(block::PLAYER);
+            addBlock(*it, x, y);
+        }
     }
-    if (block->left != NULL) {
+}
 
-        rebuildRec(block->left);
-    }
-    if (block->right != NULL) {
+void PlayerShip::addBlock(Block* block, int x, int y) {
 
-        rebuildRec(block->right);
-    }
+    m_grid.attach(block, x, y);
+    block->joinShip(m_shipT, x, y);
+    block->attach(true);
 }
 
 void PlayerShip::processInput() {
@@ -354,50 +215,35 @@ void PlayerShip::movement() {
 
         m_shipT->translation.y = -17.0f;
     }
-
-    // pass the position to the hub
-    for(std::vector<Block*>::iterator it = m_blocks.begin();
-        it != m_blocks.end(); ++it) {
-        (*it)->traversed = false;
-    }
-    m_hub->setPosition(m_shipT->translation);
 }
 
 void PlayerShip::collisions() {
 
-    for (std::vector<Block*>::iterator it = m_blocks.begin();
-         it != m_blocks.end();) {
-
-        // get collision data from each block
-        for (std::vector<omi::CollisionData>::iterator data =
-            (*it)->m_collisionDetect->getCollisionData().begin();
-            data != (*it)->m_collisionDetect->getCollisionData().end();
-            ++data) {
+    // damage is applied by the collision handlers
+    std::vector<Block*> destroyed;
+    const ShipGrid<Block>::t_CellMap& cells = m_grid.getCells();
+    for (ShipGrid<Block>::t_CellMap::const_iterator it = cells.begin();
+         it != cells.end(); ++it) {
 
-            if (!data->group.compare("enemy_bullet")) {
-
-                // cast the entity to a bullet
-                Bullet* bullet = static_cast<Bullet*>(data->entity);
-                bullet->destroy();
-                (*it)->m_health -= bullet->getDamage() * 1.0f;
-            }
-            if (!data->group.compare("enemy_block")) {
+        // TODO: hub destruction
+        if (it->first->m_health <= 0.0f && it->first != m_hub) {
 
-                (*it)->m_health = -1000.0f;
-            }
+            destroyed.push_back(it->first);
         }
+    }
+    for (std::vector<Block*>::iterator it = destroyed.begin();
+         it != destroyed.end(); ++it) {
 
-        // TODO: hub destruction
-        // destroy blocks if we need to
-        if ((*it)->m_health <= 0.0f && *it != m_hub) {
+        m_grid.detach(*it);
+        (*it)->destroy();
+    }
 
-            (*it)->destroy();
-            it = m_blocks.erase(it);
-        }
-        else {
+    // destroy any blocks that are no longer connected to the hub
+    std::vector<Block*> disconnected = m_grid.removeDisconnected(m_hub);
+    for (std::vector<Block*>::iterator it = disconnected.begin();
+         it != disconnected.end(); ++it) {
 
-            ++it;
-        }
+        (*it)->destroy();
     }
 }
 
@@ -453,97 +299,24 @@ void PlayerShip::buildShip() {
 
     // create the hub
     m_hub = new PlayerHub(util::vec::Vector3());
-    m_hub->attach(true);
-    m_blocks.push_back(m_hub);
+    addBlock(m_hub, 0, 0);
     addEntity(m_hub);
 
     //------------------------------INITIAL BLOCKS------------------------------
 
-    Block* block1 = new SteelBlock(
-        util::vec::Vector3(-1.0f, 0.0f, 0.0f), block::PLAYER);
-    m_hub->left = block1;
-    block1->right = m_hub;
-    block1->attach(true);
-    m_blocks.push_back(block1);
-    addEntity(block1);
-
-    Block* block2 = new SteelBlock(
-        util::vec::Vector3(1.0f, 0.0f, 0.0f), block::PLAYER);
-    m_hub->right = block2;
-    block2->left = m_hub;
-    block2->attach(true);
-    m_blocks.push_back(block2);
-    addEntity(block2);
-
-    Block* block3 = new SteelBlock(
-        util::vec::Vector3(0.0f, 1.0f, 0.0f), block::PLAYER);
-    m_hub->top = block3;
-    block3->bottom = m_hub;
-    block3->attach(true);
-    m_blocks.push_back(block3);
-    addEntity(block3);
-
-    Block* block4 = new SteelBlock(
-        util::vec::Vector3(-2.0f, 0.0f, 0.0f), block::PLAYER);
-    block1->left = block4;
-    block4->right = block1;
-    block4->attach(true);
-    m_blocks.push_back(block4);
-    addEntity(block4);
-
-    Block* block5 = new SteelBlock(
-        util::vec::Vector3(2.0f, 0.0f, 0.0f), block::PLAYER);
-    block2->right = block5;
-    block5->left = block2;
-    block5->attach(true);
-    m_blocks.push_back(block5);
-    addEntity(block5);
-
-    Block* block6 = new SteelBlock(
-        util::vec::Vector3(-1.0f, -1.0f, 0.0f), block::PLAYER);
-    block1->bottom = block6;
-    block6->top = block1;
-    block6->attach(true);
-    m_blocks.push_back(block6);
-    addEntity(block6);
-
-    Block* block7 = new SteelBlock(
-        util::vec::Vector3(1.0f, -1.0f, 0.0f), block::PLAYER);
-    block2->bottom = block7;
-    block7->top = block2;
-    block7->attach(true);
-    m_blocks.push_back(block7);
-    addEntity(block7);
-
-    Block* block8 = new SteelBlock(
-        util::vec::Vector3(0.0f, -1.0f, 0.0f), block::PLAYER);
-    m_hub->bottom = block8;
-    block8->top = m_hub;
-    block8->attach(true);
-    m_blocks.push_back(block8);
-    addEntity(block8);
-
-    Block* block9 = new SteelBlock(
-        util::vec::Vector3(0.0f, -2.0f, 0.0f), block::PLAYER);
-    block8->bottom = block9;
-    block9->top = block8;
-    block9->attach(true);
-    m_blocks.push_back(block9);
-    addEntity(block9);
-
-    Block* block10 = new SteelBlock(
-        util::vec::Vector3(-2.0f, 1.0f, 0.0f), block::PLAYER);
-    block4->top = block10;
-    block10->bottom = block4;
-    block10->attach(true);
-    m_blocks.push_back(block10);
-    addEntity(block10);
-
-    Block* block11 = new SteelBlock(
-        util::vec::Vector3(2.0f, 1.0f, 0.0f), block::PLAYER);
-    block5->top = block11;
-    block11->bottom = block5;
-    block11->attach(true);
-    m_blocks.push_back(block11);
-    addEntity(block11);
+    static const int LAYOUT[][2] = {
+        {-1,  0}, { 1,  0}, { 0,  1}, {-2,  0}, { 2,  0}, {-1, -1},
+        { 1, -1}, { 0, -1}, { 0, -2}, {-2,  1}, { 2,  1}
+    };
+    for (unsigned i = 0; i < sizeof(LAYOUT) / sizeof(LAYOUT[0]); ++i) {
+
+        Block* block = new SteelBlock(
+            util::vec::Vector3(
+                static_cast<float>(LAYOUT[i][0]),
+                static_cast<float>(LAYOUT[i][1]),
+                0.0f),
+            block::PLAYER);
+        addBlock(block, LAYOUT[i][0], LAYOUT[i][1]);
+        addEntity(block);
+    }
 }
\ No newline at end of file
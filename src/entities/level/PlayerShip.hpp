@@ -5,7 +5,9 @@
 
 #include "src/omicron/entity/Entity.hpp"
 #include "src/omicron/input/Input.hpp"
+#include "src/omicron/physics/collision_detect/CollisionDetect.hpp"
 
+#include "src/entities/level/ShipGrid.hpp"
 #include "src/entities/level/block/PlayerHub.hpp"
 #include "src/entities/level/block/SteelBlock.hpp"
 
@@ -47,15 +49,17 @@ private:
 
     // the hub of the ship
     PlayerHub* m_hub;
-    // the list of all blocks in the ship
-    std::vector<Block*> m_blocks;
+    // the layout of the blocks in the ship relative to the hub
+    ShipGrid<Block> m_grid;
+    // the free blocks that have been touched since the last update
+    std::vector<Block*> m_grabbed;
+    // the collision handlers registered by the ship
+    std::vector<unsigned> m_handlers;
 
     // music
     omi::Music* m_introMusic;
     omi::Music* m_music;
 
-    bool m_first;
-
     omi::Transform* m_guiT;
     omi::Sprite* m_guiSprite;
     omi::Sprite* m_coinSprite;
@@ -68,11 +72,18 @@ private:
     //                          PRIVATE MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    void processBlockGrab();
+    void addCollisionHandlers();
 
-    void rebuild();
+    /** @return if the block is part of this ship */
+    bool ownsBlock(Block* block) const;
+
+    void processBlockGrab();
 
-    void rebuildRec(Block* block);
+    /** Adds the block to the ship in the given cell
+    @param block the block to add
+    @param x the x position of the cell relative to the hub
+    @param y the y position of the cell relative to the hub */
+    void addBlock(Block* block, int x, int y);
 
     void processInput();
 
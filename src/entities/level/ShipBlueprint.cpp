@@ -0,0 +1,198 @@
+#include "ShipBlueprint.hpp"
+
+#include <fstream>
+#include <iostream>
+
+#include "lib/Utilitron/StringUtil.hpp"
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+namespace {
+
+// all loaded blueprints
+static std::vector<ShipBlueprint> blueprints;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Converts the rows of a ship's layout into its cells and adds the blueprint
+@param filePath the path of the file being parsed, for errors
+@param name the name of the ship
+@param rows the rows of the layout from the top of the ship down */
+void addBlueprint(
+        const std::string&              filePath,
+        const std::string&              name,
+        const std::vector<std::string>& rows) {
+
+    // find the hub so the other blocks can be placed relative to it
+    int hubX = 0;
+    int hubY = 0;
+    unsigned hubs = 0;
+    for (unsigned row = 0; row < rows.size(); ++row) {
+
+        std::string::size_type column = rows[row].find('H');
+        while (column != std::string::npos) {
+
+            hubX = static_cast<int>(column);
+            hubY = static_cast<int>(row);
+            ++hubs;
+            column = rows[row].find('H', column + 1);
+        }
+    }
+    if (hubs != 1) {
+
+        std::cout << "SHIP BLUEPRINT: " << filePath << ": ship " << name <<
+            " needs exactly one hub" << std::endl;
+        return;
+    }
+
+    std::vector<ShipBlueprint::Cell> cells;
+    ShipBlueprint::Cell hub = { 0, 0, 0 };
+    cells.push_back(hub);
+    for (unsigned row = 0; row < rows.size(); ++row) {
+
+        for (unsigned column = 0; column < rows[row].size(); ++column) {
+
+            char c = rows[row][column];
+            if (c == '.' || c == 'H') {
+
+                continue;
+            }
+            if (c < '0' || c > '9') {
+
+                std::cout << "SHIP BLUEPRINT: " << filePath << ": ship " <<
+                    name << " has unknown cell '" << c << "'" << std::endl;
+                continue;
+            }
+
+            ShipBlueprint::Cell cell = {
+                static_cast<int>(column) - hubX,
+                hubY - static_cast<int>(row),
+                c - '0'
+            };
+            cells.push_back(cell);
+        }
+    }
+
+    blueprints.push_back(ShipBlueprint(name, cells));
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+ShipBlueprint::ShipBlueprint(
+        const std::string&       name,
+        const std::vector<Cell>& cells) :
+    m_name (name),
+    m_cells(cells) {
+
+    // ships are small so a linear search for each neighbour is fine
+    for (std::vector<Cell>::iterator it = m_cells.begin();
+         it != m_cells.end(); ++it) {
+
+        it->top    = find(it->x,     it->y + 1);
+        it->bottom = find(it->x,     it->y - 1);
+        it->left   = find(it->x - 1, it->y);
+        it->right  = find(it->x + 1, it->y);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+const std::string& ShipBlueprint::getName() const {
+
+    return m_name;
+}
+
+const std::vector<ShipBlueprint::Cell>& ShipBlueprint::getCells() const {
+
+    return m_cells;
+}
+
+//------------------------------------------------------------------------------
+//                            STATIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ShipBlueprint::loadFile(const std::string& filePath) {
+
+    std::ifstream file(filePath.c_str());
+    if (!file.good()) {
+
+        std::cout << "SHIP BLUEPRINT: unable to open " << filePath <<
+            std::endl;
+        return;
+    }
+
+    std::string name;
+    std::vector<std::string> rows;
+    std::string line;
+    while (std::getline(file, line)) {
+
+        // ignore windows line endings
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+
+            line.erase(line.size() - 1);
+        }
+        if (line.empty() || line[0] == '#') {
+
+            continue;
+        }
+
+        if (util::str::beginsWith(line, "ship ")) {
+
+            if (!name.empty()) {
+
+                addBlueprint(filePath, name, rows);
+            }
+            name = line.substr(5);
+            rows.clear();
+        }
+        else if (name.empty()) {
+
+            std::cout << "SHIP BLUEPRINT: " << filePath <<
+                ": cells before the first ship" << std::endl;
+        }
+        else {
+
+            rows.push_back(line);
+        }
+    }
+    if (!name.empty()) {
+
+        addBlueprint(filePath, name, rows);
+    }
+}
+
+unsigned ShipBlueprint::count() {
+
+    return static_cast<unsigned>(blueprints.size());
+}
+
+const ShipBlueprint& ShipBlueprint::get(unsigned index) {
+
+    return blueprints[index];
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+int ShipBlueprint::find(int x, int y) const {
+
+    for (unsigned i = 0; i < m_cells.size(); ++i) {
+
+        if (m_cells[i].x == x && m_cells[i].y == y) {
+
+            return static_cast<int>(i);
+        }
+    }
+    return NO_NEIGHBOUR;
+}
\ No newline at end of file
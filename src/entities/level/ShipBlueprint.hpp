@@ -0,0 +1,104 @@
+#ifndef BOF_LEVEL_SHIPBLUEPRINT_H_
+#    define BOF_LEVEL_SHIPBLUEPRINT_H_
+
+#include <string>
+#include <vector>
+
+/*****************************************************************************\
+| The immutable layout of an enemy ship. Blueprints are parsed once from a    |
+| data file when the level pack is built and the neighbours of every cell are |
+| found up front so spawning a ship only has to create and link its blocks.   |
+|                                                                             |
+| A blueprint file holds any number of ships, each a name line followed by    |
+| rows of cells from the top of the ship down:                                |
+|                                                                             |
+|     ship <name>                                                             |
+|     0.0                                                                     |
+|     1H1                                                                     |
+|                                                                             |
+| H is the hub, a digit is a block with that bonus added to the roll that     |
+| picks its material and . is empty. Lines starting with # are comments.      |
+\*****************************************************************************/
+class ShipBlueprint {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // the index of a missing neighbour
+    static const int NO_NEIGHBOUR = -1;
+
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    // a single block of the ship
+    struct Cell {
+
+        // the position of the block relative to the hub
+        int x;
+        int y;
+        // added to the roll that picks the block's material
+        int tier;
+        // the indices of the top, bottom, left, and right neighbours
+        int top;
+        int bottom;
+        int left;
+        int right;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new blueprint and finds the neighbours of its cells
+    @param name the name of the ship
+    @param cells the blocks of the ship, the first is the hub */
+    ShipBlueprint(const std::string& name, const std::vector<Cell>& cells);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the name of the ship */
+    const std::string& getName() const;
+
+    /** @return the blocks of the ship, the first is the hub */
+    const std::vector<Cell>& getCells() const;
+
+    //--------------------------------------------------------------------------
+    //                          STATIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Parses every blueprint in the given file and adds them to the list of
+    blueprints
+    @param filePath the path to the blueprint file */
+    static void loadFile(const std::string& filePath);
+
+    /** @return the number of loaded blueprints */
+    static unsigned count();
+
+    /** @return the loaded blueprint at the given index */
+    static const ShipBlueprint& get(unsigned index);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the name of the ship
+    std::string m_name;
+    // the blocks of the ship
+    std::vector<Cell> m_cells;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the index of the cell at the given position or NO_NEIGHBOUR */
+    int find(int x, int y) const;
+};
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef BOF_LEVEL_SHIPGRID_H_
+#    define BOF_LEVEL_SHIPGRID_H_
+
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+#include "lib/Utilitron/Vector.hpp"
+
+/******************************************************************************\
+| The topology of a ship on an integer grid relative to its hub. Blocks are    |
+| linked to their neighbours as they are attached and unlinked as they are     |
+| detached so the ship never needs rebuilding. Connectivity to the root block  |
+| is only recomputed after a block has been detached.                          |
+|                                                                              |
+| T is any type with top, bottom, left and right pointers to its neighbours.   |
+\******************************************************************************/
+template<typename T>
+class ShipGrid {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(ShipGrid);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                   TYPES
+    //--------------------------------------------------------------------------
+
+    // an x, y position on the grid
+    typedef std::pair<int, int> t_Cell;
+    // maps each block in the grid to its cell
+    typedef std::map<T*, t_Cell> t_CellMap;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new empty ship grid */
+    ShipGrid() :
+        m_dirty(false) {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Places the block in the given cell and links it with the neighbouring
+    blocks. The cell must be free.
+    @param block the block to attach
+    @param x the x position of the cell
+    @param y the y position of the cell */
+    void attach(T* block, int x, int y) {
+
+        t_Cell cell(x, y);
+        m_blocks[cell] = block;
+        m_cells[block] = cell;
+
+        block->top    = get(x, y + 1);
+        block->bottom = get(x, y - 1);
+        block->left   = get(x - 1, y);
+        block->right  = get(x + 1, y);
+        if (block->top != NULL) {
+
+            block->top->bottom = block;
+        }
+        if (block->bottom != NULL) {
+
+            block->bottom->top = block;
+        }
+        if (block->left != NULL) {
+
+            block->left->right = block;
+        }
+        if (block->right != NULL) {
+
+            block->right->left = block;
+        }
+    }
+
+    /** Removes the block from its cell and unlinks it from its neighbours.
+    Blocks that were only connected through this block stay in the grid until
+    removeDisconnected is called.
+    @param block the block to detach */
+    void detach(T* block) {
+
+        typename t_CellMap::iterator cell = m_cells.find(block);
+        if (cell == m_cells.end()) {
+
+            return;
+        }
+        m_blocks.erase(cell->second);
+        m_cells.erase(cell);
+        unlink(block);
+        m_dirty = true;
+    }
+
+    /** Detaches every block that is no longer connected to the root block.
+    This only traverses the grid if a block has been detached since the last
+    call.
+    @param root the block the ship is connected through
+    @return the blocks that were detached */
+    std::vector<T*> removeDisconnected(T* root) {
+
+        std::vector<T*> removed;
+        if (!m_dirty) {
+
+            return removed;
+        }
+        m_dirty = false;
+
+        // breadth first search out from the root
+        std::set<T*> connected;
+        std::deque<T*> open;
+        if (contains(root)) {
+
+            connected.insert(root);
+            open.push_back(root);
+        }
+        while (!open.empty()) {
+
+            T* block = open.front();
+            open.pop_front();
+            T* neighbours[] = {
+                block->top, block->bottom, block->left, block->right
+            };
+            for (unsigned i = 0; i < 4; ++i) {
+
+                if (neighbours[i] != NULL &&
+                    connected.insert(neighbours[i]).second) {
+
+                    open.push_back(neighbours[i]);
+                }
+            }
+        }
+
+        if (connected.size() == m_cells.size()) {
+
+            return removed;
+        }
+        for (typename t_CellMap::iterator it = m_cells.begin();
+             it != m_cells.end();) {
+
+            if (connected.find(it->first) == connected.end()) {
+
+                removed.push_back(it->first);
+                m_blocks.erase(it->second);
+                m_cells.erase(it++);
+            }
+            else {
+
+                ++it;
+            }
+        }
+        // the disconnected blocks only link to each other
+        for (typename std::vector<T*>::iterator it = removed.begin();
+             it != removed.end(); ++it) {
+
+            unlink(*it);
+        }
+
+        return removed;
+    }
+
+    /** Finds the free cell next to the ship that is closest to the given
+    position
+    @param position the position relative to the cell at 0, 0
+    @param x returns the x position of the cell
+    @param y returns the y position of the cell
+    @return false if the grid is empty and there is no free cell next to it */
+    bool findNearestFree(
+            const util::vec::Vector2& position,
+                  int&                x,
+                  int&                y) const {
+
+        static const int OFFSETS[4][2] = {{0, 1}, {0, -1}, {-1, 0}, {1, 0}};
+
+        bool found = false;
+        float closest = 0.0f;
+        for (typename t_CellMap::const_iterator it = m_cells.begin();
+             it != m_cells.end(); ++it) {
+
+            for (unsigned i = 0; i < 4; ++i) {
+
+                int cx = it->second.first  + OFFSETS[i][0];
+                int cy = it->second.second + OFFSETS[i][1];
+                if (get(cx, cy) != NULL) {
+
+                    continue;
+                }
+                float distance = util::vec::distanceSquared(
+                    position, util::vec::Vector2(
+                        static_cast<float>(cx), static_cast<float>(cy)));
+                if (!found || distance < closest) {
+
+                    found = true;
+                    closest = distance;
+                    x = cx;
+                    y = cy;
+                }
+            }
+        }
+
+        return found;
+    }
+
+    //---------------------------------GETTERS----------------------------------
+
+    /** @return the block in the given cell or null if the cell is free */
+    T* get(int x, int y) const {
+
+        typename std::map<t_Cell, T*>::const_iterator block =
+            m_blocks.find(t_Cell(x, y));
+        if (block == m_blocks.end()) {
+
+            return NULL;
+        }
+        return block->second;
+    }
+
+    /** @return if the block is part of the grid */
+    bool contains(T* block) const {
+
+        return m_cells.find(block) != m_cells.end();
+    }
+
+    /** @return the number of blocks in the grid */
+    unsigned size() const {
+
+        return static_cast<unsigned>(m_cells.size());
+    }
+
+    /** @return the cell of every block in the grid */
+    const t_CellMap& getCells() const {
+
+        return m_cells;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the block in each occupied cell
+    std::map<t_Cell, T*> m_blocks;
+    // the cell of each block
+    t_CellMap m_cells;
+    // if a block has been detached since connectivity was last checked
+    bool m_dirty;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Clears the links between the block and its neighbours */
+    static void unlink(T* block) {
+
+        if (block->top != NULL) {
+
+            block->top->bottom = NULL;
+        }
+        if (block->bottom != NULL) {
+
+            block->bottom->top = NULL;
+        }
+        if (block->left != NULL) {
+
+            block->left->right = NULL;
+        }
+        if (block->right != NULL) {
+
+            block->right->left = NULL;
+        }
+        block->top    = NULL;
+        block->bottom = NULL;
+        block->left   = NULL;
+        block->right  = NULL;
+    }
+};
+
+#endif
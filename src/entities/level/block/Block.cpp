@@ -10,7 +10,6 @@ Block::Block(
         float bulletSpeed, const std::string& bulletSound,
         const util::vec::Vector3& pos,
               block::Owner         owner) :
-    traversed(false),
     m_spriteName(sprite),
     m_weaponName(weapon),
     m_engineName(engine),
@@ -39,18 +38,21 @@ Block::Block(
 
         m_transform->rotation.z = 180.0f;
     }
+    // the weapon and engine are positioned relative to the block
     m_weaponT = new omi::Transform(
         "",
-        m_transform->translation,
+        util::vec::Vector3(),
         util::vec::Vector3(),
         util::vec::Vector3(1.0f, 1.0f, 1.0f)
     );
+    m_weaponT->setParent(m_transform);
     m_engineT = new omi::Transform(
         "",
-        m_transform->translation,
+        util::vec::Vector3(),
         util::vec::Vector3(),
         util::vec::Vector3(1.0f, 1.0f, 1.0f)
     );
+    m_engineT->setParent(m_transform);
     m_trailT = new omi::Transform(
         "",
         util::vec::Vector3(),
@@ -109,9 +111,13 @@ void Block::init() {
     m_trailSprite = omi::ResourceManager::getMesh(
         m_trailName, "", m_trailT);
     m_components.add(m_trailSprite);
+    // the trail shader moves vertices back along the ship's path so the
+    // geometry bounds don't cover what is drawn
+    m_trailSprite->cullable = false;
 
     m_trailSprite->shaderFunction = [&] (GLuint program) {
 
+        util::vec::Vector3 position(m_transform->computeTranslation());
         GLfloat trailPos[27];
 
         unsigned index = 0;
@@ -136,14 +142,14 @@ void Block::init() {
             }
             if (m_state == block::ATTACHING) {
 
-                trailPos[(index * 3) + 1] = m_transform->translation.y -
+                trailPos[(index * 3) + 1] = position.y -
                     (1.25f - m_trailTimer);
             }
             else {
 
-                trailPos[(index * 3) + 1] = m_transform->translation.y - 1.25f;
+                trailPos[(index * 3) + 1] = position.y - 1.25f;
             }
-            trailPos[(index * 3) + 2] = m_transform->translation.z;
+            trailPos[(index * 3) + 2] = position.z;
             ++index;
         }
         for (int i = 8; i > static_cast<int>( m_trailIndex ); --i) {
@@ -163,12 +169,12 @@ void Block::init() {
             }
             if (m_state == block::ATTACHING) {
 
-                trailPos[(index * 3) + 1] = m_transform->translation.y -
+                trailPos[(index * 3) + 1] = position.y -
                     (1.25f - m_trailTimer);
             }
             else {
 
-                trailPos[(index * 3) + 1] = m_transform->translation.y - 1.25f;
+                trailPos[(index * 3) + 1] = position.y - 1.25f;
             }
             trailPos[(index * 3) + 2] = m_trailPositions[i].z;
             ++index;
@@ -198,7 +204,7 @@ void Block::update() {
         }
     }
     // update the current trail
-    m_trailPositions[m_trailIndex] = m_engineT->translation;
+    m_trailPositions[m_trailIndex] = m_engineT->computeTranslation();
 
     // update based on state
     switch (m_state) {
@@ -213,7 +219,7 @@ void Block::update() {
             // clear trail positions
             for (unsigned i = 0; i < 9; ++i) {
 
-                m_trailPositions[i] = m_engineT->translation;
+                m_trailPositions[i] = m_engineT->computeTranslation();
             }
             break;
         }
@@ -250,6 +256,11 @@ void Block::update() {
         }
     }
 
+    // the offsets are in the block's local space so the parent transform
+    // takes care of flipping them for enemy blocks
+    m_weaponT->translation = m_weaponOffset;
+    m_engineT->translation = m_engineOffset;
+
     // update based on owner
     switch (m_owner) {
 
@@ -292,57 +303,43 @@ void Block::update() {
 
     if (m_dead) {
 
-        if (m_transform->translation.y > -24.0f) {
+        util::vec::Vector3 position(m_transform->computeTranslation());
+        if (position.y > -24.0f) {
 
             omi::SoundPool::play(m_blockSound, false, 1.0f);
         }
-        addEntity(new Explosion(m_transform->translation, "block_explosion_1"));
+        Explosion::spawn(position, "block_explosion_1");
         remove();
     }
 }
 
-void Block::setPosition(const util::vec::Vector3& pos) {
-
-    traversed = true;
-    m_transform->translation = pos;
-
-    // set the position of neighbors
-    if (top != NULL && !top->traversed) {
+bool Block::isParallelSafe() const {
 
-        top->setPosition(pos + util::vec::Vector3(0.0f, 1.0f, 0.0f));
-    }
-    if (bottom != NULL && !bottom->traversed) {
-
-        bottom->setPosition(pos + util::vec::Vector3(0.0f, -1.0f, 0.0f));
-    }
-    if (left != NULL && !left->traversed) {
+    // free floating blocks only move themselves, once a block is part of a
+    // ship its position is relative to the ship's transform
+    return m_owner == block::NONE &&
+           top    == NULL         &&
+           bottom == NULL         &&
+           left   == NULL         &&
+           right  == NULL;
+}
 
-        left->setPosition(pos + util::vec::Vector3(-1.0f, 0.0f, 0.0f));
-    }
-    if (right != NULL && !right->traversed) {
+void Block::joinShip(omi::Transform* ship, int x, int y) {
 
-        right->setPosition(pos + util::vec::Vector3(1.0f, 0.0f, 0.0f));
-    }
+    m_transform->setParent(ship);
+    m_transform->translation = util::vec::Vector3(
+        static_cast<float>(x), static_cast<float>(y), 0.0f);
+}
 
-    // update the weapons position
-    if (m_owner == block::ENEMY) {
+void Block::leaveShip() {
 
-        m_weaponT->translation = m_transform->translation - m_weaponOffset;
-        m_engineT->translation = m_transform->translation - m_engineOffset;
-    }
-    else {
+    if (m_transform->getParent() == NULL) {
 
-        m_weaponT->translation = m_transform->translation + m_weaponOffset;
-        m_engineT->translation = m_transform->translation + m_engineOffset;
+        return;
     }
-
-    m_weaponT->rotation    = m_transform->rotation;
-    m_engineT->rotation    = m_transform->rotation;
-}
-
-void Block::renew() {
-
-    traversed = true;
+    util::vec::Vector3 position(m_transform->computeTranslation());
+    m_transform->setParent(NULL);
+    m_transform->translation = position;
 }
 
 void Block::attach(bool a) {
@@ -406,8 +403,6 @@ void Block::noOwnerUpdate() {
     m_transform->translation.y += flySpeed *
         sin(flyDir * util::math::DEGREES_TO_RADIANS);
 
-    setPosition(m_transform->translation);
-
     if (m_flySpeed > 0.0f) {
 
         m_flySpeed -= 0.0002f * omi::fpsManager.getTimeScale();
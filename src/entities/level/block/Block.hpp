@@ -32,9 +32,6 @@ public:
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    // if the block has been traversed this iteration
-    bool traversed;
-
     // the neighbors of the block
     Block* top;
     Block* bottom;
@@ -79,12 +76,21 @@ public:
     /** #Override */
     virtual void update();
 
-    virtual void setPosition(const util::vec::Vector3& pos);
+    /** #Override */
+    virtual bool isParallelSafe() const;
 
     virtual void createBullet() = 0;
 
-    /** Renews the travsel state of this block */
-    void renew();
+    /** Makes the block part of a ship. The block's transform becomes relative
+    to the ship so it moves with the ship without being updated.
+    @param ship the transform of the ship
+    @param x the x offset of the block's cell from the ship's hub
+    @param y the y offset of the block's cell from the ship's hub */
+    void joinShip(omi::Transform* ship, int x, int y);
+
+    /** Detaches the block from the ship's transform, keeping its current
+    world position */
+    void leaveShip();
 
     void attach(bool a);
 
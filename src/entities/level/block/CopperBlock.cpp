@@ -25,7 +25,7 @@ CopperBlock::~CopperBlock() {
 void CopperBlock::createBullet() {
 
     addEntity(new CopperBullet(
-        bullet::Owner(m_owner), m_weaponT->translation, -35.0f));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation(), -35.0f));
     addEntity(new CopperBullet(
-        bullet::Owner(m_owner), m_weaponT->translation, 35.0f));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation(), 35.0f));
 }
\ No newline at end of file
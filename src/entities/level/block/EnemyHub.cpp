@@ -23,5 +23,5 @@ EnemyHub::~EnemyHub() {
 void EnemyHub::createBullet() {
 
     addEntity(new SteelBullet(
-        bullet::Owner(m_owner), m_weaponT->translation));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation()));
 }
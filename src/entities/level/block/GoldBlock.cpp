@@ -25,10 +25,10 @@ GoldBlock::~GoldBlock() {
 void GoldBlock::createBullet() {
 
     addEntity(new GoldBullet(
-        bullet::Owner(m_owner), m_weaponT->translation, -35.0f));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation(), -35.0f));
     addEntity(new GoldBullet(
-        bullet::Owner(m_owner), m_weaponT->translation, 0.0f));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation(), 0.0f));
     addEntity(new GoldBullet(
-        bullet::Owner(m_owner), m_weaponT->translation, 35.0f));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation(), 35.0f));
 }
 
@@ -25,5 +25,5 @@ RustyBlock::~RustyBlock() {
 void RustyBlock::createBullet() {
 
     addEntity(new RustyBullet(
-        bullet::Owner(m_owner), m_weaponT->translation));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation()));
 }
@@ -25,5 +25,5 @@ SilverBlock::~SilverBlock() {
 void SilverBlock::createBullet() {
 
     addEntity(new SilverBullet(
-        bullet::Owner(m_owner), m_weaponT->translation));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation()));
 }
@@ -23,5 +23,5 @@ SteelBlock::~SteelBlock() {
 void SteelBlock::createBullet() {
 
     addEntity(new SteelBullet(
-        bullet::Owner(m_owner), m_weaponT->translation));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation()));
 }
\ No newline at end of file
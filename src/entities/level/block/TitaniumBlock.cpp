@@ -24,5 +24,5 @@ TitaniumBlock::~TitaniumBlock() {
 void TitaniumBlock::createBullet() {
 
     addEntity(new TitaniumBullet(
-        bullet::Owner(m_owner), m_weaponT->translation));
+        bullet::Owner(m_owner), m_weaponT->computeTranslation()));
 }
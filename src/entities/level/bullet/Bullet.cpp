@@ -94,6 +94,12 @@ void Bullet::update() {
     }
 }
 
+bool Bullet::isParallelSafe() const {
+
+    // bullets only ever move themselves, the ships destroy them
+    return true;
+}
+
 void Bullet::destroy() {
 
     m_dead = true;
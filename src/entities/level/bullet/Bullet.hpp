@@ -40,6 +40,9 @@ public:
     /** #Override */
     void update();
 
+    /** #Override */
+    bool isParallelSafe() const;
+
     void destroy();
 
     virtual util::vec::Vector3 computeBulletMove() = 0;
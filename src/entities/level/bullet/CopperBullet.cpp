@@ -38,8 +38,7 @@ util::vec::Vector3 CopperBullet::computeBulletMove() {
 
 void CopperBullet::addExplosion() {
 
-    addEntity(new Explosion(
-        m_transform->translation, "bullet_explosion_2"));
+    Explosion::spawn(m_transform->translation, "bullet_explosion_2");
 }
 
 float CopperBullet::getDamage() const {
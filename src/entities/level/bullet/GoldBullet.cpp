@@ -38,8 +38,7 @@ util::vec::Vector3 GoldBullet::computeBulletMove() {
 
 void GoldBullet::addExplosion() {
 
-    addEntity(new Explosion(
-        m_transform->translation, "bullet_explosion_5"));
+    Explosion::spawn(m_transform->translation, "bullet_explosion_5");
 }
 
 float GoldBullet::getDamage() const {
@@ -26,8 +26,7 @@ util::vec::Vector3 RustyBullet::computeBulletMove() {
 
 void RustyBullet::addExplosion() {
 
-    addEntity(new Explosion(
-        m_transform->translation, "bullet_explosion_1"));
+    Explosion::spawn(m_transform->translation, "bullet_explosion_1");
 }
 
 float RustyBullet::getDamage() const {
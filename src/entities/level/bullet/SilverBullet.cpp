@@ -58,8 +58,7 @@ util::vec::Vector3 SilverBullet::computeBulletMove() {
 
 void SilverBullet::addExplosion() {
 
-    addEntity(new Explosion(
-        m_transform->translation, "bullet_explosion_4"));
+    Explosion::spawn(m_transform->translation, "bullet_explosion_4");
 }
 
 float SilverBullet::getDamage() const {
@@ -26,8 +26,7 @@ util::vec::Vector3 SteelBullet::computeBulletMove() {
 
 void SteelBullet::addExplosion() {
 
-    addEntity(new Explosion(
-        m_transform->translation, "bullet_explosion_1"));
+    Explosion::spawn(m_transform->translation, "bullet_explosion_1");
 }
 
 float SteelBullet::getDamage() const {
@@ -26,8 +26,7 @@ util::vec::Vector3 TitaniumBullet::computeBulletMove() {
 
 void TitaniumBullet::addExplosion() {
 
-    addEntity(new Explosion(
-        m_transform->translation, "bullet_explosion_3"));
+    Explosion::spawn(m_transform->translation, "bullet_explosion_3");
 }
 
 float TitaniumBullet::getDamage() const {
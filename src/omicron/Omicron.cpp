@@ -13,4 +13,6 @@ AudioSettings audioSettings;
 
 FPSManager fpsManager;
 
+JobSystem jobSystem;
+
 } // namespace omi
@@ -2,6 +2,7 @@
 #   define OMICRON_OMICRON_H_
 
 #include "src/omicron/logic/FPSManager.hpp"
+#include "src/omicron/logic/JobSystem.hpp"
 #include "src/omicron/settings/AudioSettings.hpp"
 #include "src/omicron/settings/DisplaySettings.hpp"
 #include "src/omicron/settings/RenderSettings.hpp"
@@ -27,6 +28,9 @@ extern AudioSettings audioSettings;
 // the fps manager
 extern FPSManager fpsManager;
 
+// the job system used to run work across threads
+extern JobSystem jobSystem;
+
 } // namespace omi
 
 #endif
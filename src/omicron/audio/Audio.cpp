@@ -0,0 +1,87 @@
+#include "Audio.hpp"
+
+#include <cstdlib>
+
+#include "src/omicron/Omicron.hpp"
+#include "src/omicron/audio/DeviceAudioBackend.hpp"
+#include "src/omicron/audio/SoftwareMixer.hpp"
+
+namespace omi {
+
+namespace audio {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+// if the software mixer should be used
+bool softwareMixer = false;
+// the file the software mixer writes to
+std::string mixerOutputPath;
+
+// the backend, this is never deleted since components may still use it while
+// they are destroyed at exit
+AudioBackend* backend = NULL;
+// the backend if it is the software mixer
+SoftwareMixer* mixer = NULL;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Mixes any remaining audio and completes the output file */
+void finishOnExit() {
+
+    mixer->finish();
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void useSoftwareMixer(const std::string& outputPath) {
+
+    softwareMixer = true;
+    mixerOutputPath = outputPath;
+}
+
+void init() {
+
+    if (backend != NULL) {
+
+        return;
+    }
+
+    if (softwareMixer) {
+
+        mixer = new SoftwareMixer(mixerOutputPath);
+        mixer->start();
+        atexit(finishOnExit);
+        backend = mixer;
+    }
+    else if (!systemSettings.isHeadless()) {
+
+        backend = new DeviceAudioBackend();
+    }
+}
+
+void advance(float milliseconds) {
+
+    if (backend != NULL) {
+
+        backend->advance(milliseconds);
+    }
+}
+
+AudioBackend* getBackend() {
+
+    return backend;
+}
+
+} // namespace audio
+
+} // namespace omi
\ No newline at end of file
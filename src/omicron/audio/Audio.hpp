@@ -0,0 +1,44 @@
+#ifndef OMICRON_AUDIO_AUDIO_H_
+#   define OMICRON_AUDIO_AUDIO_H_
+
+#include <string>
+
+#include "src/omicron/audio/AudioBackend.hpp"
+
+namespace omi {
+
+/*****************************************************************************\
+| Chooses and holds the backend that Omicron plays audio through. By default  |
+| audio is played on the system's audio device, or not at all when running    |
+| headless. The software mixer can be used instead to run audio on machines   |
+| with no sound hardware and to capture it for testing.                       |
+\*****************************************************************************/
+namespace audio {
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Makes Omicron mix audio in process rather than playing it on the audio
+device. This also enables audio when running headless.
+#WARNING: this must be called before Omicron is initialised
+@param outputPath the WAV file to write the mix to, or empty to discard it */
+void useSoftwareMixer(const std::string& outputPath);
+
+/** #Hidden
+Creates the audio backend */
+void init();
+
+/** #Hidden
+Advances the audio clock at the end of a logic cycle
+@param milliseconds the length of the cycle */
+void advance(float milliseconds);
+
+/** @return the audio backend or null if there is no audio */
+AudioBackend* getBackend();
+
+} // namespace audio
+
+} // namespace omi
+
+#endif
\ No newline at end of file
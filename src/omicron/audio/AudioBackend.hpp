@@ -0,0 +1,132 @@
+#ifndef OMICRON_AUDIO_AUDIOBACKEND_H_
+#   define OMICRON_AUDIO_AUDIOBACKEND_H_
+
+#include <string>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+
+namespace omi {
+
+/******************************************************************************\
+| Abstract interface to whatever is playing Omicron's audio.                   |
+|                                                                              |
+| Sounds are loaded whole and played on a fixed number of numbered voices.     |
+| Streams are longer pieces of audio, such as music, that each play on their   |
+| own. Volumes are from 0 to 1.                                                |
+\******************************************************************************/
+class AudioBackend {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(AudioBackend);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Super constructor */
+    AudioBackend() {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    virtual ~AudioBackend() {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    //-----------------------------------SOUNDS---------------------------------
+
+    /** Loads a sound
+    @param filePath the location of the sound
+    @return the handle of the sound */
+    virtual unsigned loadSound(const std::string& filePath) = 0;
+
+    /** Releases a sound, no voices may be playing it
+    @param sound the handle of the sound */
+    virtual void releaseSound(unsigned sound) = 0;
+
+    /** @return the bytes of memory used by the samples of a sound
+    @param sound the handle of the sound */
+    virtual unsigned getSoundBytes(unsigned sound) = 0;
+
+    //-----------------------------------VOICES---------------------------------
+
+    /** Sets the number of voices, this stops any playing voices
+    @param count the number of voices */
+    virtual void setVoiceCount(unsigned count) = 0;
+
+    /** Starts playing a sound on a voice, replacing what the voice was playing
+    @param voice the index of the voice
+    @param sound the handle of the sound to play
+    @param loop whether the sound should loop
+    @param volume the volume to play the sound at */
+    virtual void playVoice(
+            unsigned voice, unsigned sound, bool loop, float volume) = 0;
+
+    /** Stops a voice
+    @param voice the index of the voice */
+    virtual void stopVoice(unsigned voice) = 0;
+
+    /** @return if the voice is playing a sound
+    @param voice the index of the voice */
+    virtual bool isVoicePlaying(unsigned voice) = 0;
+
+    //-----------------------------------STREAMS--------------------------------
+
+    /** Opens a stream
+    @param filePath the location of the audio to stream
+    @return the handle of the stream */
+    virtual unsigned openStream(const std::string& filePath) = 0;
+
+    /** Stops and closes a stream
+    @param stream the handle of the stream */
+    virtual void closeStream(unsigned stream) = 0;
+
+    /** Starts or resumes playback of a stream
+    @param stream the handle of the stream */
+    virtual void playStream(unsigned stream) = 0;
+
+    /** Pauses playback of a stream
+    @param stream the handle of the stream */
+    virtual void pauseStream(unsigned stream) = 0;
+
+    /** Stops playback of a stream and rewinds it
+    @param stream the handle of the stream */
+    virtual void stopStream(unsigned stream) = 0;
+
+    /** Sets the volume of a stream
+    @param stream the handle of the stream
+    @param volume the new volume */
+    virtual void setStreamVolume(unsigned stream, float volume) = 0;
+
+    /** Sets if a stream loops
+    @param stream the handle of the stream
+    @param loop whether the stream should loop */
+    virtual void setStreamLoop(unsigned stream, bool loop) = 0;
+
+    /** @return if the stream is stopped, either by stopStream or by reaching
+    its end
+    @param stream the handle of the stream */
+    virtual bool isStreamStopped(unsigned stream) = 0;
+
+    //------------------------------------CLOCK---------------------------------
+
+    /** Advances the backend's clock. Backends playing on a device run on the
+    device's clock and ignore this.
+    @param milliseconds the length of the logic cycle that just ran */
+    virtual void advance(float milliseconds) = 0;
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "DeviceAudioBackend.hpp"
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+DeviceAudioBackend::DeviceAudioBackend() :
+    m_nextHandle(0) {
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+DeviceAudioBackend::~DeviceAudioBackend() {
+
+    // the voices must stop before the buffers they play are destroyed
+    m_voices.clear();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+unsigned DeviceAudioBackend::loadSound(const std::string& filePath) {
+
+    std::unique_ptr<sf::SoundBuffer> buffer(new sf::SoundBuffer());
+    if (!buffer->loadFromFile(filePath.c_str())) {
+
+        std::cout << "loading sound failed" << std::endl;
+    }
+
+    unsigned handle = m_nextHandle++;
+    m_sounds[handle] = std::move(buffer);
+    return handle;
+}
+
+void DeviceAudioBackend::releaseSound(unsigned sound) {
+
+    m_sounds.erase(sound);
+}
+
+unsigned DeviceAudioBackend::getSoundBytes(unsigned sound) {
+
+    return static_cast<unsigned>(
+        m_sounds[sound]->getSampleCount() * sizeof(sf::Int16));
+}
+
+void DeviceAudioBackend::setVoiceCount(unsigned count) {
+
+    for (std::vector<sf::Sound>::iterator it = m_voices.begin();
+         it != m_voices.end(); ++it) {
+
+        it->stop();
+    }
+    m_voices.assign(count, sf::Sound());
+}
+
+void DeviceAudioBackend::playVoice(
+        unsigned voice, unsigned sound, bool loop, float volume) {
+
+    sf::Sound& s = m_voices[voice];
+    s.stop();
+    s.setBuffer(*m_sounds[sound]);
+    s.setLoop(loop);
+    s.setVolume(volume * 100.0f);
+    s.play();
+}
+
+void DeviceAudioBackend::stopVoice(unsigned voice) {
+
+    m_voices[voice].stop();
+}
+
+bool DeviceAudioBackend::isVoicePlaying(unsigned voice) {
+
+    return m_voices[voice].getStatus() == sf::Sound::Playing;
+}
+
+unsigned DeviceAudioBackend::openStream(const std::string& filePath) {
+
+    std::unique_ptr<sf::Music> music(new sf::Music());
+    if (!music->openFromFile(filePath)) {
+
+        // TODO: throw an exception??
+        std::cout << "music failed to load" << std::endl;
+    }
+
+    unsigned handle = m_nextHandle++;
+    m_streams[handle] = std::move(music);
+    return handle;
+}
+
+void DeviceAudioBackend::closeStream(unsigned stream) {
+
+    m_streams.erase(stream);
+}
+
+void DeviceAudioBackend::playStream(unsigned stream) {
+
+    m_streams[stream]->play();
+}
+
+void DeviceAudioBackend::pauseStream(unsigned stream) {
+
+    m_streams[stream]->pause();
+}
+
+void DeviceAudioBackend::stopStream(unsigned stream) {
+
+    m_streams[stream]->stop();
+}
+
+void DeviceAudioBackend::setStreamVolume(unsigned stream, float volume) {
+
+    m_streams[stream]->setVolume(volume * 100.0f);
+}
+
+void DeviceAudioBackend::setStreamLoop(unsigned stream, bool loop) {
+
+    m_streams[stream]->setLoop(loop);
+}
+
+bool DeviceAudioBackend::isStreamStopped(unsigned stream) {
+
+    return m_streams[stream]->getStatus() == sf::SoundSource::Stopped;
+}
+
+void DeviceAudioBackend::advance(float milliseconds) {
+
+    // the device keeps its own time
+}
+
+} // namespace omi
\ No newline at end of file
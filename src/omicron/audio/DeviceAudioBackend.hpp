@@ -0,0 +1,103 @@
+#ifndef OMICRON_AUDIO_DEVICEAUDIOBACKEND_H_
+#   define OMICRON_AUDIO_DEVICEAUDIOBACKEND_H_
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <SFML/Audio.hpp>
+#include <vector>
+
+#include "src/omicron/audio/AudioBackend.hpp"
+
+namespace omi {
+
+/*****************************************************\
+| Plays audio on the system's audio device via SFML. |
+\*****************************************************/
+class DeviceAudioBackend : public AudioBackend {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new device backend with no voices */
+    DeviceAudioBackend();
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~DeviceAudioBackend();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** #Override */
+    unsigned loadSound(const std::string& filePath);
+
+    /** #Override */
+    void releaseSound(unsigned sound);
+
+    /** #Override */
+    unsigned getSoundBytes(unsigned sound);
+
+    /** #Override */
+    void setVoiceCount(unsigned count);
+
+    /** #Override */
+    void playVoice(unsigned voice, unsigned sound, bool loop, float volume);
+
+    /** #Override */
+    void stopVoice(unsigned voice);
+
+    /** #Override */
+    bool isVoicePlaying(unsigned voice);
+
+    /** #Override */
+    unsigned openStream(const std::string& filePath);
+
+    /** #Override */
+    void closeStream(unsigned stream);
+
+    /** #Override */
+    void playStream(unsigned stream);
+
+    /** #Override */
+    void pauseStream(unsigned stream);
+
+    /** #Override */
+    void stopStream(unsigned stream);
+
+    /** #Override */
+    void setStreamVolume(unsigned stream, float volume);
+
+    /** #Override */
+    void setStreamLoop(unsigned stream, bool loop);
+
+    /** #Override */
+    bool isStreamStopped(unsigned stream);
+
+    /** #Override */
+    void advance(float milliseconds);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the loaded sounds
+    std::map<unsigned, std::unique_ptr<sf::SoundBuffer>> m_sounds;
+    // the voices
+    std::vector<sf::Sound> m_voices;
+    // the open streams
+    std::map<unsigned, std::unique_ptr<sf::Music>> m_streams;
+    // the next handle to give to a sound or stream
+    unsigned m_nextHandle;
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
@@ -0,0 +1,605 @@
+#include "SoftwareMixer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <SFML/Audio.hpp>
+
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+
+namespace omi {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Writes a little endian integer to the stream
+@param stream the stream to write to
+@param value the value to write
+@param bytes the number of bytes of the value to write */
+void writeLittleEndian(std::ostream& stream, unsigned value, unsigned bytes) {
+
+    for (unsigned i = 0; i < bytes; ++i) {
+
+        stream.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+SoftwareMixer::SoftwareMixer(const std::string& outputPath) :
+    m_running   (false),
+    m_quit      (false),
+    m_time      (0.0),
+    m_target    (0),
+    m_nextHandle(0),
+    m_mixed     (0),
+    m_written   (0) {
+
+    if (!outputPath.empty()) {
+
+        m_output.open(outputPath.c_str(), std::ios::binary);
+        if (!m_output.good()) {
+
+            std::cout << "SOFTWARE MIXER: unable to open " << outputPath <<
+                std::endl;
+        }
+        else {
+
+            // the sizes are filled in when the mixer finishes
+            writeHeader();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+SoftwareMixer::~SoftwareMixer() {
+
+    finish();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void SoftwareMixer::start() {
+
+    if (m_running) {
+
+        return;
+    }
+
+    m_quit = false;
+    m_running = true;
+    m_thread = std::thread(&SoftwareMixer::run, this);
+}
+
+void SoftwareMixer::finish() {
+
+    if (m_running) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+        m_running = false;
+    }
+
+    if (m_output.is_open()) {
+
+        writeHeader();
+        m_output.close();
+    }
+}
+
+void SoftwareMixer::render(short* output, unsigned frames) {
+
+    OMI_PROFILE_SCOPE("SoftwareMixer::render");
+
+    static const unsigned blockCounter =
+        counters::get("audio.mix_blocks", counters::PER_FRAME);
+    static const unsigned voiceCounter =
+        counters::get("audio.mix_voices", counters::GAUGE);
+
+    m_accumulator.assign(frames * CHANNELS, 0.0f);
+
+    // mix up to each queued change, apply it, then carry on
+    unsigned mixedVoices = 0;
+    unsigned done = 0;
+    while (done < frames) {
+
+        unsigned long long now = m_mixed + done;
+        unsigned long long next = m_mixed + frames;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (!m_commands.empty() &&
+                   m_commands.front().state.stamp <= now) {
+
+                apply(m_commands.front());
+                m_commands.pop_front();
+            }
+            if (!m_commands.empty()) {
+
+                next = std::min(next, m_commands.front().state.stamp);
+            }
+        }
+
+        unsigned count = static_cast<unsigned>(next - now);
+        float* accumulator = &m_accumulator[done * CHANNELS];
+        mixedVoices = 0;
+        for (std::vector<Source>::iterator it = m_mixVoices.begin();
+             it != m_mixVoices.end(); ++it) {
+
+            if (mixSource(*it, accumulator, count)) {
+
+                ++mixedVoices;
+            }
+        }
+        for (std::map<unsigned, Source>::iterator it = m_mixStreams.begin();
+             it != m_mixStreams.end(); ++it) {
+
+            if (mixSource(it->second, accumulator, count)) {
+
+                ++mixedVoices;
+            }
+        }
+        done += count;
+    }
+    m_mixed += frames;
+
+    // convert to 16 bit, clipping anything too loud
+    for (unsigned i = 0; i < frames * CHANNELS; ++i) {
+
+        float sample =
+            std::max(-32768.0f, std::min(32767.0f, m_accumulator[i]));
+        output[i] = static_cast<short>(sample);
+    }
+
+    counters::add(blockCounter);
+    counters::set(voiceCounter, mixedVoices);
+}
+
+unsigned SoftwareMixer::loadSamples(
+        const short*   samples,
+              unsigned frames,
+              unsigned channels,
+              unsigned sampleRate) {
+
+    t_Samples converted = convert(samples, frames, channels, sampleRate);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned handle = m_nextHandle++;
+    m_sounds[handle] = converted;
+    return handle;
+}
+
+unsigned SoftwareMixer::loadSound(const std::string& filePath) {
+
+    t_Samples samples = decode(filePath);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned handle = m_nextHandle++;
+    m_sounds[handle] = samples;
+    return handle;
+}
+
+void SoftwareMixer::releaseSound(unsigned sound) {
+
+    // voices that are still being mixed keep their own reference to the samples
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sounds.erase(sound);
+}
+
+unsigned SoftwareMixer::getSoundBytes(unsigned sound) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // sounds that failed to decode have no samples
+    std::map<unsigned, t_Samples>::const_iterator samples =
+        m_sounds.find(sound);
+    if (samples == m_sounds.end() || !samples->second) {
+
+        return 0;
+    }
+    return static_cast<unsigned>(samples->second->size() * sizeof(short));
+}
+
+void SoftwareMixer::setVoiceCount(unsigned count) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_voices.assign(count, Source());
+    send(VOICE_COUNT, count, Source());
+}
+
+void SoftwareMixer::playVoice(
+        unsigned voice, unsigned sound, bool loop, float volume) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_voices[voice];
+
+    // an unknown sound plays as silence
+    std::map<unsigned, t_Samples>::const_iterator samples =
+        m_sounds.find(sound);
+    source.samples  = samples != m_sounds.end() ? samples->second :
+                                                  t_Samples();
+    source.playing  = true;
+    source.loop     = loop;
+    source.volume   = volume;
+    source.position = 0;
+    source.stamp    = m_target;
+    send(VOICE, voice, source);
+}
+
+void SoftwareMixer::stopVoice(unsigned voice) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_voices[voice];
+    rebase(source);
+    source.playing = false;
+    send(VOICE, voice, source);
+}
+
+bool SoftwareMixer::isVoicePlaying(unsigned voice) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return isPlaying(m_voices[voice]);
+}
+
+unsigned SoftwareMixer::openStream(const std::string& filePath) {
+
+    // streams are small enough in this game to decode up front
+    t_Samples samples = decode(filePath);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned handle = m_nextHandle++;
+    Source& source = m_streams[handle];
+    source.samples = samples;
+    source.stamp   = m_target;
+    send(STREAM, handle, source);
+    return handle;
+}
+
+void SoftwareMixer::closeStream(unsigned stream) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_streams.erase(stream);
+    send(CLOSE_STREAM, stream, Source());
+}
+
+void SoftwareMixer::playStream(unsigned stream) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_streams[stream];
+    rebase(source);
+    if (!source.paused) {
+
+        source.position = 0;
+    }
+    source.playing = true;
+    source.paused  = false;
+    send(STREAM, stream, source);
+}
+
+void SoftwareMixer::pauseStream(unsigned stream) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_streams[stream];
+    rebase(source);
+    if (source.playing) {
+
+        source.playing = false;
+        source.paused  = true;
+        send(STREAM, stream, source);
+    }
+}
+
+void SoftwareMixer::stopStream(unsigned stream) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_streams[stream];
+    rebase(source);
+    source.playing  = false;
+    source.paused   = false;
+    source.position = 0;
+    send(STREAM, stream, source);
+}
+
+void SoftwareMixer::setStreamVolume(unsigned stream, float volume) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_streams[stream];
+    if (source.volume == volume) {
+
+        return;
+    }
+    rebase(source);
+    source.volume = volume;
+    send(STREAM, stream, source);
+}
+
+void SoftwareMixer::setStreamLoop(unsigned stream, bool loop) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Source& source = m_streams[stream];
+    if (source.loop == loop) {
+
+        return;
+    }
+    rebase(source);
+    source.loop = loop;
+    send(STREAM, stream, source);
+}
+
+bool SoftwareMixer::isStreamStopped(unsigned stream) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Source& source = m_streams[stream];
+    return !source.paused && !isPlaying(source);
+}
+
+void SoftwareMixer::advance(float milliseconds) {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_time += milliseconds;
+        m_target = static_cast<unsigned long long>(
+            (m_time * SAMPLE_RATE) / 1000.0);
+    }
+    m_wake.notify_one();
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void SoftwareMixer::run() {
+
+    std::vector<short> block(BLOCK_FRAMES * CHANNELS);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+
+        while (!m_quit && m_mixed >= m_target) {
+
+            m_wake.wait(lock);
+        }
+        if (m_mixed >= m_target) {
+
+            break;
+        }
+
+        unsigned frames = static_cast<unsigned>(
+            std::min<unsigned long long>(BLOCK_FRAMES, m_target - m_mixed));
+
+        // mix without holding the lock so the game isn't blocked
+        lock.unlock();
+        render(&block[0], frames);
+        if (m_output.is_open()) {
+
+            m_output.write(reinterpret_cast<const char*>(&block[0]),
+                frames * CHANNELS * sizeof(short));
+            m_written += frames;
+        }
+        lock.lock();
+    }
+}
+
+SoftwareMixer::t_Samples SoftwareMixer::decode(const std::string& filePath) {
+
+    OMI_PROFILE_SCOPE("SoftwareMixer::decode");
+
+    sf::SoundBuffer buffer;
+    if (!buffer.loadFromFile(filePath.c_str()) ||
+        buffer.getChannelCount() == 0) {
+
+        std::cout << "SOFTWARE MIXER: unable to load " << filePath << std::endl;
+        return t_Samples(new std::vector<short>());
+    }
+
+    return convert(
+        buffer.getSamples(),
+        static_cast<unsigned>(
+            buffer.getSampleCount() / buffer.getChannelCount()),
+        buffer.getChannelCount(),
+        buffer.getSampleRate()
+    );
+}
+
+SoftwareMixer::t_Samples SoftwareMixer::convert(
+        const short*   samples,
+              unsigned frames,
+              unsigned channels,
+              unsigned sampleRate) const {
+
+    std::vector<short>* converted = new std::vector<short>();
+    if (frames == 0 || channels == 0 || sampleRate == 0) {
+
+        return t_Samples(converted);
+    }
+
+    // resample with linear interpolation, mono is copied to both channels and
+    // any channels past the first two are ignored
+    unsigned long long outFrames =
+        (static_cast<unsigned long long>(frames) * SAMPLE_RATE) / sampleRate;
+    converted->resize(outFrames * CHANNELS);
+    double step = static_cast<double>(sampleRate) / SAMPLE_RATE;
+    for (unsigned long long i = 0; i < outFrames; ++i) {
+
+        double position = i * step;
+        unsigned index = static_cast<unsigned>(position);
+        float fraction = static_cast<float>(position - index);
+        unsigned nextIndex = std::min(index + 1, frames - 1);
+        for (unsigned c = 0; c < CHANNELS; ++c) {
+
+            unsigned channel = std::min(c, channels - 1);
+            float a = samples[(index * channels) + channel];
+            float b = samples[(nextIndex * channels) + channel];
+            (*converted)[(i * CHANNELS) + c] =
+                static_cast<short>(a + ((b - a) * fraction));
+        }
+    }
+
+    return t_Samples(converted);
+}
+
+unsigned long long SoftwareMixer::currentPosition(const Source& source) const {
+
+    if (!source.playing || !source.samples) {
+
+        return source.position;
+    }
+
+    unsigned long long length = source.samples->size() / CHANNELS;
+    unsigned long long position = source.position + (m_target - source.stamp);
+    if (source.loop && length > 0) {
+
+        return position % length;
+    }
+    return std::min(position, length);
+}
+
+bool SoftwareMixer::isPlaying(const Source& source) const {
+
+    if (!source.playing || !source.samples) {
+
+        return false;
+    }
+    if (source.loop) {
+
+        return true;
+    }
+    return currentPosition(source) < source.samples->size() / CHANNELS;
+}
+
+void SoftwareMixer::rebase(Source& source) const {
+
+    bool playing = isPlaying(source);
+    source.position = currentPosition(source);
+    source.playing = playing;
+    source.stamp = m_target;
+}
+
+void SoftwareMixer::send(
+        CommandType   type,
+        unsigned      index,
+        const Source& state) {
+
+    Command command;
+    command.type = type;
+    command.index = index;
+    command.state = state;
+    command.state.stamp = m_target;
+    m_commands.push_back(command);
+}
+
+void SoftwareMixer::apply(const Command& command) {
+
+    switch (command.type) {
+
+        case VOICE_COUNT: {
+
+            m_mixVoices.assign(command.index, Source());
+            break;
+        }
+        case VOICE: {
+
+            if (command.index < m_mixVoices.size()) {
+
+                m_mixVoices[command.index] = command.state;
+            }
+            break;
+        }
+        case STREAM: {
+
+            m_mixStreams[command.index] = command.state;
+            break;
+        }
+        case CLOSE_STREAM: {
+
+            m_mixStreams.erase(command.index);
+            break;
+        }
+    }
+}
+
+bool SoftwareMixer::mixSource(
+        Source&  source,
+        float*   accumulator,
+        unsigned frames) {
+
+    if (!source.playing || !source.samples) {
+
+        return false;
+    }
+
+    const std::vector<short>& samples = *source.samples;
+    unsigned long long length = samples.size() / CHANNELS;
+    unsigned done = 0;
+    while (done < frames && source.playing) {
+
+        if (source.position >= length) {
+
+            if (source.loop && length > 0) {
+
+                source.position = 0;
+            }
+            else {
+
+                source.playing = false;
+                break;
+            }
+        }
+
+        unsigned count = static_cast<unsigned>(std::min<unsigned long long>(
+            frames - done, length - source.position));
+        const short* in = &samples[source.position * CHANNELS];
+        float* out = accumulator + (done * CHANNELS);
+        for (unsigned i = 0; i < count * CHANNELS; ++i) {
+
+            out[i] += in[i] * source.volume;
+        }
+        source.position += count;
+        done += count;
+    }
+
+    return true;
+}
+
+void SoftwareMixer::writeHeader() {
+
+    unsigned dataBytes = static_cast<unsigned>(
+        m_written * CHANNELS * sizeof(short));
+
+    m_output.seekp(0);
+    m_output.write("RIFF", 4);
+    writeLittleEndian(m_output, 36 + dataBytes, 4);
+    m_output.write("WAVE", 4);
+
+    // format chunk, uncompressed 16 bit samples
+    m_output.write("fmt ", 4);
+    writeLittleEndian(m_output, 16, 4);
+    writeLittleEndian(m_output, 1, 2);
+    writeLittleEndian(m_output, CHANNELS, 2);
+    writeLittleEndian(m_output, SAMPLE_RATE, 4);
+    writeLittleEndian(m_output, SAMPLE_RATE * CHANNELS * sizeof(short), 4);
+    writeLittleEndian(m_output, CHANNELS * sizeof(short), 2);
+    writeLittleEndian(m_output, 16, 2);
+
+    m_output.write("data", 4);
+    writeLittleEndian(m_output, dataBytes, 4);
+    m_output.seekp(0, std::ios::end);
+}
+
+} // namespace omi
\ No newline at end of file
@@ -0,0 +1,295 @@
+#ifndef OMICRON_AUDIO_SOFTWAREMIXER_H_
+#   define OMICRON_AUDIO_SOFTWAREMIXER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/omicron/audio/AudioBackend.hpp"
+
+namespace omi {
+
+/******************************************************************************\
+| Mixes audio in process instead of playing it on a device, so audio can run   |
+| and be measured on machines with no sound hardware.                          |
+|                                                                              |
+| Sounds and streams are decoded and resampled to the mixer's format when they |
+| are loaded. All playing voices are mixed in blocks on a dedicated thread and |
+| the result is written to a WAV file or discarded.                            |
+|                                                                              |
+| The mixer is clocked by advance rather than real time and every change is    |
+| applied at the exact sample it was made at, so the same sequence of calls    |
+| always produces the same output.                                             |
+\******************************************************************************/
+class SoftwareMixer : public AudioBackend {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
+
+    //! the number of sample frames per second of output
+    static const unsigned SAMPLE_RATE = 44100;
+    //! the number of channels of output
+    static const unsigned CHANNELS = 2;
+    //! the largest number of sample frames mixed at once
+    static const unsigned BLOCK_FRAMES = 512;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new software mixer, mixing does not begin until start is
+    called
+    @param outputPath the WAV file to write the mix to, or empty to discard
+                      the mix */
+    SoftwareMixer(const std::string& outputPath);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~SoftwareMixer();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Starts the mixing thread */
+    void start();
+
+    /** Mixes all audio up to the current time, stops the mixing thread, and
+    completes the output file */
+    void finish();
+
+    /** Mixes the next sample frames. This is called by the mixing thread and
+    should only be called directly when the thread has not been started.
+    @param output returns the interleaved 16 bit samples, this must have room
+                  for frames * CHANNELS samples
+    @param frames the number of sample frames to mix */
+    void render(short* output, unsigned frames);
+
+    /** Adds a sound from samples that have already been decoded
+    @param samples the interleaved 16 bit samples of the sound
+    @param frames the number of sample frames
+    @param channels the number of channels of the samples
+    @param sampleRate the sample rate of the samples
+    @return the handle of the sound */
+    unsigned loadSamples(
+            const short*   samples,
+                  unsigned frames,
+                  unsigned channels,
+                  unsigned sampleRate);
+
+    /** #Override */
+    unsigned loadSound(const std::string& filePath);
+
+    /** #Override */
+    void releaseSound(unsigned sound);
+
+    /** #Override */
+    unsigned getSoundBytes(unsigned sound);
+
+    /** #Override */
+    void setVoiceCount(unsigned count);
+
+    /** #Override */
+    void playVoice(unsigned voice, unsigned sound, bool loop, float volume);
+
+    /** #Override */
+    void stopVoice(unsigned voice);
+
+    /** #Override */
+    bool isVoicePlaying(unsigned voice);
+
+    /** #Override */
+    unsigned openStream(const std::string& filePath);
+
+    /** #Override */
+    void closeStream(unsigned stream);
+
+    /** #Override */
+    void playStream(unsigned stream);
+
+    /** #Override */
+    void pauseStream(unsigned stream);
+
+    /** #Override */
+    void stopStream(unsigned stream);
+
+    /** #Override */
+    void setStreamVolume(unsigned stream, float volume);
+
+    /** #Override */
+    void setStreamLoop(unsigned stream, bool loop);
+
+    /** #Override */
+    bool isStreamStopped(unsigned stream);
+
+    /** #Override */
+    void advance(float milliseconds);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                   TYPES
+    //--------------------------------------------------------------------------
+
+    // the samples of a sound in the mixer's format
+    typedef std::shared_ptr<const std::vector<short>> t_Samples;
+
+    //--------------------------------------------------------------------------
+    //                                ENUMERATORS
+    //--------------------------------------------------------------------------
+
+    // the kinds of changes sent to the mixing thread
+    enum CommandType {
+
+        VOICE_COUNT,
+        VOICE,
+        STREAM,
+        CLOSE_STREAM
+    };
+
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    // the state of a voice or stream
+    struct Source {
+
+        // the samples being played, null if nothing has been played
+        t_Samples samples;
+        // if the source is playing
+        bool playing;
+        // if the source is paused, only used by streams
+        bool paused;
+        // if the source loops
+        bool loop;
+        // the volume of the source
+        float volume;
+        // the position in the samples in frames at the time of the stamp
+        unsigned long long position;
+        // the frame of output the state begins at
+        unsigned long long stamp;
+
+        Source() :
+            playing (false),
+            paused  (false),
+            loop    (false),
+            volume  (1.0f),
+            position(0),
+            stamp   (0) {
+        }
+    };
+
+    // a change to be applied by the mixing thread
+    struct Command {
+
+        // the kind of change
+        CommandType type;
+        // the voice or stream changed, or the number of voices
+        unsigned index;
+        // the new state of the voice or stream
+        Source state;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // guards everything shared between the game and the mixing thread
+    std::mutex m_mutex;
+    // wakes the mixing thread when there is more to mix
+    std::condition_variable m_wake;
+    // the mixing thread
+    std::thread m_thread;
+    // if the mixing thread is running
+    bool m_running;
+    // if the mixing thread should stop once it has caught up
+    bool m_quit;
+
+    // the total time the mixer has been advanced by in milliseconds
+    double m_time;
+    // the number of frames that should have been mixed by now
+    unsigned long long m_target;
+    // changes waiting to be applied by the mixing thread, oldest first
+    std::deque<Command> m_commands;
+
+    // the loaded sounds
+    std::map<unsigned, t_Samples> m_sounds;
+    // the state of each voice as seen by the game
+    std::vector<Source> m_voices;
+    // the state of each stream as seen by the game
+    std::map<unsigned, Source> m_streams;
+    // the next handle to give to a sound or stream
+    unsigned m_nextHandle;
+
+    // the state of each voice and stream as seen by the mixing thread
+    std::vector<Source> m_mixVoices;
+    std::map<unsigned, Source> m_mixStreams;
+    // the number of frames that have been mixed
+    unsigned long long m_mixed;
+    // the mix before it is converted to 16 bit samples
+    std::vector<float> m_accumulator;
+
+    // the WAV file being written to
+    std::ofstream m_output;
+    // the number of frames written to the output
+    unsigned long long m_written;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** The main function of the mixing thread */
+    void run();
+
+    /** Decodes an audio file into the mixer's format
+    @param filePath the location of the audio
+    @return the samples of the audio */
+    t_Samples decode(const std::string& filePath);
+
+    /** Converts samples into the mixer's format
+    @return the converted samples */
+    t_Samples convert(
+            const short*   samples,
+                  unsigned frames,
+                  unsigned channels,
+                  unsigned sampleRate) const;
+
+    /** @return the position of the source at the current time */
+    unsigned long long currentPosition(const Source& source) const;
+
+    /** @return if the source is playing at the current time */
+    bool isPlaying(const Source& source) const;
+
+    /** Moves the source's position to the current time so it can be
+    changed */
+    void rebase(Source& source) const;
+
+    /** Queues a change for the mixing thread */
+    void send(CommandType type, unsigned index, const Source& state);
+
+    /** Applies a change on the mixing thread */
+    void apply(const Command& command);
+
+    /** Adds a source into the mix
+    @param source the source to mix
+    @param accumulator the mix to add to
+    @param frames the number of frames to mix
+    @return if the source was playing */
+    static bool mixSource(Source& source, float* accumulator, unsigned frames);
+
+    /** Writes the header of the WAV file for the frames written so far */
+    void writeHeader();
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
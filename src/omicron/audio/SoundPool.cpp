@@ -1,5 +1,9 @@
 #include "SoundPool.hpp"
 
+#include <algorithm>
+
+#include "src/omicron/debug/Counters.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
@@ -7,20 +11,31 @@ namespace omi {
 //------------------------------------------------------------------------------
 
 std::map<unsigned, SoundPool::SoundBank> SoundPool::m_pool;
+std::vector<SoundPool::Voice> SoundPool::m_voices;
+std::vector<SoundPool::Request> SoundPool::m_requests;
 unsigned SoundPool::m_currentId = 0;
+unsigned SoundPool::m_currentTicket = 0;
+std::mutex SoundPool::m_mutex;
 
 //------------------------------------------------------------------------------
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
-unsigned SoundPool::load(const std::string& filePath, unsigned instances) {
+unsigned SoundPool::load(
+        const std::string& filePath,
+              unsigned     instances,
+              unsigned     priority) {
 
-    // create the bank at the next available id
-    m_pool.insert(std::make_pair(
-        m_currentId,
-        SoundBank(filePath, instances)
-        )
-    );
+    // create the bank at the next available id, the sound is never loaded if
+    // there is no audio
+    if (audio::getBackend() != NULL) {
+
+        m_pool.insert(std::make_pair(
+            m_currentId,
+            SoundBank(filePath, instances, priority)
+            )
+        );
+    }
 
     // increment id
     unsigned rId = m_currentId;
@@ -31,23 +46,271 @@ unsigned SoundPool::load(const std::string& filePath, unsigned instances) {
 
 void SoundPool::release(unsigned id) {
 
-    m_pool.erase(m_pool.find(id));
+    AudioBackend* backend = audio::getBackend();
+    if (backend == NULL) {
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<unsigned, SoundBank>::iterator bank = m_pool.find(id);
+    if (bank == m_pool.end()) {
+
+        return;
+    }
+
+    // the voices can't outlive the sound they are playing
+    for (unsigned i = 0; i < m_voices.size(); ++i) {
+
+        if (m_voices[i].id == id) {
+
+            backend->stopVoice(i);
+            m_voices[i].id = NO_SOUND;
+        }
+    }
+
+    // nor can requests for it be played
+    for (std::vector<Request>::iterator it = m_requests.begin();
+         it != m_requests.end();) {
+
+        if (it->id == id) {
+
+            it = m_requests.erase(it);
+        }
+        else {
+
+            ++it;
+        }
+    }
+
+    backend->releaseSound(bank->second.m_sound);
+    m_pool.erase(bank);
+}
+
+unsigned SoundPool::getBytes(unsigned id) {
+
+    AudioBackend* backend = audio::getBackend();
+    if (backend == NULL) {
+
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<unsigned, SoundBank>::iterator bank = m_pool.find(id);
+    if (bank == m_pool.end()) {
+
+        return 0;
+    }
+    return backend->getSoundBytes(bank->second.m_sound);
+}
+
+void SoundPool::update() {
+
+    static const unsigned soundCounter =
+        counters::get("audio.sounds_started", counters::PER_FRAME);
+    static const unsigned usedCounter =
+        counters::get("audio.voices_used", counters::GAUGE);
+    static const unsigned droppedCounter =
+        counters::get("audio.voices_dropped", counters::PER_FRAME);
+
+    AudioBackend* backend = audio::getBackend();
+    if (backend == NULL) {
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // create the voices the first time they are needed or again if the budget
+    // has changed, stopping anything that was playing
+    if (m_voices.size() != audioSettings.getVoiceCount()) {
+
+        backend->setVoiceCount(audioSettings.getVoiceCount());
+        Voice voice;
+        voice.id = NO_SOUND;
+        voice.priority = 0;
+        voice.ticket = 0;
+        m_voices.assign(audioSettings.getVoiceCount(), voice);
+    }
+
+    // requests for sounds that aren't loaded can't be played
+    m_requests.erase(
+        std::remove_if(m_requests.begin(), m_requests.end(),
+            [](const Request& request) {
+
+                return m_pool.find(request.id) == m_pool.end();
+            }
+        ),
+        m_requests.end()
+    );
+
+    // give voices to the highest priority requests first
+    std::stable_sort(m_requests.begin(), m_requests.end(),
+        [](const Request& a, const Request& b) {
+
+            return m_pool.find(a.id)->second.m_priority >
+                   m_pool.find(b.id)->second.m_priority;
+        }
+    );
+
+    for (std::vector<Request>::iterator it = m_requests.begin();
+         it != m_requests.end(); ++it) {
+
+        const SoundBank& bank = m_pool.find(it->id)->second;
+        unsigned voice = findVoice(backend, bank, it->id);
+        if (voice == NO_SOUND) {
+
+            counters::add(droppedCounter);
+            continue;
+        }
+
+        backend->playVoice(voice, bank.m_sound, it->loop,
+            audioSettings.getSoundVolume() * it->volume);
+        m_voices[voice].id = it->id;
+        m_voices[voice].priority = bank.m_priority;
+        m_voices[voice].ticket = it->ticket;
+        counters::add(soundCounter);
+    }
+    m_requests.clear();
+
+    unsigned used = 0;
+    for (unsigned i = 0; i < m_voices.size(); ++i) {
+
+        if (backend->isVoicePlaying(i)) {
+
+            ++used;
+        }
+    }
+    counters::set(usedCounter, used);
 }
 
 unsigned SoundPool::play(unsigned id, bool loop, float volume) {
 
-    // don't play if sounds are disabled
-    if (audioSettings.isSoundDisabled()) {
+    // don't play if sounds are disabled or there is no audio
+    if (audioSettings.isSoundDisabled() || audio::getBackend() == NULL) {
+
+        return NO_TICKET;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_pool.find(id) == m_pool.end()) {
+
+        std::cout << "SOUND POOL: unable to find sound " << id << std::endl;
+        return NO_TICKET;
+    }
+
+    // merge with a request for the same sound this cycle
+    for (std::vector<Request>::iterator it = m_requests.begin();
+         it != m_requests.end(); ++it) {
+
+        if (it->id == id && it->loop == loop) {
 
-        return -1;
+            it->volume = std::min(it->volume + volume, 1.0f);
+            return it->ticket;
+        }
     }
 
-    return m_pool[id].playNext(loop, volume);
+    Request request = { id, loop, volume, m_currentTicket };
+    m_requests.push_back(request);
+    // skip the value used for no ticket when wrapping
+    m_currentTicket = (m_currentTicket + 1) % NO_TICKET;
+
+    return request.ticket;
 }
 
 void SoundPool::stop(unsigned id, unsigned instance) {
 
-    m_pool[id].stop(instance);
+    AudioBackend* backend = audio::getBackend();
+    if (backend == NULL) {
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the sound may not have been given a voice yet
+    for (std::vector<Request>::iterator it = m_requests.begin();
+         it != m_requests.end(); ++it) {
+
+        if (it->id == id && it->ticket == instance) {
+
+            m_requests.erase(it);
+            return;
+        }
+    }
+
+    for (unsigned i = 0; i < m_voices.size(); ++i) {
+
+        if (m_voices[i].id == id && m_voices[i].ticket == instance) {
+
+            backend->stopVoice(i);
+            return;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+unsigned SoundPool::findVoice(
+              AudioBackend* backend,
+        const SoundBank&    bank,
+              unsigned      id) {
+
+    // find the voices playing this sound, any free voice, and the voice that
+    // would be stolen, the oldest of the lowest priority
+    unsigned free = NO_SOUND;
+    unsigned oldestOwn = NO_SOUND;
+    unsigned steal = NO_SOUND;
+    unsigned own = 0;
+    for (unsigned i = 0; i < m_voices.size(); ++i) {
+
+        if (!backend->isVoicePlaying(i)) {
+
+            if (free == NO_SOUND) {
+
+                free = i;
+            }
+            continue;
+        }
+
+        const Voice& voice = m_voices[i];
+        if (voice.id == id) {
+
+            ++own;
+            if (oldestOwn == NO_SOUND ||
+                voice.ticket < m_voices[oldestOwn].ticket) {
+
+                oldestOwn = i;
+            }
+        }
+        if (steal == NO_SOUND || voice.priority < m_voices[steal].priority ||
+            (voice.priority == m_voices[steal].priority &&
+             voice.ticket < m_voices[steal].ticket)) {
+
+            steal = i;
+        }
+    }
+
+    // the sound is already using as many voices as it may
+    if (own >= bank.m_maxVoices && oldestOwn != NO_SOUND) {
+
+        return oldestOwn;
+    }
+    if (free != NO_SOUND) {
+
+        return free;
+    }
+    // only voices of the same or lower priority can be stolen
+    if (steal != NO_SOUND && m_voices[steal].priority <= bank.m_priority) {
+
+        return steal;
+    }
+    return NO_SOUND;
 }
 
-} // namespace omi
+} // namespace omi
\ No newline at end of file
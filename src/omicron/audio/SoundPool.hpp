@@ -3,16 +3,23 @@
 
 #include <iostream>
 #include <map>
-#include <SFML/Audio.hpp>
+#include <mutex>
 #include <vector>
 
 #include "src/omicron/Omicron.hpp"
+#include "src/omicron/audio/Audio.hpp"
 
 namespace omi {
 
-/*************************************************************\
-| Static object that manages storing of and access to sounds. |
-\*************************************************************/
+/******************************************************************************\
+| Static object that manages storing of and access to sounds.                  |
+|                                                                              |
+| Sounds share a fixed number of voices set by the audio settings. Requests to |
+| play a sound are queued and given voices once per logic cycle, requests for  |
+| the same sound in the same cycle are merged into a single louder voice. When |
+| every voice is busy the oldest voice of the lowest priority is stolen, if    |
+| all voices have a higher priority than the request it is dropped.            |
+\******************************************************************************/
 class SoundPool {
 private:
 
@@ -22,10 +29,9 @@ private:
 
     DISALLOW_CONSTRUCTION(SoundPool);
 
-    /**************************************************************************\
-    | Stores a set of instances of sounds and manages which instance should be |
-    | distributed next.                                                        |
-    \**************************************************************************/
+    /************************************************************\
+    | The data of a loaded sound and how it may be given voices. |
+    \************************************************************/
     struct SoundBank {
     public:
 
@@ -34,88 +40,81 @@ private:
         //----------------------------------------------------------------------
 
         /** Creates an empty sound bank */
-        SoundBank() {
+        SoundBank() :
+            m_sound    (0),
+            m_maxVoices(0),
+            m_priority (0) {
         }
 
         /** Creates a new bank of loaded sounds
         @param filePath the location of the sound
-        @param instances the number of instances of the sound in the bank */
-        SoundBank(const std::string& filePath, unsigned instances) :
-            m_instance   (0),
-            m_numInstance(instances) {
-
-            // load the data into the buffer
-            if (!m_buffer.loadFromFile(filePath.c_str())) {
-
-                std::cout << "loading sound failed" << std::endl;
-            }
-
-            // load the given number of instances of the sound
-            for (unsigned i = 0; i < m_numInstance; ++i) {
-
-                m_bank.push_back(sf::Sound());
-                // m_bank[i].setBuffer(m_buffer);
-            }
+        @param maxVoices the number of voices that may play the sound at once
+        @param priority the priority of the sound when voices are stolen */
+        SoundBank(
+                const std::string& filePath,
+                      unsigned     maxVoices,
+                      unsigned     priority) :
+            m_sound    (audio::getBackend()->loadSound(filePath)),
+            m_maxVoices(maxVoices),
+            m_priority (priority) {
         }
 
         //----------------------------------------------------------------------
-        //                               DESTRUCTOR
+        //                               VARIABLES
         //----------------------------------------------------------------------
 
-        ~SoundBank() {
-
-            // TODO: unload the sound
-        }
-
-        //----------------------------------------------------------------------
-        //                        PUBLIC MEMBER FUNCTIONS
-        //----------------------------------------------------------------------
+        // the backend's handle of the sound
+        unsigned m_sound;
+        // the number of voices that may play the sound at once
+        unsigned m_maxVoices;
+        // the priority of the sound
+        unsigned m_priority;
+    };
 
-        /** Plays the next instance of the sound
-        @param loop whether the sound should loop or not
-        @param volume the volume to play the sound at 
-        @return the instance of the sound being played */
-        inline unsigned playNext(bool loop, float volume) {
-
-            // TODO: figure out why the buffer can't be set in the constructor
-            m_bank[m_instance].setBuffer(m_buffer);
-            // play current instance
-            m_bank[m_instance].setLoop(loop);
-            m_bank[m_instance].setVolume(
-                (audioSettings.getSoundVolume() * volume) * 100.0f);
-            m_bank[m_instance].play();
-
-            // increment instance
-            unsigned rInstance = m_instance;
-            m_instance = (m_instance + 1) % m_numInstance;
-
-            return rInstance;
-        }
+    /*************************************************\
+    | A single channel that a sound can be played on. |
+    \*************************************************/
+    struct Voice {
+
+        // the id of the sound being played
+        unsigned id;
+        // the priority of the sound being played
+        unsigned priority;
+        // the ticket of the request that started the voice, this increases
+        // with each request so it also gives the age of the voice
+        unsigned ticket;
+    };
 
-        /** Stops the given instance of the sound
-        @param instance the instance to stop */
-        inline void stop(unsigned instance) {
+    /***********************************************\
+    | A request to play a sound at the next update. |
+    \***********************************************/
+    struct Request {
+
+        // the id of the sound to play
+        unsigned id;
+        // whether the sound should loop
+        bool loop;
+        // the volume to play the sound at
+        float volume;
+        // the ticket returned to the requester
+        unsigned ticket;
+    };
 
-            m_bank[m_instance].stop();
-        }
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
 
-    private:
+    // the id of a voice that is not playing any sound
+    static const unsigned NO_SOUND = static_cast<unsigned>(-1);
 
-        //----------------------------------------------------------------------
-        //                               VARIABLES
-        //----------------------------------------------------------------------
+public:
 
-        // the sound buffer
-        sf::SoundBuffer m_buffer;
-        // the list of instances of the sound
-        std::vector<sf::Sound> m_bank;
-        // the current instance to play
-        unsigned m_instance;
-        // the number of instances
-        unsigned m_numInstance;
-    };
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
 
-public:
+    //! the ticket returned when a sound will not be played
+    static const unsigned NO_TICKET = static_cast<unsigned>(-1);
 
     //--------------------------------------------------------------------------
     //                          PUBLIC MEMBER FUNCTIONS
@@ -124,26 +123,42 @@ public:
     /** #Hidden
     Adds a sound to the sound pool
     @param filePath the location of the sound to add
-    @param instances the number of instances of this sound that will be loaded
-           into the sound pool
+    @param instances the number of voices that may play this sound at once, if
+           a request would exceed this the oldest voice of the sound is reused
+    @param priority the priority of the sound, higher priority sounds may steal
+           the voices of lower priority sounds
     @return the id of the sound */
-    static unsigned load(const std::string& filePath, unsigned instances);
+    static unsigned load(
+            const std::string& filePath,
+                  unsigned     instances,
+                  unsigned     priority);
 
     /** #Hidden
     Removes a sound from the sound pool
     @param id the identifier of the sound to remove */
     static void release(unsigned id);
 
-    /** Plays a sound
+    /** @return the bytes of memory used by the samples of a sound, 0 if sounds
+    are disabled
+    @param id the identifier of the sound */
+    static unsigned getBytes(unsigned id);
+
+    /** #Hidden
+    Gives voices to the sounds requested since the last update. This should be
+    called once per logic cycle. */
+    static void update();
+
+    /** Requests a sound to be played at the next update. Requests for the same
+    sound within the same update are merged and their volumes added.
     @param id the identifier of the sound to play
     @param loop whether the sound should loop or not
     @param volume the volume to play the sound at
-    @return the instances of the sound playing */
+    @return the ticket of the request, or NO_TICKET if sounds are disabled */
     static unsigned play(unsigned id, bool loop, float volume);
 
     /** Stops a sound
     @param id the identifier of the sound to stop
-    @param instance the instance of the sound to stop */
+    @param instance the ticket returned when the sound was played */
     static void stop(unsigned id, unsigned instance);
 
 
@@ -155,11 +170,34 @@ private:
 
     // the pool of sounds
     static std::map<unsigned, SoundBank> m_pool;
+    // the voices shared by all sounds
+    static std::vector<Voice> m_voices;
+    // the requests to be played at the next update
+    static std::vector<Request> m_requests;
 
     // the next id to be assigned to a sound
     static unsigned m_currentId;
+    // the next ticket to be given to a request
+    static unsigned m_currentTicket;
+    // guards playing sounds since entities may be updated on several threads
+    static std::mutex m_mutex;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Finds the voice to play a request on
+    @param backend the audio backend
+    @param bank the sound bank of the request
+    @param id the id of the sound of the request
+    @return the index of the voice to use or NO_SOUND if the request should be
+            dropped */
+    static unsigned findVoice(
+                  AudioBackend* backend,
+            const SoundBank&    bank,
+                  unsigned      id);
 };
 
 } // namespace omi
 
-#endif
+#endif
\ No newline at end of file
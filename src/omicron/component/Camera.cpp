@@ -15,7 +15,10 @@ Camera::Camera(const std::string& id,
     m_transform(transform),
     m_fov      (60.0f),
     m_nearClip (0.001f),
-    m_farClip  (1000.0f) {
+    m_farClip  (1000.0f),
+    m_viewValid(false),
+    m_cachedAspect(0.0f),
+    m_projectionValid(false) {
 }
 
 Camera::Camera(const std::string& id,
@@ -28,7 +31,10 @@ Camera::Camera(const std::string& id,
     m_transform(transform),
     m_fov      (fov),
     m_nearClip (0.001f),
-    m_farClip  (1000.0f) {
+    m_farClip  (1000.0f),
+    m_viewValid(false),
+    m_cachedAspect(0.0f),
+    m_projectionValid(false) {
 }
 
 Camera::Camera(const std::string& id,
@@ -42,7 +48,10 @@ Camera::Camera(const std::string& id,
     m_transform(transform),
     m_fov      (60.0f),
     m_nearClip (nearClip),
-    m_farClip  (farClip) {
+    m_farClip  (farClip),
+    m_viewValid(false),
+    m_cachedAspect(0.0f),
+    m_projectionValid(false) {
 }
 
 Camera::Camera(const std::string& id,
@@ -57,7 +66,10 @@ Camera::Camera(const std::string& id,
     m_transform(transform),
     m_fov      (fov),
     m_nearClip (nearClip),
-    m_farClip  (farClip) {
+    m_farClip  (farClip),
+    m_viewValid(false),
+    m_cachedAspect(0.0f),
+    m_projectionValid(false) {
 }
 
 //------------------------------------------------------------------------------
@@ -76,40 +88,57 @@ component::Type Camera::getType() const {
     return component::CAMERA;
 }
 
-void Camera::apply() {
+const util::mat::Matrix4& Camera::getViewMatrix() const {
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-
-    if (m_mode == cam::PERSPECTIVE) {
+    util::vec::Vector3 translation(m_transform->computeTranslation());
+    util::vec::Vector3 rotation(m_transform->computeRotation());
+    util::vec::Vector3 scale(m_transform->computeScale());
 
-        // set up the projection matrix
-        gluPerspective(m_fov,
-            displaySettings.getSize().x / displaySettings.getSize().y,
-            m_nearClip, m_farClip);
+    if (!m_viewValid                       ||
+        translation != m_cachedTranslation ||
+        rotation    != m_cachedRotation    ||
+        scale       != m_cachedScale) {
+
+        // scale, then rotate around the x, y and z axes, then translate
+        m_view = util::mat::Matrix4::scale(scale);
+        m_view *= util::mat::Matrix4::rotationX(rotation.x);
+        m_view *= util::mat::Matrix4::rotationY(rotation.y);
+        m_view *= util::mat::Matrix4::rotationZ(rotation.z);
+        m_view *= util::mat::Matrix4::translation(translation);
+
+        m_cachedTranslation = translation;
+        m_cachedRotation    = rotation;
+        m_cachedScale       = scale;
+        m_viewValid = true;
     }
-    else {
 
-        // set up the orthographic matrix
-        float aspectRatio = 
-            displaySettings.getSize().x / displaySettings.getSize().y;
-        glOrtho(-aspectRatio, aspectRatio, -1.0f, 1.0f, m_nearClip, m_farClip);
+    return m_view;
+}
+
+const util::mat::Matrix4& Camera::getProjectionMatrix() const {
+
+    float aspectRatio =
+        displaySettings.getSize().x / displaySettings.getSize().y;
+
+    if (!m_projectionValid || aspectRatio != m_cachedAspect) {
+
+        if (m_mode == cam::PERSPECTIVE) {
+
+            m_projection = util::mat::Matrix4::perspective(
+                m_fov, aspectRatio, m_nearClip, m_farClip);
+        }
+        else {
+
+            m_projection = util::mat::Matrix4::orthographic(
+                -aspectRatio, aspectRatio, -1.0f, 1.0f,
+                m_nearClip, m_farClip);
+        }
+
+        m_cachedAspect = aspectRatio;
+        m_projectionValid = true;
     }
 
-    // set up the model view matrix
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    // scale
-    util::vec::Vector3 scale(m_transform->computeScale());
-    glScalef(scale.x, scale.y, scale.z);
-    //rotation
-    util::vec::Vector3 rotation(m_transform->computeRotation());
-    glRotatef(rotation.x, 1.0f, 0.0f, 0.0f);
-    glRotatef(rotation.y, 0.0f, 1.0f, 0.0f);
-    glRotatef(rotation.z, 0.0f, 0.0f, 1.0f);
-    // translation
-    util::vec::Vector3 translation = m_transform->computeTranslation();
-    glTranslatef(translation.x, translation.y, translation.z);
+    return m_projection;
 }
 
 cam::Mode Camera::getMode() const {
@@ -140,26 +169,31 @@ float Camera::getFarClippingPlane() const {
 void Camera::setMode(cam::Mode mode) {
 
     m_mode = mode;
+    m_projectionValid = false;
 }
 
 void Camera::setTransform(Transform* transform) {
 
     m_transform = transform;
+    m_viewValid = false;
 }
 
 void Camera::setFOV(float fov) {
 
     m_fov = fov;
+    m_projectionValid = false;
 }
 
 void Camera::setNearClip(float nearClip) {
 
     m_nearClip = nearClip;
+    m_projectionValid = false;
 }
 
 void Camera::setFarClip(float farClip) {
 
     m_farClip = farClip;
+    m_projectionValid = false;
 }
 
 } // namespace omi
\ No newline at end of file
@@ -90,9 +90,13 @@ public:
     /** #Override */
     component::Type getType() const;
 
-    /** #Hidden
-    Applies the effects of the camera to the render matrices */
-    void apply();
+    /** @return the matrix that transforms from world space into the space of
+    the camera, this is only recomputed when the camera's transform changes */
+    const util::mat::Matrix4& getViewMatrix() const;
+
+    /** @return the projection matrix of the camera, this is only recomputed
+    when the mode, clipping planes, field of view, or display size change */
+    const util::mat::Matrix4& getProjectionMatrix() const;
 
     /** @return the mode of the camera */
     cam::Mode getMode() const;
@@ -142,6 +146,22 @@ private:
     float m_nearClip;
     // the far clipping plane
     float m_farClip;
+
+    // the transform values the cached view matrix was built from
+    mutable util::vec::Vector3 m_cachedTranslation;
+    mutable util::vec::Vector3 m_cachedRotation;
+    mutable util::vec::Vector3 m_cachedScale;
+    // is false if the view matrix must be rebuilt regardless of the values
+    mutable bool m_viewValid;
+    // the cached view matrix
+    mutable util::mat::Matrix4 m_view;
+
+    // the aspect ratio the cached projection matrix was built with
+    mutable float m_cachedAspect;
+    // is false if the projection matrix must be rebuilt
+    mutable bool m_projectionValid;
+    // the cached projection matrix
+    mutable util::mat::Matrix4 m_projection;
 };
 
  } // namespace omi
@@ -1,7 +1,8 @@
 #ifndef OMICRON_COMPONENT_COMPONENT_H_
 #   define OMICRON_COMPONENT_COMPONENT_H_
 
-#include <sstream>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "lib/Utilitron/MacroUtil.hpp"
@@ -21,6 +22,80 @@ enum Type {
     COLLISION  = 32,  // a component used for collision detection
 };
 
+//! an interned integer identifier of a component
+typedef unsigned Key;
+//! the key of components that were not given an identifier
+static const Key ANONYMOUS = 0;
+
+//! a compile time identifier of a concrete component type
+typedef const void* TypeKey;
+
+/** #Hidden
+@return the table of interned component identifiers */
+inline std::map<std::string, Key>& internTable() {
+
+    static std::map<std::string, Key> keys;
+    return keys;
+}
+
+/** #Hidden
+@return the mutex guarding the intern table, components may be created by
+entities that are being updated on different threads */
+inline std::mutex& internMutex() {
+
+    static std::mutex mutex;
+    return mutex;
+}
+
+/** Interns the given component identifier as an integer key so that component
+lookups don't need to compare strings. The same string always maps to the same
+key.
+@param id the identifier to intern
+@return the key of the identifier, or ANONYMOUS if the identifier is empty */
+inline Key intern(const std::string& id) {
+
+    if (id.empty()) {
+
+        return ANONYMOUS;
+    }
+
+    std::lock_guard<std::mutex> lock(internMutex());
+    std::map<std::string, Key>& keys = internTable();
+    std::map<std::string, Key>::iterator it = keys.find(id);
+    if (it != keys.end()) {
+
+        return it->second;
+    }
+
+    Key key = static_cast<Key>(keys.size()) + 1;
+    keys.insert(std::make_pair(id, key));
+    return key;
+}
+
+/** Finds the key of an identifier without interning it
+@param id the identifier to find the key of
+@return the key of the identifier, or ANONYMOUS if it has never been interned */
+inline Key findKey(const std::string& id) {
+
+    std::lock_guard<std::mutex> lock(internMutex());
+    std::map<std::string, Key>& keys = internTable();
+    std::map<std::string, Key>::iterator it = keys.find(id);
+    if (it == keys.end()) {
+
+        return ANONYMOUS;
+    }
+
+    return it->second;
+}
+
+/** @return the unique key of the type T */
+template<typename T>
+inline TypeKey typeKey() {
+
+    static const char tag = 0;
+    return &tag;
+}
+
 } // namespace component
 
 /***********************************************************************\
@@ -40,12 +115,19 @@ public:
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    /** @return the identifier of the component */
+    /** @return the identifier of the component, this is empty if the
+    component is anonymous */
     const std::string& getId() const {
 
         return m_id;
     }
 
+    /** @return the interned key of the component's identifier */
+    component::Key getKey() const {
+
+        return m_key;
+    }
+
     /** @return the type of the component */
     virtual component::Type getType() const {
 
@@ -59,20 +141,15 @@ protected:
     //--------------------------------------------------------------------------
 
     /** Creates a new component
-    @param id the identifier of the component */
+    @param id the identifier of the component, if this is empty the component
+              is anonymous and can only be found by type */
     Component(const std::string& id) :
-        m_id(id) {
-
-            // if an id hasn't been defined just serialise the pointer of this
-            if (!m_id.length()) {
-
-                std::stringstream ss;
-                ss << this;
-                m_id = ss.str();
-            }
+        m_id (id),
+        m_key(component::intern(id)) {
     }
 
-    Component(const Component&) {
+    Component(const Component&) :
+        m_key(component::ANONYMOUS) {
     }
 
     //--------------------------------------------------------------------------
@@ -81,6 +158,8 @@ protected:
 
     // the identifier of the component which must be unique to the entity
     std::string m_id;
+    // the interned key of the identifier
+    component::Key m_key;
 };
 
 } // namespace omi
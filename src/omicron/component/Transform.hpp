@@ -1,6 +1,7 @@
 #ifndef OMICRON_COMPONENT_TRANSFORM_H_
 #   define OMICRON_COMPONENT_TRANSFORM_H_
 
+#include "lib/Utilitron/Matrix.hpp"
 #include "lib/Utilitron/Vector.hpp"
 
 #include "src/omicron/component/Component.hpp"
@@ -14,9 +15,11 @@ namespace omi {
 namespace axis_space {
 
 enum AxisSpace {
-    LOCAL,
-    PARENT,
-    GLOBAL
+    LOCAL,  // values are in the parent's space, so they are moved, rotated,
+            // and scaled along with the parent
+    PARENT, // values are offset from the parent's position but the parent's
+            // rotation and scale are not applied
+    GLOBAL  // values are absolute and the parent transform is ignored
 };
 
 } //namespace axis_space
@@ -25,6 +28,10 @@ enum AxisSpace {
 | A transform defines the translation, rotation, and position of an entity. |
 | There must always be exactly one transform component per entity and is    |
 | created by default under the id "transform".                              |
+|                                                                           |
+| A transform may be parented to another transform, in which case its       |
+| values are relative to the parent. The world matrix is cached and only    |
+| recomputed when the local values or a parent's world matrix has changed.  |
 \***************************************************************************/
 class Transform : public Component {
 public:
@@ -58,7 +65,12 @@ public:
         Component  (id),
         translation(t),
         rotation   (r),
-        scale      (s) {
+        scale      (s),
+        m_axisSpace(axisSpace),
+        m_parent   (NULL),
+        m_cacheValid(false),
+        m_version  (0),
+        m_parentVersion(0) {
     }
 
     /** Creates a new component by copying from another and providing a new
@@ -70,7 +82,12 @@ public:
         Component(id),
         translation(other.translation),
         rotation(other.rotation),
-        scale(other.scale) {
+        scale(other.scale),
+        m_axisSpace(other.m_axisSpace),
+        m_parent(other.m_parent),
+        m_cacheValid(false),
+        m_version(0),
+        m_parentVersion(0) {
     }
 
     //--------------------------------------------------------------------------
@@ -90,15 +107,53 @@ public:
         return m_axisSpace;
     }
 
+    /** Sets the axis space to use for computing this transform
+    @param axisSpace the new axis space */
+    void setAxisSpace(axis_space::AxisSpace axisSpace) {
+
+        m_axisSpace = axisSpace;
+        m_cacheValid = false;
+    }
+
+    /** @return the parent of this transform, or NULL if it has none */
+    Transform* getParent() const {
+
+        return m_parent;
+    }
+
+    /** Sets the parent of this transform. The transform's values will be
+    relative to the parent unless the axis space is global.
+    @param parent the new parent transform, or NULL to remove the parent */
+    void setParent(Transform* parent) {
+
+        m_parent = parent;
+        m_cacheValid = false;
+    }
+
+    /** @return the matrix that transforms from the local space of this
+    transform into world space */
+    const util::mat::Matrix4& getWorldMatrix() const {
+
+        updateWorldMatrix();
+
+        return m_world;
+    }
+
+    /** @return a number that changes every time the world matrix changes, so
+    that values derived from the world matrix can be cached */
+    unsigned getVersion() const {
+
+        updateWorldMatrix();
+
+        return m_version;
+    }
+
     /** Compute the translation values to be applied taking into regards the
     parent transform and the axis space.
     @return the computed translation */
     util::vec::Vector3 computeTranslation() const {
 
-        // TODO:
-        util::vec::Vector3 computed(translation);
-
-        return computed;
+        return getWorldMatrix().getTranslation();
     }
 
     /** Compute the rotation values to be applied taking into regards the
@@ -106,8 +161,11 @@ public:
     @return the computed rotation */
     util::vec::Vector3 computeRotation() const {
 
-        // TODO:
         util::vec::Vector3 computed(rotation);
+        if (hasActiveParent() && m_axisSpace == axis_space::LOCAL) {
+
+            computed += m_parent->computeRotation();
+        }
 
         return computed;
     }
@@ -117,10 +175,16 @@ public:
     @return the computed scale */
     util::vec::Vector3 computeScale() const {
 
-        // TODO:
         util::vec::Vector3 computed(scale);
+        if (hasActiveParent() && m_axisSpace == axis_space::LOCAL) {
+
+            util::vec::Vector3 parentScale(m_parent->computeScale());
+            computed.x *= parentScale.x;
+            computed.y *= parentScale.y;
+            computed.z *= parentScale.z;
+        }
 
-        return scale;
+        return computed;
     }
 
 private:
@@ -137,6 +201,77 @@ private:
 
     // the axis space to use
     axis_space::AxisSpace m_axisSpace;
+    // the parent transform
+    Transform* m_parent;
+
+    // the local values the cached matrices were built from
+    mutable util::vec::Vector3 m_cachedTranslation;
+    mutable util::vec::Vector3 m_cachedRotation;
+    mutable util::vec::Vector3 m_cachedScale;
+    // is false if the cache must be rebuilt regardless of the values
+    mutable bool m_cacheValid;
+    // the cached local and world matrices
+    mutable util::mat::Matrix4 m_local;
+    mutable util::mat::Matrix4 m_world;
+    // incremented every time the world matrix changes
+    mutable unsigned m_version;
+    // the version of the parent the world matrix was built from
+    mutable unsigned m_parentVersion;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return if the parent transform should be used */
+    bool hasActiveParent() const {
+
+        return m_parent != NULL && m_axisSpace != axis_space::GLOBAL;
+    }
+
+    /** Rebuilds the cached matrices if the local values or the parent's world
+    matrix have changed since they were last built */
+    void updateWorldMatrix() const {
+
+        bool localDirty = !m_cacheValid                     ||
+                          translation != m_cachedTranslation ||
+                          rotation    != m_cachedRotation    ||
+                          scale       != m_cachedScale;
+        if (localDirty) {
+
+            m_local = util::mat::Matrix4::compose(translation, rotation, scale);
+            m_cachedTranslation = translation;
+            m_cachedRotation    = rotation;
+            m_cachedScale       = scale;
+        }
+
+        unsigned parentVersion = 0;
+        if (hasActiveParent()) {
+
+            m_parent->updateWorldMatrix();
+            parentVersion = m_parent->m_version;
+        }
+
+        if (localDirty || parentVersion != m_parentVersion) {
+
+            if (hasActiveParent() && m_axisSpace == axis_space::PARENT) {
+
+                // only follow the parent's position
+                m_world = util::mat::Matrix4::translation(
+                    m_parent->m_world.getTranslation()) * m_local;
+            }
+            else if (hasActiveParent()) {
+
+                m_world = m_parent->m_world * m_local;
+            }
+            else {
+
+                m_world = m_local;
+            }
+            m_parentVersion = parentVersion;
+            m_cacheValid = true;
+            ++m_version;
+        }
+    }
 };
 
 } // namespace omi
@@ -12,7 +12,8 @@ CollisionDetector::CollisionDetector(
               void*      owner) :
     Physics(id),
     m_group(group),
-    m_owner(static_cast<Entity*>(owner)) {
+    m_owner(static_cast<Entity*>(owner)),
+    m_serial(0) {
 }
 
 CollisionDetector::CollisionDetector(
@@ -22,7 +23,8 @@ CollisionDetector::CollisionDetector(
               void*      owner) :
     Physics(id),
     m_group(group),
-    m_owner(static_cast<Entity*>(owner)) {
+    m_owner(static_cast<Entity*>(owner)),
+    m_serial(0) {
 
     // copy the boundings into a new vector of smart pointers
     for (std::vector<BoundingShape*>::const_iterator it = boundings.begin();
@@ -73,6 +75,16 @@ void CollisionDetector::clearData() {
     m_collisionData.clear();
 }
 
+unsigned CollisionDetector::getSerial() const {
+
+    return m_serial;
+}
+
+void CollisionDetector::setSerial(unsigned serial) {
+
+    m_serial = serial;
+}
+
 void CollisionDetector::detected(Entity* entity, const std::string& group) {
 
     CollisionData data;
@@ -92,6 +92,14 @@ public:
     Clears the collision data */
     void clearData();
 
+    /** #Hidden
+    @return the order this detector was added to collision detection in */
+    unsigned getSerial() const;
+
+    /** #Hidden
+    @param serial the order this detector was added to collision detection in */
+    void setSerial(unsigned serial);
+
     /** #Hidden
     Alerts this of a collision that has occurred with an entity from a group
     @param entity the entity the collision occured with
@@ -110,6 +118,8 @@ private:
     std::string m_group;
     // the list of collisions this frame
     std::vector<CollisionData> m_collisionData;
+    // the order this was added to collision detection in
+    unsigned m_serial;
 };
 
 } // namespace omi
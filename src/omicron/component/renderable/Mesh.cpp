@@ -6,11 +6,11 @@ namespace omi {
 //                                  CONSTRUCTOR
 //------------------------------------------------------------------------------
 
-Mesh::Mesh(const std::string& id,
-                 int          layer,
-                 Transform*   transform,
-                 Geometry*    geometry,
-                 Material     material) :
+Mesh::Mesh(const std::string&     id,
+                 int              layer,
+                 Transform*       transform,
+                 t_GeometryHandle geometry,
+                 Material         material) :
     Renderable (id, layer, transform, material),
     m_geometry (geometry) {
 }
@@ -26,7 +26,7 @@ Mesh::~Mesh() {
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
-void Mesh::render() {
+void Mesh::render(const RenderView& view) {
 
     // update the material
     m_material.update();
@@ -37,10 +37,8 @@ void Mesh::render() {
         return;
     }
 
-    glPushMatrix();
-
-    // apply the transform to matrices
-    applyTransformations();
+    // compute the matrices from the transform
+    applyTransformations(view);
 
     // set the shader
     setShader();
@@ -74,8 +72,43 @@ void Mesh::render() {
     glEnd();
 
     unsetShader();
+}
+
+//------------------------------------------------------------------------------
+//                          PROTECTED MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool Mesh::computeLocalBounds(util::vec::Vector3& centre, float& radius) {
+
+    const t_VertexArray& vertices = m_geometry->vertices;
+    if (vertices.empty()) {
 
-    glPopMatrix();
+        return false;
+    }
+
+    // centre the sphere on the box around the vertices
+    util::vec::Vector3 min(vertices[0]);
+    util::vec::Vector3 max(vertices[0]);
+    for (unsigned i = 1; i < vertices.size(); ++i) {
+
+        min.x = std::min(min.x, vertices[i].x);
+        min.y = std::min(min.y, vertices[i].y);
+        min.z = std::min(min.z, vertices[i].z);
+        max.x = std::max(max.x, vertices[i].x);
+        max.y = std::max(max.y, vertices[i].y);
+        max.z = std::max(max.z, vertices[i].z);
+    }
+    centre = (min + max) * 0.5f;
+
+    // grow the radius to reach the furthest vertex
+    float radiusSquared = 0.0f;
+    for (unsigned i = 0; i < vertices.size(); ++i) {
+
+        radiusSquared = std::max(radiusSquared,
+            util::vec::distanceSquared(vertices[i], centre));
+    }
+    radius = sqrt(radiusSquared);
+    return true;
 }
 
 } // namespace omi
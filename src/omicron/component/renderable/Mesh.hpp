@@ -21,13 +21,13 @@ public:
     @param id the identifier of the component
     @param layer the render layer of the mesh
     @param transform a pointer to a transform to use for the mesh's position
-    @param geometry a pointer to the geometry to use for the mesh
+    @param geometry the geometry to use for the mesh
     @param material the material to use for the mesh*/
-    Mesh(const std::string& id,
-               int          layer,
-               Transform*   transform,
-               Geometry*    geometry,
-               Material     material);
+    Mesh(const std::string&     id,
+               int              layer,
+               Transform*       transform,
+               t_GeometryHandle geometry,
+               Material         material);
 
     //--------------------------------------------------------------------------
     //                                 DESTRUCTOR
@@ -40,10 +40,18 @@ public:
     //--------------------------------------------------------------------------
 
     /** #Hidden
-    Render the mesh */
-    void render();
+    Render the mesh
+    @param view the view and projection matrices of the frame */
+    void render(const RenderView& view);
 
+protected:
 
+    //--------------------------------------------------------------------------
+    //                         PROTECTED MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** #Override */
+    bool computeLocalBounds(util::vec::Vector3& centre, float& radius);
 
 private:
 
@@ -51,8 +59,8 @@ private:
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    // pointer to the geometry to use for the mesh
-    Geometry* m_geometry;
+    // the geometry to use for the mesh
+    t_GeometryHandle m_geometry;
 };
 
 } // namespace omi
@@ -0,0 +1,212 @@
+#include "ParticleSystem.hpp"
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+ParticleSystem::ParticleSystem(
+        const std::string&        id,
+              int                 layer,
+              Material            material,
+        const util::vec::Vector2& size,
+              unsigned            frames,
+              float               frameRate)
+    :
+    Renderable   (id, layer, NULL, material),
+    m_half       (size.x / 2.0f, size.y / 2.0f),
+    m_frames     (frames),
+    m_framesPerMs(frameRate / 1000.0f),
+    m_lifeTime   (static_cast<float>(frames) / (frameRate / 1000.0f)),
+    m_head       (0) {
+
+    // the particles move so they are never culled as a whole
+    cullable = false;
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+ParticleSystem::~ParticleSystem() {
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ParticleSystem::emit(
+        const util::vec::Vector3& position,
+        const util::vec::Vector2& velocity,
+              float               rotation) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_positionX.push_back(position.x);
+    m_positionY.push_back(position.y);
+    m_positionZ.push_back(position.z);
+    m_velocityX.push_back(velocity.x);
+    m_velocityY.push_back(velocity.y);
+    m_cos.push_back(util::math::cosd(rotation));
+    m_sin.push_back(util::math::sind(rotation));
+    m_age.push_back(0.0f);
+    m_frame.push_back(0);
+}
+
+void ParticleSystem::update() {
+
+    static const unsigned particleCounter =
+        counters::get("particles.alive", counters::PER_FRAME);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    float timeScale = fpsManager.getTimeScale();
+    float deltaTime = fpsManager.getDeltaTime();
+
+    // move and age every particle
+    unsigned count = static_cast<unsigned>(m_age.size());
+    float* positionX = m_positionX.data();
+    float* positionY = m_positionY.data();
+    const float* velocityX = m_velocityX.data();
+    const float* velocityY = m_velocityY.data();
+    float* age = m_age.data();
+    for (unsigned i = m_head; i < count; ++i) {
+
+        positionX[i] += velocityX[i] * timeScale;
+        positionY[i] += velocityY[i] * timeScale;
+        age[i] += deltaTime;
+    }
+
+    // every particle lives for the same time and they are stored oldest first
+    // so the dead particles are always at the front
+    unsigned dead = 0;
+    while (m_head + dead < count && age[m_head + dead] >= m_lifeTime) {
+
+        ++dead;
+    }
+    removeOldest(dead);
+
+    // find the frame of the animation each particle is on
+    count = static_cast<unsigned>(m_age.size());
+    age = m_age.data();
+    unsigned* frame = m_frame.data();
+    for (unsigned i = m_head; i < count; ++i) {
+
+        frame[i] = static_cast<unsigned>(age[i] * m_framesPerMs);
+    }
+
+    counters::add(particleCounter, count - m_head);
+}
+
+void ParticleSystem::clear() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    removeOldest(static_cast<unsigned>(m_age.size()) - m_head);
+}
+
+void ParticleSystem::render(const RenderView& view) {
+
+    // update the material
+    m_material.update();
+
+    unsigned count = getCount();
+    if (!visible || !m_material.isVisible() || count == 0) {
+
+        return;
+    }
+
+    // the particles are in world space so only the view is applied
+    applyTransformations(view);
+
+    // build two triangles for each particle, in the same order as a sprite
+    m_vertices.resize(count * 18);
+    m_texCoords.resize(count * 12);
+    float* vertex = m_vertices.data();
+    float* texCoord = m_texCoords.data();
+    float frameHeight = 1.0f / static_cast<float>(m_frames);
+    for (unsigned i = m_head; i < m_head + count; ++i) {
+
+        // the rotated top right and top left corners, the bottom corners are
+        // their opposites
+        float ax = ( m_half.x * m_cos[i]) - (m_half.y * m_sin[i]);
+        float ay = ( m_half.x * m_sin[i]) + (m_half.y * m_cos[i]);
+        float bx = (-m_half.x * m_cos[i]) - (m_half.y * m_sin[i]);
+        float by = (-m_half.x * m_sin[i]) + (m_half.y * m_cos[i]);
+
+        float x = m_positionX[i];
+        float y = m_positionY[i];
+        float z = m_positionZ[i];
+        float corners[] = {
+            x + ax, y + ay, z,
+            x + bx, y + by, z,
+            x - bx, y - by, z,
+            x - ax, y - ay, z,
+            x - bx, y - by, z,
+            x + bx, y + by, z
+        };
+        std::copy(corners, corners + 18, vertex);
+        vertex += 18;
+
+        float v0 = static_cast<float>(m_frame[i]) * frameHeight;
+        float v1 = v0 + frameHeight;
+        float coords[] = {
+            1.0f, v1,
+            0.0f, v1,
+            1.0f, v0,
+            0.0f, v0,
+            1.0f, v0,
+            0.0f, v1
+        };
+        std::copy(coords, coords + 12, texCoord);
+        texCoord += 12;
+    }
+
+    // set the shader
+    setShader();
+
+    // draw every particle at once
+    glNormal3f(0.0f, 0.0f, 1.0f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, m_vertices.data());
+    glTexCoordPointer(2, GL_FLOAT, 0, m_texCoords.data());
+    glDrawArrays(GL_TRIANGLES, 0, count * 6);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    unsetShader();
+}
+
+unsigned ParticleSystem::getCount() const {
+
+    return static_cast<unsigned>(m_age.size()) - m_head;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ParticleSystem::removeOldest(unsigned count) {
+
+    m_head += count;
+    unsigned size = static_cast<unsigned>(m_age.size());
+    if (m_head == 0 || m_head * 2 < size) {
+
+        return;
+    }
+
+    m_positionX.erase(m_positionX.begin(), m_positionX.begin() + m_head);
+    m_positionY.erase(m_positionY.begin(), m_positionY.begin() + m_head);
+    m_positionZ.erase(m_positionZ.begin(), m_positionZ.begin() + m_head);
+    m_velocityX.erase(m_velocityX.begin(), m_velocityX.begin() + m_head);
+    m_velocityY.erase(m_velocityY.begin(), m_velocityY.begin() + m_head);
+    m_cos.erase(m_cos.begin(), m_cos.begin() + m_head);
+    m_sin.erase(m_sin.begin(), m_sin.begin() + m_head);
+    m_age.erase(m_age.begin(), m_age.begin() + m_head);
+    m_frame.erase(m_frame.begin(), m_frame.begin() + m_head);
+    m_head = 0;
+}
+
+} // namespace omi
\ No newline at end of file
@@ -0,0 +1,130 @@
+#ifndef OMICRON_COMPONENT_RENDERABLE_PARTICLESYSTEM_H_
+#   define OMICRON_COMPONENT_RENDERABLE_PARTICLESYSTEM_H_
+
+#include <mutex>
+#include <vector>
+
+#include "src/omicron/component/renderable/Renderable.hpp"
+
+namespace omi {
+
+/******************************************************************************\
+| A set of short lived animated quads that are simulated and drawn together.   |
+| Particles are stored as separate arrays of each property so they can be      |
+| updated in one tight loop, and all of them are drawn with a single call.     |
+|                                                                              |
+| The material's texture is expected to be an atlas with the frames of the     |
+| animation stacked vertically, the first frame at the bottom. Particles are   |
+| always positioned in world space.                                            |
+\******************************************************************************/
+class ParticleSystem : public Renderable {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new particle system
+    @param id the identifier of the component
+    @param layer the render layer of the particles
+    @param material the material to draw the particles with
+    @param size the size of each particle
+    @param frames the number of frames in the material's texture atlas
+    @param frameRate the playback speed of the animation in frames per second,
+                     particles die once they reach the end of the animation */
+    ParticleSystem(
+            const std::string&        id,
+                  int                 layer,
+                  Material            material,
+            const util::vec::Vector2& size,
+                  unsigned            frames,
+                  float               frameRate);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~ParticleSystem();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Adds a new particle. This may be called by entities that are being
+    updated in parallel.
+    @param position the world position of the particle
+    @param velocity the distance the particle moves each standard frame
+    @param rotation the rotation of the particle around the z axis in
+                    degrees */
+    void emit(
+            const util::vec::Vector3& position,
+            const util::vec::Vector2& velocity,
+                  float               rotation);
+
+    /** Moves and ages all particles and removes those that have finished
+    their animation. This should be called once per logic cycle by the owning
+    entity. */
+    void update();
+
+    /** Removes all particles */
+    void clear();
+
+    /** #Hidden
+    Render the particles
+    @param view the view and projection matrices of the frame */
+    void render(const RenderView& view);
+
+    /** @return the number of living particles */
+    unsigned getCount() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // half the size of each particle
+    util::vec::Vector2 m_half;
+    // the number of frames in the atlas
+    unsigned m_frames;
+    // the playback speed of the animation in frames per millisecond
+    float m_framesPerMs;
+    // the age at which particles die in milliseconds
+    float m_lifeTime;
+
+    // guards emitting particles from multiple threads
+    std::mutex m_mutex;
+
+    // the index of the oldest living particle, the particles before it are
+    // dead and are only erased once there are enough of them
+    unsigned m_head;
+
+    // the properties of each particle, ordered from oldest to youngest
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_positionZ;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_cos;
+    std::vector<float> m_sin;
+    std::vector<float> m_age;
+    std::vector<unsigned> m_frame;
+
+    // the vertices and texture co-ordinates built for drawing, kept between
+    // frames so they don't need to be reallocated
+    std::vector<float> m_vertices;
+    std::vector<float> m_texCoords;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Removes the given number of the oldest living particles. The arrays
+    are only compacted once at least half of them are dead, so each particle
+    is moved a constant number of times on average. */
+    void removeOldest(unsigned count);
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef OMICRON_COMPONENT_RENDERABLE_RENDERABLE_H_
 #   define OMICRON_COMPONENT_RENDERABLE_RENDERABLE_H_
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <GL/glew.h>
 #include <SFML/OpenGL.hpp>
@@ -8,6 +10,8 @@
 #include "src/omicron/Omicron.hpp"
 #include "src/omicron/component/Component.hpp"
 #include "src/omicron/component/Transform.hpp"
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/rendering/RenderView.hpp"
 #include "src/omicron/rendering/shading/Material.hpp"
 
 namespace omi {
@@ -25,6 +29,9 @@ public:
 
     //! is true if this component will be rendered
     bool visible;
+    //! is true if this component is skipped when it is outside of the camera's
+    //! view, this should be false if its shader moves vertices
+    bool cullable;
     // the custom shader function for the renderable
     std::function<void (GLuint)> shaderFunction;
 
@@ -45,9 +52,15 @@ public:
         :
         Component  (id),
         visible    (true),
+        cullable   (true),
         m_layer    (layer),
         m_transform(transform),
-        m_material (material) {
+        m_material (material),
+        m_localBoundsValid(false),
+        m_hasBounds(false),
+        m_localRadius(0.0f),
+        m_worldVersion(0),
+        m_worldRadius(0.0f) {
     }
 
     //--------------------------------------------------------------------------
@@ -87,9 +100,55 @@ public:
         return m_material;
     }
 
+    /** Gets the world space bounding sphere of this renderable. This is cached
+    and only recomputed when the transform or the renderable's size changes.
+    @param centre is set to the centre of the sphere
+    @param radius is set to the radius of the sphere
+    @return false if the renderable has no bounds and so can't be culled */
+    bool getWorldBounds(util::vec::Vector3& centre, float& radius) {
+
+        if (!m_localBoundsValid) {
+
+            m_hasBounds = computeLocalBounds(m_localCentre, m_localRadius);
+            m_localBoundsValid = true;
+            m_worldVersion = 0;
+        }
+        if (!m_hasBounds) {
+
+            return false;
+        }
+
+        if (m_transform == NULL) {
+
+            m_worldCentre = m_localCentre;
+            m_worldRadius = m_localRadius;
+        }
+        else if (m_transform->getVersion() != m_worldVersion) {
+
+            const util::mat::Matrix4& world = m_transform->getWorldMatrix();
+            m_worldCentre = world.transformPoint(m_localCentre);
+            // grow the radius by the largest scale of any axis
+            const float* m = world.data();
+            float scale = 0.0f;
+            for (unsigned axis = 0; axis < 3; ++axis) {
+
+                const float* c = m + (axis * 4);
+                scale = std::max(scale,
+                    (c[0] * c[0]) + (c[1] * c[1]) + (c[2] * c[2]));
+            }
+            m_worldRadius = m_localRadius * sqrt(scale);
+            m_worldVersion = m_transform->getVersion();
+        }
+
+        centre = m_worldCentre;
+        radius = m_worldRadius;
+        return true;
+    }
+
     /** #Hidden
-    Render this component */
-    virtual void render() = 0;
+    Render this component
+    @param view the view and projection matrices of the frame */
+    virtual void render(const RenderView& view) = 0;
 
 protected:
 
@@ -103,43 +162,78 @@ protected:
     Transform* m_transform;
     // the material
     Material  m_material;
+    // the model view and projection matrices to render with
+    util::mat::Matrix4 m_modelView;
+    util::mat::Matrix4 m_projection;
 
     //--------------------------------------------------------------------------
     //                         PROTECTED MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    /** Applies transformations */
-    void applyTransformations() {
+    /** Computes the bounding sphere of this renderable before its transform is
+    applied. By default renderables have no bounds and are never culled.
+    @param centre is set to the centre of the sphere
+    @param radius is set to the radius of the sphere
+    @return false if the renderable has no bounds */
+    virtual bool computeLocalBounds(util::vec::Vector3& centre, float& radius) {
 
-        // do nothing if the transform is null
+        return false;
+    }
+
+    /** Marks the local bounds as changed so they are recomputed the next time
+    they are needed */
+    void invalidateBounds() {
+
+        m_localBoundsValid = false;
+    }
+
+    /** Computes the matrices to render with, these are passed to the shader by
+    setShader
+    @param view the view and projection matrices of the frame */
+    void applyTransformations(const RenderView& view) {
+
+        m_projection = view.projection;
+
+        // use only the view if the transform is null
         if (!m_transform) {
 
+            m_modelView = view.view;
             return;
         }
 
-        // apply translation
-        util::vec::Vector3 translation(m_transform->computeTranslation());
-        glTranslatef(translation.x, translation.y, translation.z);
-
-        // TODO: local and global shit
-        // apply rotation
-        util::vec::Vector3 rotation(m_transform->computeRotation());
-        glRotatef(rotation.x, 1.0f, 0.0f, 0.0f);
-        glRotatef(rotation.y, 0.0f, 1.0f, 0.0f);
-        glRotatef(rotation.z, 0.0f, 0.0f, 1.0f);
-
-        // apply scale
-        util::vec::Vector3 scale(m_transform->computeScale());
-        glScalef(scale.x, scale.y, scale.z);
+        // combine with the cached world matrix of the transform
+        m_modelView = view.view * m_transform->getWorldMatrix();
     }
 
     /** Sets up the shader for rendering and passes in all data */
     void setShader() {
 
+        static const unsigned shaderCounter =
+            counters::get("render.shader_binds", counters::PER_FRAME);
+        static const unsigned textureCounter =
+            counters::get("render.texture_binds", counters::PER_FRAME);
+
         // get the OpenGL program
         GLuint program = m_material.shader.getProgram();
         // use the shader
         glUseProgram(program);
+        counters::add(shaderCounter);
+
+        // pass in the matrices
+        float normalMatrix[9];
+        m_modelView.getNormalMatrix(normalMatrix);
+        glUniformMatrix4fv(
+            glGetUniformLocation(program, "u_modelViewMatrix"),
+            1, GL_FALSE, m_modelView.data()
+        );
+        glUniformMatrix4fv(
+            glGetUniformLocation(program, "u_projectionMatrix"),
+            1, GL_FALSE, m_projection.data()
+        );
+        glUniformMatrix3fv(
+            glGetUniformLocation(program, "u_normalMatrix"),
+            1, GL_FALSE, normalMatrix
+        );
 
         // pass in colour to the shader
         glUniform4f(
@@ -154,7 +248,9 @@ protected:
         if (m_material.texture != NULL) {
 
             glUniform1i(glGetUniformLocation(program, "u_hasTexture"), 1);
+            m_material.texture->use();
             glBindTexture(GL_TEXTURE_2D, m_material.texture->getId());
+            counters::add(textureCounter);
         }
         else {
 
@@ -192,6 +288,25 @@ protected:
         glUseProgram(0);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // is false if the local bounds must be recomputed
+    bool m_localBoundsValid;
+    // is true if the renderable has bounds
+    bool m_hasBounds;
+    // the cached local bounding sphere
+    util::vec::Vector3 m_localCentre;
+    float m_localRadius;
+    // the version of the transform the world bounds were computed from
+    unsigned m_worldVersion;
+    // the cached world bounding sphere
+    util::vec::Vector3 m_worldCentre;
+    float m_worldRadius;
 };
 
 } // namespace omi
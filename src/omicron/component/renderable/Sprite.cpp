@@ -33,7 +33,7 @@ Sprite::~Sprite() {
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
-void Sprite::render() {
+void Sprite::render(const RenderView& view) {
 
     // update the material
     m_material.update();
@@ -44,10 +44,8 @@ void Sprite::render() {
         return;
     }
 
-    glPushMatrix();
-
-    // apply the transform to the matrices
-    applyTransformations();
+    // compute the matrices from the transform
+    applyTransformations(view);
 
     // set the shader
     setShader();																							
@@ -83,8 +81,6 @@ void Sprite::render() {
     glEnd();
 
     unsetShader();
-
-    glPopMatrix();
 }
 
 const util::vec::Vector2& Sprite::getSize() const {
@@ -107,6 +103,7 @@ void Sprite::setSize(const util::vec::Vector2& size) {
     m_size = size;
     m_half.x = size.x / 2.0f;
     m_half.y = size.y / 2.0f;
+    invalidateBounds();
 }
 
 void Sprite::setTexSize(const util::vec::Vector2& texSize) {
@@ -123,4 +120,16 @@ void Sprite::setTexOffset(const util::vec::Vector2& texOffset) {
     m_texCoord.y = m_texOffset.y + m_texSize.y;
 }
 
+//------------------------------------------------------------------------------
+//                          PROTECTED MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool Sprite::computeLocalBounds(util::vec::Vector3& centre, float& radius) {
+
+    // the sprite is a quad centred on its transform
+    centre = util::vec::Vector3();
+    radius = util::vec::magnitude(m_half);
+    return true;
+}
+
 } // namespace omi
@@ -42,8 +42,9 @@ public:
     //--------------------------------------------------------------------------
 
     /** #Hidden
-    Render the mesh */
-    void render();
+    Render the mesh
+    @param view the view and projection matrices of the frame */
+    void render(const RenderView& view);
 
     /** @return the size of the sprite */
     const util::vec::Vector2& getSize() const;
@@ -63,6 +64,15 @@ public:
     /** @param texOffset the new offset of the sprite's texture co-ordinates */
     void setTexOffset(const util::vec::Vector2& texOffset);
 
+protected:
+
+    //--------------------------------------------------------------------------
+    //                         PROTECTED MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** #Override */
+    bool computeLocalBounds(util::vec::Vector3& centre, float& radius);
+
 private:
 
     //--------------------------------------------------------------------------
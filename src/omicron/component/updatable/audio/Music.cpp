@@ -11,14 +11,18 @@ Music::Music(const std::string& id,
                    float        volume,
                    bool loop) :
     Updatable(id),
+    m_backend(audio::getBackend()),
+    m_stream (0),
     m_volume (volume),
     m_loop   (loop) {
 
-    if (!m_music.openFromFile(filePath)) {
+    // there may be no audio to play music on
+    if (m_backend == NULL) {
 
-        // TODO: throw an exception??
-        std::cout << "music failed to load" << std::endl;
+        return;
     }
+
+    m_stream = m_backend->openStream(filePath);
 }
 
 //------------------------------------------------------------------------------
@@ -26,6 +30,11 @@ Music::Music(const std::string& id,
 //------------------------------------------------------------------------------
 
 Music::~Music() {
+
+    if (m_backend != NULL) {
+
+        m_backend->closeStream(m_stream);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -34,42 +43,55 @@ Music::~Music() {
 
 void Music::update() {
 
+    if (m_backend == NULL) {
+
+        return;
+    }
+
     // update any settings
     if (audioSettings.isMusicDisabled()) {
 
-        m_music.setVolume(0);
+        m_backend->setStreamVolume(m_stream, 0.0f);
     }
     else{
 
-        m_music.setVolume(m_volume * audioSettings.getMusicVolume() * 100);
+        m_backend->setStreamVolume(
+            m_stream, m_volume * audioSettings.getMusicVolume());
     }
-    m_music.setLoop(m_loop);
+    m_backend->setStreamLoop(m_stream, m_loop);
 }
 
 void Music::play() {
 
     // don't play if music is disabled
-    if (audioSettings.isMusicDisabled()) {
+    if (m_backend == NULL || audioSettings.isMusicDisabled()) {
 
         return;
     }
 
     // set up the music settings
-    m_music.setVolume(m_volume * audioSettings.getMusicVolume() * 100);
-    m_music.setLoop(m_loop);
+    m_backend->setStreamVolume(
+        m_stream, m_volume * audioSettings.getMusicVolume());
+    m_backend->setStreamLoop(m_stream, m_loop);
 
     // play the music
-    m_music.play();
+    m_backend->playStream(m_stream);
 }
 
 void Music::pause() {
 
-    m_music.pause();
+    if (m_backend != NULL) {
+
+        m_backend->pauseStream(m_stream);
+    }
 }
 
 void Music::stop() {
 
-    m_music.stop();
+    if (m_backend != NULL) {
+
+        m_backend->stopStream(m_stream);
+    }
 }
 
 //-----------------------------------GETTERS------------------------------------
@@ -81,7 +103,7 @@ float Music::getVolume() const {
 
 bool Music::isStopped() const {
 
-    return m_music.getStatus() == 0;
+    return m_backend == NULL || m_backend->isStreamStopped(m_stream);
 }
 
 bool Music::isLooping() const {
@@ -2,9 +2,9 @@
 #   define OMICRON_COMPONENT_UPDATABLE_AUDIO_MUSIC_H_
 
 #include <iostream>
-#include <SFML/Audio.hpp>
 
 #include "src/omicron/Omicron.hpp"
+#include "src/omicron/audio/Audio.hpp"
 #include "src/omicron/component/updatable/Updatable.hpp"
 
 namespace omi {
@@ -73,8 +73,10 @@ private:
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    // the sfml music object
-    sf::Music m_music;
+    // the backend playing the music, this is null if there is no audio
+    AudioBackend* m_backend;
+    // the backend's handle of the music stream
+    unsigned m_stream;
     // the volume of the music
     float m_volume;
     // the looping mode of the music
@@ -0,0 +1,232 @@
+#include "Counters.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace omi {
+
+namespace counters {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the maximum number of counters that can be registered
+static const unsigned MAX_COUNTERS = 256;
+// the number of frames of samples that are kept
+static const unsigned SAMPLE_FRAMES = 600;
+
+//------------------------------------------------------------------------------
+//                                    STRUCTS
+//------------------------------------------------------------------------------
+
+// the values of every counter at the end of a frame
+struct Sample {
+
+    unsigned long long frame;
+    float frameTime;
+    std::vector<long long> values;
+};
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+// the values of the counters, this is fixed in size so that values can be
+// updated without locking while new counters are registered
+std::atomic<long long> values[MAX_COUNTERS];
+// the number of registered counters
+std::atomic<unsigned> count(0);
+// the names of the counters
+std::vector<std::string> names;
+// the kinds of the counters
+std::vector<Kind> kinds;
+// the ids of the counters mapped by name
+std::map<std::string, unsigned> ids;
+// guards registering counters
+std::mutex registerMutex;
+
+// the ring buffer of samples
+Sample samples[SAMPLE_FRAMES];
+// the total number of frames that have been sampled
+unsigned long long frames = 0;
+
+// the CSV file being streamed to
+std::ofstream csv;
+// the number of counters named in the last header written to the CSV file
+unsigned csvColumns = INVALID;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Writes the latest sample to the CSV file */
+void writeRow(const Sample& sample) {
+
+    // write a new header if counters have been registered
+    if (sample.values.size() != csvColumns) {
+
+        csvColumns = sample.values.size();
+        csv << "frame,frame_ms";
+        for (unsigned i = 0; i < csvColumns; ++i) {
+
+            csv << "," << names[i];
+        }
+        csv << "\n";
+    }
+
+    csv << sample.frame << "," << sample.frameTime;
+    for (unsigned i = 0; i < csvColumns; ++i) {
+
+        csv << "," << sample.values[i];
+    }
+    csv << "\n";
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+unsigned get(const std::string& name, Kind kind) {
+
+    std::lock_guard<std::mutex> lock(registerMutex);
+
+    std::map<std::string, unsigned>::iterator it = ids.find(name);
+    if (it != ids.end()) {
+
+        return it->second;
+    }
+
+    if (count == MAX_COUNTERS) {
+
+        std::cout << "too many performance counters to register: " << name <<
+            std::endl;
+        return INVALID;
+    }
+
+    unsigned id = count;
+    names.push_back(name);
+    kinds.push_back(kind);
+    ids.insert(std::make_pair(name, id));
+    values[id] = 0;
+    ++count;
+
+    return id;
+}
+
+void add(unsigned id, long long amount) {
+
+    if (id < MAX_COUNTERS) {
+
+        values[id].fetch_add(amount, std::memory_order_relaxed);
+    }
+}
+
+void set(unsigned id, long long value) {
+
+    if (id < MAX_COUNTERS) {
+
+        values[id].store(value, std::memory_order_relaxed);
+    }
+}
+
+long long getValue(unsigned id) {
+
+    if (id >= count) {
+
+        return 0;
+    }
+
+    return values[id].load(std::memory_order_relaxed);
+}
+
+unsigned getCount() {
+
+    return count;
+}
+
+std::string getName(unsigned id) {
+
+    std::lock_guard<std::mutex> lock(registerMutex);
+    if (id >= names.size()) {
+
+        return "";
+    }
+
+    return names[id];
+}
+
+unsigned getSampleCount() {
+
+    return frames < SAMPLE_FRAMES ? static_cast<unsigned>(frames) :
+        SAMPLE_FRAMES;
+}
+
+long long getSample(unsigned age, unsigned id) {
+
+    if (age >= getSampleCount()) {
+
+        return 0;
+    }
+
+    const Sample& sample = samples[(frames - 1 - age) % SAMPLE_FRAMES];
+    if (id >= sample.values.size()) {
+
+        return 0;
+    }
+
+    return sample.values[id];
+}
+
+bool stream(const std::string& filePath) {
+
+    csv.close();
+    csv.open(filePath.c_str());
+    if (!csv.is_open()) {
+
+        std::cout << "unable to open counters file: " << filePath << std::endl;
+        return false;
+    }
+    csvColumns = INVALID;
+
+    return true;
+}
+
+void sample(float frameTime) {
+
+    std::lock_guard<std::mutex> lock(registerMutex);
+
+    Sample& sample = samples[frames % SAMPLE_FRAMES];
+    sample.frame = frames;
+    sample.frameTime = frameTime;
+    sample.values.resize(count);
+    for (unsigned i = 0; i < sample.values.size(); ++i) {
+
+        if (kinds[i] == PER_FRAME) {
+
+            sample.values[i] = values[i].exchange(0);
+        }
+        else {
+
+            sample.values[i] = values[i].load();
+        }
+    }
+    ++frames;
+
+    if (csv.is_open()) {
+
+        writeRow(sample);
+    }
+}
+
+} // namespace counters
+
+} // namespace omi
@@ -0,0 +1,91 @@
+#ifndef OMICRON_DEBUG_COUNTERS_H_
+#   define OMICRON_DEBUG_COUNTERS_H_
+
+#include <string>
+
+namespace omi {
+
+/****************************************************************************\
+| A registry of named performance counters that the engine updates as it     |
+| runs. Once per frame every counter is sampled into a ring buffer holding   |
+| the most recent frames, and the samples can also be streamed to a CSV file |
+| with one row per frame so spikes can be matched up with what the engine    |
+| was doing at the time. Counters may be updated from any thread.            |
+\****************************************************************************/
+namespace counters {
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+//! the ways a counter's value is carried between frames
+enum Kind {
+
+    GAUGE,    // the value is kept until it is next set
+    PER_FRAME // the value is reset to 0 after each frame is sampled
+};
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+//! the id returned when a counter could not be registered
+static const unsigned INVALID = static_cast<unsigned>(-1);
+
+//------------------------------------------------------------------------------
+//                                   PROTOTYPES
+//------------------------------------------------------------------------------
+
+/** Finds the counter with the given name, registering it if it does not exist
+yet. Looking up a counter takes a lock so the id should be kept rather than
+looked up every time the counter is updated.
+@param name the name of the counter
+@param kind how the counter's value is carried between frames
+@return the id of the counter, or INVALID if no more counters can be
+        registered */
+unsigned get(const std::string& name, Kind kind);
+
+/** Adds to the value of a counter
+@param id the id of the counter
+@param amount the amount to add */
+void add(unsigned id, long long amount = 1);
+
+/** Sets the value of a counter
+@param id the id of the counter
+@param value the new value */
+void set(unsigned id, long long value);
+
+/** @return the current value of the given counter */
+long long getValue(unsigned id);
+
+/** @return the number of counters that have been registered */
+unsigned getCount();
+
+/** @return the name of the given counter */
+std::string getName(unsigned id);
+
+/** @return the number of frames held in the ring buffer of samples */
+unsigned getSampleCount();
+
+/** @return the value of a counter in a sampled frame
+@param age how many frames ago the sample was taken, 0 is the latest frame
+@param id the id of the counter */
+long long getSample(unsigned age, unsigned id);
+
+/** Streams every frame's sample to a CSV file. A header row naming the
+columns is written first and again whenever a new counter is registered.
+@param filePath the path to the file to write to
+@return if the file could be opened */
+bool stream(const std::string& filePath);
+
+/** #Hidden
+Samples every counter for the frame that has just finished and resets the
+per frame counters
+@param frameTime the length of the frame in milliseconds */
+void sample(float frameTime);
+
+} // namespace counters
+
+} // namespace omi
+
+#endif
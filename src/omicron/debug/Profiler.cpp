@@ -0,0 +1,187 @@
+#include "Profiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace omi {
+
+namespace profile {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of events each thread's buffer can hold
+static const unsigned BUFFER_SIZE = 1 << 16;
+
+//------------------------------------------------------------------------------
+//                                    STRUCTS
+//------------------------------------------------------------------------------
+
+// a single recorded event
+struct Event {
+
+    const char* name;
+    util::int64 start;
+    util::int64 end;
+};
+
+// the ring buffer of events recorded by a single thread, only the owning thread
+// writes to the buffer
+struct ThreadBuffer {
+
+    // the index of the thread in the trace
+    unsigned thread;
+    // the total number of events that have been written
+    std::atomic<unsigned> head;
+    // the events
+    Event events[BUFFER_SIZE];
+};
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+// the time profiling began
+const std::chrono::steady_clock::time_point epoch =
+    std::chrono::steady_clock::now();
+
+// the buffers of every thread that has recorded an event, buffers are never
+// freed so that events from threads that have finished are kept
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+// guards the list of buffers
+std::mutex buffersMutex;
+
+// the buffer of the current thread
+thread_local ThreadBuffer* threadBuffer = NULL;
+
+// the file to write to at exit
+std::string exitPath;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** @return the buffer of the calling thread, creating it if needed */
+ThreadBuffer* getThreadBuffer() {
+
+    if (threadBuffer == NULL) {
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+        threadBuffer = buffers.back().get();
+        threadBuffer->thread = buffers.size() - 1;
+        threadBuffer->head = 0;
+    }
+
+    return threadBuffer;
+}
+
+/** Writes a string to the stream as a JSON string
+@param out the stream to write to
+@param s the string to write */
+void writeString(std::ostream& out, const char* s) {
+
+    out << '"';
+    for (; *s != '\0'; ++s) {
+
+        if (*s == '"' || *s == '\\') {
+
+            out << '\\';
+        }
+        out << *s;
+    }
+    out << '"';
+}
+
+/** Called at exit to write out the trace */
+void dumpOnExit() {
+
+    dump(exitPath);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+util::int64 now() {
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void record(const char* name, util::int64 start, util::int64 end) {
+
+    ThreadBuffer* buffer = getThreadBuffer();
+
+    // only this thread writes to the buffer so the head can't change under us
+    unsigned head = buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[head % BUFFER_SIZE];
+    event.name  = name;
+    event.start = start;
+    event.end   = end;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+bool dump(const std::string& filePath) {
+
+    std::ofstream out(filePath.c_str());
+    if (!out.is_open()) {
+
+        std::cout << "unable to open profile trace file: " << filePath <<
+            std::endl;
+        return false;
+    }
+
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (std::vector<std::unique_ptr<ThreadBuffer>>::iterator it =
+         buffers.begin(); it != buffers.end(); ++it) {
+
+        // only the most recent events are still in the buffer
+        unsigned head = (*it)->head.load(std::memory_order_acquire);
+        unsigned begin = head > BUFFER_SIZE ? head - BUFFER_SIZE : 0;
+        for (unsigned i = begin; i < head; ++i) {
+
+            const Event& event = (*it)->events[i % BUFFER_SIZE];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(out, event.name);
+            out << ",\"cat\":\"omicron\",\"ph\":\"X\",\"pid\":1,\"tid\":" <<
+                (*it)->thread << ",\"ts\":" << event.start << ",\"dur\":" <<
+                (event.end - event.start) << "}";
+            first = false;
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return out.good();
+}
+
+void dumpAtExit(const std::string& filePath) {
+
+    static bool registered = false;
+
+    exitPath = filePath;
+    if (!registered) {
+
+        atexit(dumpOnExit);
+        registered = true;
+    }
+}
+
+} // namespace profile
+
+} // namespace omi
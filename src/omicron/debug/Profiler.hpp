@@ -0,0 +1,111 @@
+#ifndef OMICRON_DEBUG_PROFILER_H_
+#   define OMICRON_DEBUG_PROFILER_H_
+
+#include <string>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+#include "lib/Utilitron/TypeUtil.hpp"
+
+//------------------------------------------------------------------------------
+//                                     MACROS
+//------------------------------------------------------------------------------
+
+#define OMI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OMI_PROFILE_CONCAT(a, b) OMI_PROFILE_CONCAT_IMPL(a, b)
+
+/** Use this macro at the beginning of a block to record the time spent in the
+block under the given name. The name must be a string literal. Markers are
+compiled out entirely unless OMICRON_PROFILE is defined. */
+#ifdef OMICRON_PROFILE
+#   define OMI_PROFILE_SCOPE(name) \
+        omi::profile::Scope OMI_PROFILE_CONCAT(omiProfileScope, __LINE__)(name)
+#else
+#   define OMI_PROFILE_SCOPE(name)
+#endif
+
+namespace omi {
+
+/*****************************************************************************\
+| Records how long scoped blocks of code take to run. Each thread records its |
+| events into its own fixed size ring buffer without locking, once a buffer   |
+| is full the oldest events are overwritten. The recorded events can be       |
+| written out in the Chrome trace event format and viewed in about:tracing.   |
+\*****************************************************************************/
+namespace profile {
+
+//------------------------------------------------------------------------------
+//                                   PROTOTYPES
+//------------------------------------------------------------------------------
+
+/** @return the current time in microseconds since profiling began */
+util::int64 now();
+
+/** #Hidden
+Records an event into the calling thread's buffer
+@param name the name of the event, this must be a string literal
+@param start the time the event began in microseconds
+@param end the time the event ended in microseconds */
+void record(const char* name, util::int64 start, util::int64 end);
+
+/** Writes all recorded events to a file in the Chrome trace event format
+#WARNING: events that are being recorded while the trace is being written may
+be torn, so this should be called between frames
+@param filePath the path to the file to write to
+@return if the file could be written */
+bool dump(const std::string& filePath);
+
+/** Writes all recorded events to the given file when the process exits
+@param filePath the path to the file to write to */
+void dumpAtExit(const std::string& filePath);
+
+/*************************************************************\
+| Records the time between its construction and destruction.  |
+\*************************************************************/
+class Scope {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(Scope);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Begins timing a scope
+    @param name the name of the scope, this must be a string literal */
+    explicit Scope(const char* name) :
+        m_name (name),
+        m_start(now()) {
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~Scope() {
+
+        record(m_name, m_start, now());
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the name of the scope
+    const char* m_name;
+    // the time the scope began
+    util::int64 m_start;
+};
+
+} // namespace profile
+
+} // namespace omi
+
+#endif
@@ -6,9 +6,15 @@ namespace omi {
 //                                  CONSTRUCTOR
 //------------------------------------------------------------------------------
 
-Window::Window() :
+Window::Window(bool multisample) :
     m_cursorVisble(true) {
 
+    // headless runs have no window
+    if (systemSettings.isHeadless()) {
+
+        return;
+    }
+
     // set up flags
     unsigned flags = sf::Style::Default;
     if (displaySettings.getFullscreen()) {
@@ -20,7 +26,7 @@ Window::Window() :
     sf::ContextSettings settings;
     settings.depthBits          = 24;
     settings.stencilBits        = 8;
-    settings.antialiasingLevel  = 4;
+    settings.antialiasingLevel  = multisample ? 4 : 0;
     settings.majorVersion       = 3;
     settings.minorVersion       = 0;
 
@@ -70,6 +76,12 @@ Window::~Window() {
 
 void Window::update() {
 
+    // nothing to display without a window
+    if (!m_window) {
+
+        return;
+    }
+
     // check if there has been a change in settings
     if (displaySettings.check()) {
 
@@ -33,8 +33,10 @@ public:
     //                                CONSTRUCTOR
     //--------------------------------------------------------------------------
     /** Creates a new window
-    #WARNING: currently only one active window is supported */
-    Window();
+    #WARNING: currently only one active window is supported
+    @param multisample if the window is antialiased, captured frames can only
+                       be shown in a window that isn't */
+    Window(bool multisample);
 
     //--------------------------------------------------------------------------
     //                                 DESTRUCTOR
@@ -60,7 +62,7 @@ private:
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    // the window object
+    // the window object, this is null when running headless
     std::unique_ptr<sf::Window> m_window;
     // whether the cursor should be visible or not
     bool m_cursorVisble;
@@ -6,7 +6,8 @@ namespace omi {
 //                                  CONSTRUCTOR
 //------------------------------------------------------------------------------
 
-ComponentTable::ComponentTable() {
+ComponentTable::ComponentTable() :
+    m_size(0) {
 }
 
 //------------------------------------------------------------------------------
@@ -22,62 +23,113 @@ ComponentTable::~ComponentTable() {
 
 bool ComponentTable::contains(const std::string& id) {
 
-    // search for the key in the table
-    t_ComponentMap::iterator it = m_components.find(id);
-    return it != m_components.end();
+    return get(id) != NULL;
 }
 
 Component* ComponentTable::get(const std::string& id) {
 
-    // check if the id is contained within the table
-    if (contains(id)) {
+    // an id that has never been interned can't be in the table
+    component::Key key = component::findKey(id);
+    if (key == component::ANONYMOUS) {
+
+        return NULL;
+    }
 
-        return m_components[id].get();
+    unsigned index = find(key);
+    if (index < m_size) {
+
+        return entry(index).component.get();
     }
 
     return NULL;
 }
 
-void ComponentTable::add(Component* component) {
+bool ComponentTable::remove(const std::string& id) {
 
-    // check that the id is not already contained within the table
-    if (contains(component->getId())) {
+    component::Key key = component::findKey(id);
+    if (key == component::ANONYMOUS) {
 
-        //throw an exception
-        throw util::ex::ItemAlreadyExistsException(
-            "a component with the identifier \'" + component->getId() +
-            "\' already exists within this entities\' component table");
+        return false;
     }
 
-    // add to the list of new components
-    newComponents.push_back(component);
+    // check if the id is contained within the table
+    unsigned index = find(key);
+    if (index >= m_size) {
 
-    // add to the table
-    m_components.insert(std::make_pair(
-        component->getId(), std::unique_ptr<Component>(component)));
-}
+        return false;
+    }
 
-bool ComponentTable::remove(const std::string& id) {
+    removeComponents.push_back(entry(index).component.get());
+    entry(index).component.reset();
 
-    // check if the id is contained within the table
-    if (contains(id)) {
+    // fill the gap with the last entry
+    --m_size;
+    if (index != m_size) {
 
-        removeComponents.push_back(m_components[id].get());
-        m_components.erase(m_components.find(id));
-        return true;
+        Entry& last = entry(m_size);
+        entry(index).key       = last.key;
+        entry(index).type      = last.type;
+        entry(index).component = std::move(last.component);
     }
+    if (m_size >= INLINE_CAPACITY) {
 
-    return false;
+        m_overflow.pop_back();
+    }
+
+    return true;
 }
 
 void ComponentTable::copyToList(std::vector<Component*>& list) {
 
-    // iterate over the map and copy into list
-    for (t_ComponentMap::iterator it = m_components.begin();
-        it != m_components.end(); ++it) {
+    for (unsigned i = 0; i < m_size; ++i) {
+
+        list.push_back(entry(i).component.get());
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+unsigned ComponentTable::find(component::Key key) {
+
+    for (unsigned i = 0; i < m_size; ++i) {
+
+        if (entry(i).key == key) {
+
+            return i;
+        }
+    }
+
+    return m_size;
+}
+
+void ComponentTable::addEntry(Component* component, component::TypeKey type) {
+
+    // check that the id is not already contained within the table, anonymous
+    // components are always unique
+    if (component->getKey() != component::ANONYMOUS &&
+        find(component->getKey()) < m_size) {
+
+        //throw an exception
+        throw util::ex::ItemAlreadyExistsException(
+            "a component with the identifier \'" + component->getId() +
+            "\' already exists within this entities\' component table");
+    }
+
+    // add to the list of new components
+    newComponents.push_back(component);
+
+    // add to the table
+    if (m_size >= INLINE_CAPACITY) {
 
-        list.push_back(it->second.get());
+        m_overflow.push_back(Entry());
     }
+    Entry& e = entry(m_size);
+    e.key = component->getKey();
+    e.type = type;
+    e.component.reset(component);
+    ++m_size;
 }
 
 } // namespace omi
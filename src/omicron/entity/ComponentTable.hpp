@@ -1,7 +1,6 @@
 #ifndef OMICRON_ENTITY_COMPONENTTABLE_H_
 #   define OMICRON_ENTITY_COMPONENTTABLE_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,15 +12,14 @@
 
 namespace omi {
 
-//------------------------------------------------------------------------------
-//                                    TYPEDEF
-//------------------------------------------------------------------------------
-
-typedef std::map<std::string, std::unique_ptr<Component>> t_ComponentMap;
-
 /************************************************************************\
 | A component table contains a set of generic components mapped by their |
 | unique identifiers.                                                    |
+|                                                                        |
+| Components are stored in a flat array with room for a handful of       |
+| components inline so that typical entities don't need to allocate.     |
+| Identifiers are compared as interned keys and components can also be   |
+| looked up by their concrete type.                                      |
 \************************************************************************/
 class ComponentTable {
 public:
@@ -70,10 +68,41 @@ public:
     @return the component if it was found else null */
     Component* get(const std::string& id);
 
+    /** Gets the first component that was added as the type T. If there is no
+    such component the first component that is derived from T is returned.
+    Otherwise return null
+    @return the component if it was found else null */
+    template<typename T>
+    T* get() {
+
+        component::TypeKey type = component::typeKey<T>();
+        for (unsigned i = 0; i < m_size; ++i) {
+
+            if (entry(i).type == type) {
+
+                return static_cast<T*>(entry(i).component.get());
+            }
+        }
+        for (unsigned i = 0; i < m_size; ++i) {
+
+            T* c = dynamic_cast<T*>(entry(i).component.get());
+            if (c) {
+
+                return c;
+            }
+        }
+
+        return NULL;
+    }
+
     /** Adds a component to the table
     #NOTE: the component table will take ownership of the component pointer
     @param component the pointer to the component */
-    void add(Component* component);
+    template<typename T>
+    void add(T* component) {
+
+        addEntry(component, component::typeKey<T>());
+    }
 
     /** Removes the component with the given id from the able
     @param id the identifier of the component to remove
@@ -86,12 +115,59 @@ public:
 
 private:
 
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // the number of components that can be stored without allocating
+    static const unsigned INLINE_CAPACITY = 8;
+
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    // a single component within the table
+    struct Entry {
+
+        component::Key key;
+        component::TypeKey type;
+        std::unique_ptr<Component> component;
+    };
+
     //--------------------------------------------------------------------------
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    // the map from component ids to components
-    t_ComponentMap m_components;
+    // the number of components in the table
+    unsigned m_size;
+    // the components stored inline
+    Entry m_inline[INLINE_CAPACITY];
+    // the components that didn't fit inline
+    std::vector<Entry> m_overflow;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the entry at the given index */
+    Entry& entry(unsigned index) {
+
+        if (index < INLINE_CAPACITY) {
+
+            return m_inline[index];
+        }
+
+        return m_overflow[index - INLINE_CAPACITY];
+    }
+
+    /** @return the index of the component with the given key or m_size if it
+    is not in the table */
+    unsigned find(component::Key key);
+
+    /** Adds a component to the table
+    @param component the pointer to the component
+    @param type the key of the type the component was added as */
+    void addEntry(Component* component, component::TypeKey type);
 };
 
 } // namespace omi
@@ -55,6 +55,16 @@ public:
     /** Updates the entity and computes it's logic */
     virtual void update() = 0;
 
+    /** Entities that return true here may be updated at the same time as
+    other parallel safe entities on different threads. An entity is parallel
+    safe if its update only changes the entity itself and its own components,
+    and doesn't read the state of other entities.
+    @return if this entity's update is safe to run in parallel */
+    virtual bool isParallelSafe() const {
+
+        return false;
+    }
+
     /** @return the component table of this entity */
     ComponentTable& getComponents() {
 
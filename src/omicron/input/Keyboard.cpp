@@ -1,4 +1,7 @@
 #include "Input.hpp"
+#include "Replay.hpp"
+
+#include "src/omicron/Omicron.hpp"
 
 namespace omi {
 
@@ -10,7 +13,15 @@ namespace input {
 
 bool isKeyPressed(sf::Keyboard::Key key) {
 
-    return sf::Keyboard::isKeyPressed(key);
+    // recorded input doesn't need the live keyboard, and headless runs have
+    // no window to take keyboard input from
+    if (replay::getMode() == replay::PLAYBACK ||
+        systemSettings.isHeadless()) {
+
+        return replay::filterKey(key, false);
+    }
+
+    return replay::filterKey(key, sf::Keyboard::isKeyPressed(key));
 }
 
 } // namespace input
@@ -1,5 +1,7 @@
 #include "Input.hpp"
 
+#include "src/omicron/Omicron.hpp"
+
 namespace omi {
 
 namespace input {
@@ -10,6 +12,12 @@ namespace input {
 
 util::vec::Vector2 getMousePos() {
 
+    // headless runs have no window to take mouse input from
+    if (systemSettings.isHeadless()) {
+
+        return util::vec::Vector2();
+    }
+
     sf::Vector2i pos = sf::Mouse::getPosition();
     return util::vec::Vector2(
             static_cast<float>( pos.x ),
@@ -19,6 +27,11 @@ util::vec::Vector2 getMousePos() {
 
 bool mousePressed(sf::Mouse::Button button) {
 
+    if (systemSettings.isHeadless()) {
+
+        return false;
+    }
+
     return sf::Mouse::isButtonPressed(button);
 }
 
@@ -0,0 +1,249 @@
+#include "Replay.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdint.h>
+
+namespace omi {
+
+namespace replay {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// identifies replay files
+static const char MAGIC[4] = { 'O', 'M', 'I', 'R' };
+// the version of the file format
+static const uint32_t VERSION = 1;
+// the number of bytes used to store the state of the keyboard
+static const unsigned KEY_BYTES = 16;
+// the flag that is set when a tick contains a new key mask
+static const uint8_t KEYS_CHANGED = 1;
+
+static_assert(sf::Keyboard::KeyCount <= KEY_BYTES * 8,
+    "the key mask is too small for the number of keyboard keys");
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+// the current mode
+Mode mode = OFF;
+// the file being recorded to
+std::ofstream output;
+// the file being played back
+std::ifstream input;
+
+// if a tick has started
+bool inTick = false;
+// the delta time of the current tick
+float tickDelta = 0.0f;
+// the keys that are pressed in the current tick
+uint8_t keys[KEY_BYTES];
+// the keys that were pressed in the last tick that was written
+uint8_t lastKeys[KEY_BYTES];
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** Writes the current tick to the output file */
+void writeTick() {
+
+    uint8_t flags = 0;
+    if (memcmp(keys, lastKeys, KEY_BYTES) != 0) {
+
+        flags |= KEYS_CHANGED;
+    }
+
+    output.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    output.write(reinterpret_cast<const char*>(&tickDelta), sizeof(tickDelta));
+    if (flags & KEYS_CHANGED) {
+
+        output.write(reinterpret_cast<const char*>(keys), KEY_BYTES);
+        memcpy(lastKeys, keys, KEY_BYTES);
+    }
+}
+
+/** Reads the next tick from the input file
+@return if a tick could be read */
+bool readTick() {
+
+    uint8_t flags = 0;
+    input.read(reinterpret_cast<char*>(&flags), sizeof(flags));
+    input.read(reinterpret_cast<char*>(&tickDelta), sizeof(tickDelta));
+    if (flags & KEYS_CHANGED) {
+
+        input.read(reinterpret_cast<char*>(keys), KEY_BYTES);
+    }
+
+    return input.good();
+}
+
+/** Called at exit so that the final tick of a recording is written */
+void finishAtExit() {
+
+    finish();
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool record(const std::string& filePath, unsigned seed) {
+
+    finish();
+
+    output.open(filePath.c_str(), std::ios::out | std::ios::binary);
+    if (!output.is_open()) {
+
+        std::cout << "unable to open replay file for recording: " <<
+            filePath << std::endl;
+        return false;
+    }
+
+    // write the header
+    uint32_t s = seed;
+    output.write(MAGIC, sizeof(MAGIC));
+    output.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    output.write(reinterpret_cast<const char*>(&s), sizeof(s));
+
+    memset(keys, 0, KEY_BYTES);
+    memset(lastKeys, 0, KEY_BYTES);
+    inTick = false;
+    mode = RECORD;
+
+    // make sure the last tick is written however the process exits
+    static bool registered = false;
+    if (!registered) {
+
+        atexit(finishAtExit);
+        registered = true;
+    }
+
+    return true;
+}
+
+bool play(const std::string& filePath, unsigned& seed) {
+
+    finish();
+
+    input.open(filePath.c_str(), std::ios::in | std::ios::binary);
+    if (!input.is_open()) {
+
+        std::cout << "unable to open replay file: " << filePath << std::endl;
+        return false;
+    }
+
+    // read and check the header
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    uint32_t s = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&s), sizeof(s));
+    if (!input.good() || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        version != VERSION) {
+
+        std::cout << "invalid replay file: " << filePath << std::endl;
+        input.close();
+        return false;
+    }
+
+    seed = s;
+    memset(keys, 0, KEY_BYTES);
+    mode = PLAYBACK;
+
+    return true;
+}
+
+void finish() {
+
+    if (mode == RECORD) {
+
+        if (inTick) {
+
+            writeTick();
+        }
+        output.close();
+    }
+    else if (mode == PLAYBACK) {
+
+        input.close();
+    }
+
+    inTick = false;
+    mode = OFF;
+}
+
+Mode getMode() {
+
+    return mode;
+}
+
+float tick(float delta) {
+
+    if (mode == RECORD) {
+
+        // write out the tick that has just finished
+        if (inTick) {
+
+            writeTick();
+        }
+        inTick = true;
+        tickDelta = delta;
+        memset(keys, 0, KEY_BYTES);
+
+        return delta;
+    }
+    else if (mode == PLAYBACK) {
+
+        if (!readTick()) {
+
+            std::cout << "replay complete" << std::endl;
+            finish();
+            exit(0);
+        }
+
+        return tickDelta;
+    }
+
+    return delta;
+}
+
+bool filterKey(sf::Keyboard::Key key, bool pressed) {
+
+    if (key < 0 || key >= sf::Keyboard::KeyCount) {
+
+        return pressed;
+    }
+
+    unsigned byte = static_cast<unsigned>(key) / 8;
+    uint8_t bit = static_cast<uint8_t>(1 << (static_cast<unsigned>(key) % 8));
+
+    if (mode == RECORD) {
+
+        if (pressed) {
+
+            keys[byte] |= bit;
+        }
+        return pressed;
+    }
+    else if (mode == PLAYBACK) {
+
+        return (keys[byte] & bit) != 0;
+    }
+
+    return pressed;
+}
+
+} // namespace replay
+
+} // namespace omi
@@ -0,0 +1,76 @@
+#ifndef OMICRON_INPUT_REPLAY_H_
+#   define OMICRON_INPUT_REPLAY_H_
+
+#include <string>
+
+#include <SFML/Window.hpp>
+
+namespace omi {
+
+/****************************************************************************\
+| Records the keyboard state, random seed, and frame deltas of a run to a    |
+| compact binary file so that the run can be played back exactly. While      |
+| playing back the recorded input and deltas are used in place of the live   |
+| keyboard and clock.                                                        |
+|                                                                            |
+| The file begins with a header of the magic "OMIR", the format version, and |
+| the random seed. Each tick is then stored as a flags byte and the delta    |
+| time in milliseconds, followed by a 16 byte key mask if the keys changed   |
+| since the previous tick.                                                   |
+\****************************************************************************/
+namespace replay {
+
+//------------------------------------------------------------------------------
+//                                  ENUMERATORS
+//------------------------------------------------------------------------------
+
+//! the modes the replay system can be in
+enum Mode {
+
+    OFF,      // input is read live and nothing is recorded
+    RECORD,   // input is read live and recorded to a file
+    PLAYBACK  // input is read from a file
+};
+
+//------------------------------------------------------------------------------
+//                                   PROTOTYPES
+//------------------------------------------------------------------------------
+
+/** Begins recording to the given file
+@param filePath the path to the file to record to
+@param seed the seed the random number generator will be seeded with
+@return if the file could be opened for writing */
+bool record(const std::string& filePath, unsigned seed);
+
+/** Begins playing back the given file
+@param filePath the path to the file to play back
+@param seed returns the seed the random number generator must be seeded with
+@return if the file could be opened and is a valid recording */
+bool play(const std::string& filePath, unsigned& seed);
+
+/** Writes any remaining recorded data and stops recording or playing back */
+void finish();
+
+/** @return the current replay mode */
+Mode getMode();
+
+/** #Hidden
+Moves to the next tick. When recording the last tick is written out, when
+playing back the next tick is read and the process exits once the recording
+runs out.
+@param delta the live delta time of this tick in milliseconds
+@return the delta time to use for this tick in milliseconds */
+float tick(float delta);
+
+/** #Hidden
+Filters the state of a key through the replay system
+@param key the key that is being checked
+@param pressed if the key is currently pressed on the live keyboard
+@return if the key should be considered pressed */
+bool filterKey(sf::Keyboard::Key key, bool pressed);
+
+} // namespace replay
+
+} // namespace omi
+
+#endif
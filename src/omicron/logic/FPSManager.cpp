@@ -1,5 +1,7 @@
 #include "FPSManager.hpp"
 
+#include "src/omicron/input/Replay.hpp"
+
 namespace omi {
 
 namespace {
@@ -20,7 +22,10 @@ static const float STD_FRAME_LENGTH = 16.0f;
 FPSManager::FPSManager() :
     m_timeScale     (1.0f),
     m_fps           (0.0f),
-    m_lastUpdateTime(util::time::getCurrentTime()) {
+    m_deltaTime     (0.0f),
+    m_fixedTick     (0.0f),
+    m_lastUpdateTime(util::time::getMonotonicTime()),
+    m_time          (0) {
 }
 
 //------------------------------------------------------------------------------
@@ -37,11 +42,20 @@ FPSManager::~FPSManager() {
 void FPSManager::update() {
 
     // get current time
-    int64_t currentTime = util::time::getCurrentTime();
+    util::int64 currentTime = util::time::getMonotonicTime();
     // find delta time
-    float deltaTime = static_cast<float>(currentTime - m_lastUpdateTime);
+    float deltaTime = util::time::nsToMs(currentTime - m_lastUpdateTime);
+    if (m_fixedTick > 0.0f) {
+
+        deltaTime = m_fixedTick;
+    }
+    // recordings store the delta time so that they play back identically
+    deltaTime = replay::tick(deltaTime);
     // set the new last update time
     m_lastUpdateTime = currentTime;
+    m_deltaTime = deltaTime;
+    // advance the engine time
+    m_time += util::time::msToNs(deltaTime);
 
     // calculate the time scale
     m_timeScale = deltaTime / STD_FRAME_LENGTH;
@@ -52,7 +66,7 @@ void FPSManager::update() {
 
 void FPSManager::zero() {
 
-    m_lastUpdateTime = util::time::getCurrentTime();
+    m_lastUpdateTime = util::time::getMonotonicTime();
 }
 
 
@@ -66,4 +80,24 @@ float FPSManager::getFPS() {
     return m_fps;
 }
 
+float FPSManager::getDeltaTime() const {
+
+    return m_deltaTime;
+}
+
+util::int64 FPSManager::getTime() const {
+
+    return m_time;
+}
+
+float FPSManager::getFixedTick() const {
+
+    return m_fixedTick;
+}
+
+void FPSManager::setFixedTick(float tick) {
+
+    m_fixedTick = tick;
+}
+
 } // namespace omi
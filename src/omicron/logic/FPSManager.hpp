@@ -54,6 +54,25 @@ public:
     /** @return the current fps */
     float getFPS();
 
+    /** @return the length of the last tick in milliseconds */
+    float getDeltaTime() const;
+
+    /** @return the engine time at the start of the current tick in
+    nanoseconds. This is advanced by the length of each tick so it is cheap to
+    read, never goes backwards, and follows fixed ticks and replays. */
+    util::int64 getTime() const;
+
+    /** @return the fixed length of each tick in milliseconds, 0 if the length
+    of each tick is measured from the clock */
+    float getFixedTick() const;
+
+    /** Sets every tick to be a fixed length rather than measuring the time
+    between ticks. This allows runs to be simulated faster or slower than real
+    time.
+    @param tick the length of each tick in milliseconds, or 0 to measure the
+                length of each tick from the clock */
+    void setFixedTick(float tick);
+
 private:
 
     //--------------------------------------------------------------------------
@@ -64,9 +83,15 @@ private:
     float m_timeScale;
     // the current fps
     float m_fps;
+    // the length of the last tick in milliseconds
+    float m_deltaTime;
+    // the fixed length of each tick, 0 if ticks are measured from the clock
+    float m_fixedTick;
 
-    //the last time a logic cycle of the engine ran
+    // the monotonic time the last logic cycle of the engine ran in nanoseconds
     util::int64 m_lastUpdateTime;
+    // the engine time at the start of the current tick in nanoseconds
+    util::int64 m_time;
 };
 
 } //namespace omi
@@ -0,0 +1,234 @@
+#include "JobSystem.hpp"
+
+#include "src/omicron/debug/Profiler.hpp"
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+JobSystem::JobSystem(unsigned workers) :
+    m_workerCount(0),
+    m_running    (false),
+    m_queued     (0),
+    m_pending    (0) {
+
+    setWorkerCount(workers);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+JobSystem::~JobSystem() {
+
+    stop();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void JobSystem::setWorkerCount(unsigned workers) {
+
+    stop();
+
+    if (workers == 0) {
+
+        unsigned hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 0;
+    }
+    m_workerCount = workers;
+}
+
+unsigned JobSystem::getThreadCount() const {
+
+    return m_workerCount + 1;
+}
+
+void JobSystem::run(const std::vector<Job>& jobs) {
+
+    if (jobs.empty()) {
+
+        return;
+    }
+
+    // with no workers just run the jobs on this thread
+    if (m_workerCount == 0) {
+
+        for (std::vector<Job>::const_iterator it = jobs.begin();
+             it != jobs.end(); ++it) {
+
+            (*it)();
+        }
+        return;
+    }
+
+    start();
+
+    // deal the jobs out between all the queues
+    m_pending += jobs.size();
+    for (unsigned i = 0; i < jobs.size(); ++i) {
+
+        WorkQueue& queue = *m_queues[i % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(jobs[i]);
+        ++m_queued;
+    }
+
+    // wake up the workers
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wake.notify_all();
+
+    // work on the jobs from this thread until they are all complete
+    while (m_pending > 0) {
+
+        Job job;
+        if (take(0, job)) {
+
+            job();
+            --m_pending;
+        }
+        else {
+
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(
+        unsigned count,
+        unsigned grain,
+        const std::function<void (unsigned)>& f) {
+
+    if (grain == 0) {
+
+        grain = 1;
+    }
+
+    // split the range into jobs
+    std::vector<Job> jobs;
+    jobs.reserve((count / grain) + 1);
+    for (unsigned begin = 0; begin < count; begin += grain) {
+
+        unsigned end = begin + grain < count ? begin + grain : count;
+        jobs.push_back([begin, end, &f] () {
+
+            OMI_PROFILE_SCOPE("JobSystem::parallelFor");
+
+            for (unsigned i = begin; i < end; ++i) {
+
+                f(i);
+            }
+        });
+    }
+
+    run(jobs);
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void JobSystem::start() {
+
+    if (m_running) {
+
+        return;
+    }
+
+    m_running = true;
+    m_queues.clear();
+    for (unsigned i = 0; i < m_workerCount + 1; ++i) {
+
+        m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+    for (unsigned i = 1; i < m_workerCount + 1; ++i) {
+
+        m_threads.push_back(std::thread(&JobSystem::workerLoop, this, i));
+    }
+}
+
+void JobSystem::stop() {
+
+    if (!m_running) {
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+
+    for (std::vector<std::thread>::iterator it = m_threads.begin();
+         it != m_threads.end(); ++it) {
+
+        it->join();
+    }
+    m_threads.clear();
+    m_queues.clear();
+}
+
+bool JobSystem::take(unsigned index, Job& job) {
+
+    // take the most recent job from our own queue
+    {
+        WorkQueue& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            --m_queued;
+            return true;
+        }
+    }
+
+    // steal the oldest job from another queue
+    for (unsigned i = 1; i < m_queues.size(); ++i) {
+
+        WorkQueue& other = *m_queues[(index + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.jobs.empty()) {
+
+            job = other.jobs.front();
+            other.jobs.pop_front();
+            --m_queued;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::workerLoop(unsigned index) {
+
+    while (true) {
+
+        Job job;
+        if (take(index, job)) {
+
+            job();
+            --m_pending;
+            continue;
+        }
+
+        // sleep until there are jobs or we are stopped
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait(lock, [this] () {
+
+            return !m_running || m_queued > 0;
+        });
+        if (!m_running) {
+
+            return;
+        }
+    }
+}
+
+} // namespace omi
@@ -0,0 +1,143 @@
+#ifndef OMICRON_LOGIC_JOBSYSTEM_H_
+#   define OMICRON_LOGIC_JOBSYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+
+namespace omi {
+
+/*****************************************************************************\
+| Runs jobs across a pool of worker threads. Each thread owns a queue of jobs |
+| and once its own queue is empty it steals jobs from the other queues. The   |
+| thread that submits jobs also works on them until they are all complete.    |
+\*****************************************************************************/
+class JobSystem {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(JobSystem);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                  TYPEDEFS
+    //--------------------------------------------------------------------------
+
+    //! a single unit of work
+    typedef std::function<void ()> Job;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new job system, worker threads are not started until jobs
+    are first run
+    @param workers the number of worker threads to use, if 0 one less than the
+                   number of hardware threads is used */
+    JobSystem(unsigned workers = 0);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~JobSystem();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Sets the number of worker threads to use. This will stop any workers
+    that are running.
+    @param workers the number of worker threads, if 0 one less than the number
+                   of hardware threads is used */
+    void setWorkerCount(unsigned workers);
+
+    /** @return the number of threads that work on jobs, including the thread
+    that submits them */
+    unsigned getThreadCount() const;
+
+    /** Runs the given jobs and waits for them all to complete
+    @param jobs the jobs to run */
+    void run(const std::vector<Job>& jobs);
+
+    /** Calls the given function once for every index in [0, count) spread
+    across the worker threads and waits for all calls to complete
+    @param count the number of indices
+    @param grain the number of indices that are processed by a single job
+    @param f the function to call with each index */
+    void parallelFor(
+            unsigned count,
+            unsigned grain,
+            const std::function<void (unsigned)>& f);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    // the queue of jobs owned by a single thread
+    struct WorkQueue {
+
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the number of worker threads to run
+    unsigned m_workerCount;
+    // the queues of each thread, the submitting thread uses the first queue
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    // the worker threads
+    std::vector<std::thread> m_threads;
+
+    // whether the workers should keep running
+    std::atomic<bool> m_running;
+    // the number of jobs waiting in queues
+    std::atomic<unsigned> m_queued;
+    // the number of jobs that have not been completed
+    std::atomic<unsigned> m_pending;
+
+    // used to wake workers when there are jobs
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Starts the worker threads if they are not running */
+    void start();
+
+    /** Stops and joins the worker threads */
+    void stop();
+
+    /** Takes a job from the given thread's own queue, or steals one from
+    another thread's queue if its own is empty
+    @param index the index of the thread looking for work
+    @param job returns the job that was found
+    @return if a job was found */
+    bool take(unsigned index, Job& job);
+
+    /** The main loop of a worker thread
+    @param index the index of the worker's queue */
+    void workerLoop(unsigned index);
+};
+
+} // namespace omi
+
+#endif
@@ -2,6 +2,11 @@
 
 #include <iostream>
 
+#include "src/omicron/audio/Audio.hpp"
+#include "src/omicron/audio/SoundPool.hpp"
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
@@ -26,6 +31,8 @@ LogicManager::~LogicManager() {
 
 bool LogicManager::execute() {
 
+    OMI_PROFILE_SCOPE("LogicManager::execute");
+
     // initialise a new scene
     if (m_sceneInit) {
 
@@ -51,19 +58,28 @@ bool LogicManager::execute() {
         return true;
     } else {
 
+        static const unsigned updatableCounter =
+            counters::get("components.updatable", counters::GAUGE);
+        counters::set(updatableCounter, m_components.size());
+
         // update components
         for (std::vector<Updatable*>::iterator it = m_components.begin();
              it != m_components.end(); ++it) {
 
             (*it)->update();
         }
+
+        // start the sounds requested during the update and move the audio
+        // clock on to the end of the cycle
+        SoundPool::update();
+        audio::advance(fpsManager.getDeltaTime());
     }
 
 
     return false;
 }
 
-std::set<Component*>& LogicManager::getNewComponents() {
+std::vector<Component*>& LogicManager::getNewComponents() {
 
     return m_scene->newComponents;
 }
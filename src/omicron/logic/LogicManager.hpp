@@ -48,7 +48,7 @@ public:
     bool execute();
 
     /** @return the new components from the scene */
-    std::set<Component*>& getNewComponents();
+    std::vector<Component*>& getNewComponents();
 
     /** @return the components to be removed from the scene */
     std::vector<Component*>& getRemoveComponents();
@@ -1,7 +1,23 @@
 #include "CollisionDetect.hpp"
 
+#include <algorithm>
+
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+
 namespace omi {
 
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+// the counters of the number of detectors in each group
+std::map<std::string, unsigned> groupCounters;
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                   VARIABLES
 //------------------------------------------------------------------------------
@@ -10,6 +26,15 @@ std::vector<CollisionDetector*> CollisionDetect::m_detectors;
 std::map<std::string, std::vector<CollisionDetector*>>
         CollisionDetect::m_groups;
 std::vector<CheckPair> CollisionDetect::m_check;
+std::vector<CollisionDetect::Contact> CollisionDetect::m_contacts;
+std::vector<CollisionDetect::Contact> CollisionDetect::m_newContacts;
+std::vector<std::pair<collision::Phase, CollisionDetect::Contact>>
+        CollisionDetect::m_events;
+std::vector<CollisionDetect::Handler> CollisionDetect::m_handlers;
+std::vector<CollisionDetect::Handler> CollisionDetect::m_addedHandlers;
+bool CollisionDetect::m_dispatching = false;
+unsigned CollisionDetect::m_nextHandlerId = 0;
+unsigned CollisionDetect::m_nextSerial = 0;
 
 //------------------------------------------------------------------------------
 //                            PUBLIC MEMBER FUNCTIONS
@@ -17,14 +42,77 @@ std::vector<CheckPair> CollisionDetect::m_check;
 
 void CollisionDetect::checkGroup(const std::string& a, const std::string& b) {
 
-    // TODO: check pair doesn't already exists
-    CheckPair pair;
-    pair.a = a;
-    pair.b = b;
-    m_check.push_back(pair);
+    findCheck(a, b);
+}
+
+unsigned CollisionDetect::addHandler(
+        const std::string&      a,
+        const std::string&      b,
+              int               phases,
+        const CollisionHandler& handler) {
+
+    Handler h;
+    h.id       = m_nextHandlerId++;
+    h.check    = findCheck(a, b);
+    h.phases   = phases;
+    h.function = handler;
+    h.active   = true;
+
+    // adding to the handlers could move the one that is being called
+    if (m_dispatching) {
+
+        m_addedHandlers.push_back(h);
+    }
+    else {
+
+        m_handlers.push_back(h);
+    }
+
+    return h.id;
+}
+
+void CollisionDetect::removeHandler(unsigned id) {
+
+    for (std::vector<Handler>::iterator it = m_addedHandlers.begin();
+         it != m_addedHandlers.end(); ++it) {
+
+        if (it->id == id) {
+
+            m_addedHandlers.erase(it);
+            return;
+        }
+    }
+
+    for (std::vector<Handler>::iterator it = m_handlers.begin();
+         it != m_handlers.end(); ++it) {
+
+        if (it->id == id) {
+
+            // the handler may be the one being called, so it is only removed
+            // once dispatching has finished
+            if (m_dispatching) {
+
+                it->active = false;
+            }
+            else {
+
+                m_handlers.erase(it);
+            }
+            return;
+        }
+    }
 }
 
 void CollisionDetect::update() {
+
+    OMI_PROFILE_SCOPE("CollisionDetect::update");
+
+    static const unsigned detectorCounter =
+        counters::get("components.collision", counters::GAUGE);
+    static const unsigned pairCounter =
+        counters::get("collision.pairs", counters::PER_FRAME);
+    static const unsigned hitCounter =
+        counters::get("collision.hits", counters::PER_FRAME);
     
     m_groups.clear();
 
@@ -44,32 +132,96 @@ void CollisionDetect::update() {
         m_groups[group].push_back(*detector);
     }
 
+    // count the detectors in each group, groups that have emptied are zeroed
+    counters::set(detectorCounter, m_detectors.size());
+    for (std::map<std::string, std::vector<CollisionDetector*>>::iterator it =
+         m_groups.begin(); it != m_groups.end(); ++it) {
+
+        if (groupCounters.find(it->first) == groupCounters.end()) {
+
+            groupCounters.insert(std::make_pair(it->first, counters::get(
+                "collision.group." + it->first, counters::GAUGE)));
+        }
+    }
+    for (std::map<std::string, unsigned>::iterator it = groupCounters.begin();
+         it != groupCounters.end(); ++it) {
+
+        std::map<std::string, std::vector<CollisionDetector*>>::iterator
+            group = m_groups.find(it->first);
+        counters::set(it->second,
+            group == m_groups.end() ? 0 : group->second.size());
+    }
+
     // go over each check pair
-    for (std::vector<CheckPair>::iterator it = m_check.begin();
-         it != m_check.end(); ++it) {
+    m_newContacts.clear();
+    unsigned pairs = 0;
+    for (unsigned check = 0; check < m_check.size(); ++check) {
+
+        std::vector<CollisionDetector*>& groupA = m_groups[m_check[check].a];
+        std::vector<CollisionDetector*>& groupB = m_groups[m_check[check].b];
 
         // go over each item in the first group
-        for (std::vector<CollisionDetector*>::iterator first = 
-            m_groups[it->a].begin();
-            first != m_groups[it->a].end(); ++first) {
+        for (std::vector<CollisionDetector*>::iterator first = groupA.begin();
+             first != groupA.end(); ++first) {
 
             // go over each item in the second groups
-            for (std::vector<CollisionDetector*>::iterator second = 
-                m_groups[it->b].begin();
-                second != m_groups[it->b].end(); ++second) {
+            for (std::vector<CollisionDetector*>::iterator second =
+                 groupB.begin(); second != groupB.end(); ++second) {
 
-                // perform collision detection
-                if (first != second) {
+                if (*first == *second) {
+
+                    continue;
+                }
 
-                    processDetectors(*first, *second);
+                // perform collision detection
+                ++pairs;
+                if (processDetectors(*first, *second)) {
+
+                    Contact contact;
+                    contact.check = check;
+                    contact.a     = *first;
+                    contact.b     = *second;
+                    m_newContacts.push_back(contact);
                 }
             }
-        } 
+        }
+    }
+
+    counters::add(pairCounter, pairs);
+    counters::add(hitCounter, m_newContacts.size());
+
+    // compare against last frame's contacts to find the phase of each one
+    std::sort(m_newContacts.begin(), m_newContacts.end());
+    std::vector<Contact>::iterator previous = m_contacts.begin();
+    std::vector<Contact>::iterator current  = m_newContacts.begin();
+    while (previous != m_contacts.end() || current != m_newContacts.end()) {
+
+        if (current == m_newContacts.end() ||
+            (previous != m_contacts.end() && *previous < *current)) {
+
+            queueEvent(collision::END, *previous);
+            ++previous;
+        }
+        else if (previous == m_contacts.end() || *current < *previous) {
+
+            queueEvent(collision::BEGIN, *current);
+            ++current;
+        }
+        else {
+
+            queueEvent(collision::PERSIST, *current);
+            ++previous;
+            ++current;
+        }
     }
+    m_contacts.swap(m_newContacts);
+
+    dispatchEvents();
 }
 
 void CollisionDetect::addDetector(CollisionDetector* detector) {
 
+    detector->setSerial(m_nextSerial++);
     m_detectors.push_back(detector);
 
     // std::string group = detector->getGroup();
@@ -86,6 +238,22 @@ void CollisionDetect::addDetector(CollisionDetector* detector) {
 
 void CollisionDetect::removeDetector(CollisionDetector* detector) {
 
+   // end any contacts the detector was part of while its owner still exists
+   for (std::vector<Contact>::iterator it = m_contacts.begin();
+        it != m_contacts.end();) {
+
+       if (it->a == detector || it->b == detector) {
+
+           queueEvent(collision::END, *it);
+           it = m_contacts.erase(it);
+       }
+       else {
+
+           ++it;
+       }
+   }
+   dispatchEvents();
+
    for (std::vector<CollisionDetector*>::iterator it = m_detectors.begin();
         it != m_detectors.end();) {
 
@@ -104,15 +272,51 @@ void CollisionDetect::clear() {
 
     m_check.clear();
     m_groups.clear();
+    m_contacts.clear();
+    m_events.clear();
+    m_addedHandlers.clear();
+    if (m_dispatching) {
+
+        for (std::vector<Handler>::iterator it = m_handlers.begin();
+             it != m_handlers.end(); ++it) {
+
+            it->active = false;
+        }
+    }
+    else {
+
+        m_handlers.clear();
+    }
 }
 
 //------------------------------------------------------------------------------
 //                            PRIVATE MEMBER FUNCTIOSN
 //------------------------------------------------------------------------------
 
-void CollisionDetect::processDetectors(
+unsigned CollisionDetect::findCheck(
+        const std::string& a, const std::string& b) {
+
+    for (unsigned i = 0; i < m_check.size(); ++i) {
+
+        if (m_check[i].a == a && m_check[i].b == b) {
+
+            return i;
+        }
+    }
+
+    CheckPair pair;
+    pair.a = a;
+    pair.b = b;
+    m_check.push_back(pair);
+
+    return m_check.size() - 1;
+}
+
+bool CollisionDetect::processDetectors(
     CollisionDetector* a, CollisionDetector* b) {
 
+    bool touching = false;
+
     // iterate over each bounding in the first detector
     for (std::vector<std::unique_ptr<BoundingShape>>::iterator first =
          a->m_boundings.begin(); first != a->m_boundings.end(); ++first) {
@@ -126,9 +330,69 @@ void CollisionDetect::processDetectors(
 
                 // pass data back to the detector
                 a->detected(b->getOwner(), b->getGroup());
+                touching = true;
+            }
+        }
+    }
+
+    return touching;
+}
+
+void CollisionDetect::queueEvent(
+        collision::Phase phase, const Contact& contact) {
+
+    // only queue events that something is listening for
+    for (std::vector<Handler>::iterator it = m_handlers.begin();
+         it != m_handlers.end(); ++it) {
+
+        if (it->check == contact.check && (it->phases & phase)) {
+
+            m_events.push_back(std::make_pair(phase, contact));
+            return;
+        }
+    }
+}
+
+void CollisionDetect::dispatchEvents() {
+
+    m_dispatching = true;
+    for (unsigned i = 0; i < m_events.size(); ++i) {
+
+        CollisionEvent event;
+        event.phase  = m_events[i].first;
+        event.a      = m_events[i].second.a;
+        event.b      = m_events[i].second.b;
+        event.ownerA = event.a->getOwner();
+        event.ownerB = event.b->getOwner();
+
+        // handlers removed or added while dispatching don't change the
+        // vector, so it is safe to iterate
+        for (std::vector<Handler>::iterator it = m_handlers.begin();
+             it != m_handlers.end(); ++it) {
+
+            if (it->active && it->check == m_events[i].second.check &&
+                (it->phases & event.phase)) {
+
+                it->function(event);
             }
         }
     }
+    m_events.clear();
+    m_dispatching = false;
+
+    // remove the handlers that were removed while dispatching and register
+    // those that were added
+    m_handlers.erase(
+        std::remove_if(m_handlers.begin(), m_handlers.end(), isInactive),
+        m_handlers.end());
+    m_handlers.insert(
+        m_handlers.end(), m_addedHandlers.begin(), m_addedHandlers.end());
+    m_addedHandlers.clear();
+}
+
+bool CollisionDetect::isInactive(const Handler& handler) {
+
+    return !handler.active;
 }
 
 bool CollisionDetect::checkCollision(BoundingShape* a, BoundingShape* b) {
@@ -140,11 +404,13 @@ bool CollisionDetect::checkCollision(BoundingShape* a, BoundingShape* b) {
 
 bool CollisionDetect::checkCircleCircle(BoundingCircle* a, BoundingCircle* b) {
 
-    // check if circles are colliding
-    float distance = util::vec::distance(
-        a->getTransform()->translation, b->getTransform()->translation);
+    // check if circles are colliding, comparing squared lengths
+    float distanceSquared = util::vec::distanceSquared(
+        a->getTransform()->computeTranslation(),
+        b->getTransform()->computeTranslation());
+    float radii = a->getRadius() + b->getRadius();
 
-    return distance <= a->getRadius() + b->getRadius();
+    return distanceSquared <= radii * radii;
 }
 
 } // namespace omi
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef OMICRON_PHYSICS_COLLISION_DETECT_COLLISIONDETECT_H_
 #   define OMICRON_PHYSICS_COLLISION_DETECT_COLLISIONDETECT_H_
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -17,6 +19,39 @@ struct CheckPair {
     std::string b;
 };
 
+namespace collision {
+
+//! the phases of a contact between two detectors
+enum Phase {
+
+    BEGIN   = 1, // the detectors started touching this frame
+    PERSIST = 2, // the detectors were already touching last frame
+    END     = 4  // the detectors stopped touching this frame
+};
+
+} // namespace collision
+
+/******************************************************************\
+| Describes the contact between a detector from the first group of |
+| a check pair and a detector from the second group.               |
+\******************************************************************/
+struct CollisionEvent {
+
+    //! the phase of the contact
+    collision::Phase phase;
+    //! the detector from the first group
+    CollisionDetector* a;
+    //! the detector from the second group
+    CollisionDetector* b;
+    //! the entity that owns the detector from the first group
+    void* ownerA;
+    //! the entity that owns the detector from the second group
+    void* ownerB;
+};
+
+//! a function that is called with collision events
+typedef std::function<void (const CollisionEvent&)> CollisionHandler;
+
 /**************************************************\
 | Used for detecting collisions between boundings. |
 \**************************************************/
@@ -42,6 +77,24 @@ public:
 
     // TODO: remove groups check
 
+    /** Registers a handler to be called for contacts between detectors from
+    group a and detectors from group b. The groups will be checked against each
+    other if they aren't already.
+    @param a the first group
+    @param b the second group
+    @param phases the phases to call the handler for, ored together
+    @param handler the function to call with each event
+    @return the id of the handler that is used to remove it */
+    static unsigned addHandler(
+            const std::string&      a,
+            const std::string&      b,
+                  int               phases,
+            const CollisionHandler& handler);
+
+    /** Removes a collision handler
+    @param id the id of the handler that was returned when it was added */
+    static void removeHandler(unsigned id);
+
     /** #Hidden
     Performs collision group detection for a frame */
     static void update();
@@ -52,11 +105,51 @@ public:
     /** @param detector collision detector to remove */
     static void removeDetector(CollisionDetector* detector);
 
-    /** Clears all bounding groups  */
+    /** Clears all bounding groups, contacts, and handlers */
     static void clear();
 
 private:
 
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    // a pair of detectors that are touching
+    struct Contact {
+
+        // the index of the check pair the contact was found by
+        unsigned check;
+        CollisionDetector* a;
+        CollisionDetector* b;
+
+        // contacts are ordered by the order the detectors were added rather
+        // than by address so that events are dispatched in the same order
+        // every run
+        bool operator <(const Contact& other) const {
+
+            if (check != other.check) {
+
+                return check < other.check;
+            }
+            if (a != other.a) {
+
+                return a->getSerial() < other.a->getSerial();
+            }
+            return b->getSerial() < other.b->getSerial();
+        }
+    };
+
+    // a registered collision handler
+    struct Handler {
+
+        unsigned id;
+        unsigned check;
+        int phases;
+        CollisionHandler function;
+        // false once the handler has been removed while dispatching
+        bool active;
+    };
+
     //--------------------------------------------------------------------------
     //                                 VARIABLES
     //--------------------------------------------------------------------------
@@ -67,13 +160,45 @@ private:
     static std::map<std::string, std::vector<CollisionDetector*>> m_groups;
     // groups to check
     static std::vector<CheckPair> m_check;
+    // the sorted contacts from the last frame
+    static std::vector<Contact> m_contacts;
+    // the contacts being found this frame
+    static std::vector<Contact> m_newContacts;
+    // the phases and contacts of the events waiting to be dispatched
+    static std::vector<std::pair<collision::Phase, Contact>> m_events;
+    // the registered handlers
+    static std::vector<Handler> m_handlers;
+    // handlers added while dispatching, they are registered once it ends
+    static std::vector<Handler> m_addedHandlers;
+    // if events are being dispatched
+    static bool m_dispatching;
+    // the id of the next handler
+    static unsigned m_nextHandlerId;
+    // the serial to give the next detector that is added
+    static unsigned m_nextSerial;
 
     //--------------------------------------------------------------------------
     //                          PRIVATE MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    /** Process collision detection between two detectors */
-    static void processDetectors(CollisionDetector* a, CollisionDetector* b);
+    /** @return the index of the check pair for the two groups, adding the
+    pair if it doesn't exist */
+    static unsigned findCheck(const std::string& a, const std::string& b);
+
+    /** Process collision detection between two detectors
+    @return if the detectors are touching */
+    static bool processDetectors(CollisionDetector* a, CollisionDetector* b);
+
+    /** Queues an event to be dispatched
+    @param phase the phase of the contact
+    @param contact the contact */
+    static void queueEvent(collision::Phase phase, const Contact& contact);
+
+    /** Calls the handlers of all queued events and clears the queue */
+    static void dispatchEvents();
+
+    /** @return if the handler was removed while dispatching */
+    static bool isInactive(const Handler& handler);
 
     /** Checks if two boundings are colliding */
     static bool checkCollision(BoundingShape* a, BoundingShape* b);
@@ -0,0 +1,359 @@
+#include "FrameCapture.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <SFML/Graphics/Image.hpp>
+
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+FrameCapture::FrameCapture(
+        const std::string&    directory,
+              capture::Format format) :
+    m_directory  (directory),
+    m_format     (format),
+    m_active     (true),
+    m_show       (true),
+    m_created    (false),
+    m_framebuffer(0),
+    m_colour     (0),
+    m_depth      (0),
+    m_width      (0),
+    m_height     (0),
+    m_read       (0),
+    m_mapped     (0),
+    m_quit       (false),
+    m_written    (0) {
+
+    std::fill(m_buffers, m_buffers + LATENCY, 0);
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/') {
+
+        m_directory += '/';
+    }
+
+    m_thread = std::thread(&FrameCapture::run, this);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+FrameCapture::~FrameCapture() {
+
+    finish();
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void FrameCapture::begin() {
+
+    OMI_PROFILE_SCOPE("FrameCapture::begin");
+
+    if (!m_active) {
+
+        return;
+    }
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    unsigned width = static_cast<unsigned>(viewport[2]);
+    unsigned height = static_cast<unsigned>(viewport[3]);
+
+    if (!m_created || width != m_width || height != m_height) {
+
+        // the reads in flight are the old size so map them before resizing
+        while (m_mapped < m_read) {
+
+            map();
+        }
+        destroy();
+        if (!create(width, height)) {
+
+            destroy();
+            m_active = false;
+            return;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+}
+
+void FrameCapture::end() {
+
+    OMI_PROFILE_SCOPE("FrameCapture::end");
+
+    static const unsigned frameCounter =
+        counters::get("capture.frames", counters::PER_FRAME);
+
+    if (!m_active || !m_created) {
+
+        return;
+    }
+
+    // show the frame in the window
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    if (m_show) {
+
+        glBlitFramebuffer(
+            0, 0, m_width, m_height, 0, 0, m_width, m_height,
+            GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    // the read using the next buffer is LATENCY frames old so it will have
+    // finished and can be mapped without waiting
+    if (m_read - m_mapped >= LATENCY) {
+
+        map();
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[m_read % LATENCY]);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    ++m_read;
+    counters::add(frameCounter);
+}
+
+void FrameCapture::finish() {
+
+    if (m_created) {
+
+        while (m_mapped < m_read) {
+
+            map();
+        }
+        destroy();
+    }
+    m_active = false;
+
+    if (m_thread.joinable()) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+    }
+}
+
+unsigned long long FrameCapture::getWritten() const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_written;
+}
+
+const std::string& FrameCapture::getDirectory() const {
+
+    return m_directory;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool FrameCapture::create(unsigned width, unsigned height) {
+
+    if (!GLEW_ARB_framebuffer_object || !GLEW_ARB_pixel_buffer_object) {
+
+        std::cout << "FRAME CAPTURE: framebuffer and pixel buffer objects " <<
+            "are not supported, frames will not be captured" << std::endl;
+        return false;
+    }
+
+    // a single sampled framebuffer can't be copied to a multisampled one
+    GLint samples = 0;
+    glGetIntegerv(GL_SAMPLE_BUFFERS, &samples);
+    if (samples > 0 && m_show) {
+
+        std::cout << "FRAME CAPTURE: the window is multisampled, frames " <<
+            "will be captured but not shown" << std::endl;
+        m_show = false;
+    }
+
+    m_width = width;
+    m_height = height;
+
+    glGenRenderbuffers(1, &m_colour);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colour);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &m_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(
+        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colour);
+    glFramebufferRenderbuffer(
+        GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depth);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    m_created = true;
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+
+        std::cout << "FRAME CAPTURE: unable to create a " << width << "x" <<
+            height << " framebuffer, frames will not be captured" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(LATENCY, m_buffers);
+    for (unsigned i = 0; i < LATENCY; ++i) {
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, width * height * 4, NULL,
+            GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+void FrameCapture::destroy() {
+
+    if (!m_created) {
+
+        return;
+    }
+
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_colour);
+    glDeleteRenderbuffers(1, &m_depth);
+    glDeleteBuffers(LATENCY, m_buffers);
+    m_framebuffer = 0;
+    m_colour = 0;
+    m_depth = 0;
+    std::fill(m_buffers, m_buffers + LATENCY, 0);
+    m_created = false;
+}
+
+void FrameCapture::map() {
+
+    OMI_PROFILE_SCOPE("FrameCapture::map");
+
+    static const unsigned queuedCounter =
+        counters::get("capture.queued", counters::GAUGE);
+    static const unsigned stallCounter =
+        counters::get("capture.stalls", counters::PER_FRAME);
+
+    Frame frame;
+    frame.number = m_mapped;
+    frame.width  = m_width;
+    frame.height = m_height;
+    {
+        // wait for the writer rather than dropping frames, so every frame of
+        // a run is captured
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= MAX_QUEUED) {
+
+            counters::add(stallCounter);
+        }
+        while (m_queue.size() >= MAX_QUEUED) {
+
+            m_taken.wait(lock);
+        }
+        if (!m_spare.empty()) {
+
+            frame.pixels.swap(m_spare.back());
+            m_spare.pop_back();
+        }
+    }
+
+    unsigned row = m_width * 4;
+    frame.pixels.resize(row * m_height);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[m_mapped % LATENCY]);
+    const unsigned char* pixels = static_cast<const unsigned char*>(
+        glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+    if (pixels != NULL) {
+
+        // OpenGL reads the bottom row first but files store the top first
+        for (unsigned y = 0; y < m_height; ++y) {
+
+            const unsigned char* source = pixels + (m_height - 1 - y) * row;
+            std::copy(source, source + row, &frame.pixels[y * row]);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(frame));
+        counters::set(queuedCounter, m_queue.size());
+        m_wake.notify_one();
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    ++m_mapped;
+}
+
+void FrameCapture::run() {
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+
+        while (!m_quit && m_queue.empty()) {
+
+            m_wake.wait(lock);
+        }
+        if (m_queue.empty()) {
+
+            break;
+        }
+
+        Frame frame = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_taken.notify_one();
+
+        // write without holding the lock so rendering isn't blocked
+        lock.unlock();
+        bool written = write(frame);
+        lock.lock();
+
+        if (written) {
+
+            ++m_written;
+        }
+        m_spare.push_back(std::move(frame.pixels));
+    }
+}
+
+bool FrameCapture::write(const Frame& frame) const {
+
+    OMI_PROFILE_SCOPE("FrameCapture::write");
+
+    std::stringstream path;
+    path << m_directory << "frame_";
+    path.width(6);
+    path.fill('0');
+    path << frame.number << (m_format == capture::PNG ? ".png" : ".rgba");
+
+    if (m_format == capture::PNG) {
+
+        sf::Image image;
+        image.create(frame.width, frame.height, &frame.pixels[0]);
+        return image.saveToFile(path.str());
+    }
+
+    std::ofstream file(path.str().c_str(), std::ios::out | std::ios::binary);
+    if (!file.good()) {
+
+        std::cout << "FRAME CAPTURE: unable to write " << path.str() <<
+            std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&frame.pixels[0]),
+        frame.pixels.size());
+    return file.good();
+}
+
+} // namespace omi
\ No newline at end of file
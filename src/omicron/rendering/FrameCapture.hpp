@@ -0,0 +1,188 @@
+#ifndef OMICRON_RENDERING_FRAMECAPTURE_H_
+#   define OMICRON_RENDERING_FRAMECAPTURE_H_
+
+#include <GL/glew.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+
+namespace omi {
+
+namespace capture {
+
+//! the formats captured frames can be written in
+enum Format {
+
+    PNG, // compressed images
+    RAW  // the RGBA pixels of each frame, top row first
+};
+
+} // namespace capture
+
+/*****************************************************************************\
+| Writes every rendered frame to a directory without stalling rendering.      |
+| While capturing, frames are rendered into a framebuffer object which is     |
+| copied to the window and then read back into a ring of pixel buffer         |
+| objects. A read is only mapped once it is several frames old, by which time |
+| the transfer has finished, and the pixels are handed to a background thread |
+| to be written.                                                              |
+|                                                                             |
+| Frames are rendered without multisampling so they are the same on every     |
+| driver, including software ones. A multisampled window can't be copied to,  |
+| so its frames are captured but not shown.                                   |
+\*****************************************************************************/
+class FrameCapture {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_COPY_AND_ASSIGN(FrameCapture);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
+
+    //! the number of frames a read is mapped behind the frame being rendered
+    static const unsigned LATENCY = 3;
+    //! the largest number of frames waiting to be written before rendering
+    //! waits for the writer to catch up
+    static const unsigned MAX_QUEUED = 8;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a new frame capture and starts its writing thread
+    @param directory the directory to write frames to
+    @param format the format to write frames in */
+    FrameCapture(const std::string& directory, capture::Format format);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~FrameCapture();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Redirects rendering into the capture framebuffer. This should be called
+    before anything is drawn each frame. */
+    void begin();
+
+    /** Copies the frame to the window and starts reading it back. This should
+    be called once everything has been drawn. */
+    void end();
+
+    /** Writes the frames that are still being read back and waits for them
+    to be written. No more frames are captured afterwards. */
+    void finish();
+
+    /** @return the number of frames that have been written */
+    unsigned long long getWritten() const;
+
+    /** @return the directory frames are written to */
+    const std::string& getDirectory() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    // a frame waiting to be written
+    struct Frame {
+
+        // the number of the frame since capture began
+        unsigned long long number;
+        // the size of the frame in pixels
+        unsigned width;
+        unsigned height;
+        // the RGBA pixels of the frame, top row first
+        std::vector<unsigned char> pixels;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the directory frames are written to
+    std::string m_directory;
+    // the format frames are written in
+    capture::Format m_format;
+
+    // if frames are being captured
+    bool m_active;
+    // if the frames are copied to the window
+    bool m_show;
+    // if the OpenGL objects have been created
+    bool m_created;
+    // the framebuffer frames are rendered into and its attachments
+    GLuint m_framebuffer;
+    GLuint m_colour;
+    GLuint m_depth;
+    // the ring of pixel buffers frames are read back into
+    GLuint m_buffers[LATENCY];
+    // the size of the framebuffer in pixels
+    unsigned m_width;
+    unsigned m_height;
+    // the number of frames read back and the number of those mapped
+    unsigned long long m_read;
+    unsigned long long m_mapped;
+
+    // guards everything shared with the writing thread
+    mutable std::mutex m_mutex;
+    // wakes the writing thread when there is a frame to write
+    std::condition_variable m_wake;
+    // wakes rendering when the writing thread has taken a frame
+    std::condition_variable m_taken;
+    // the writing thread
+    std::thread m_thread;
+    // if the writing thread should stop once the queue is empty
+    bool m_quit;
+    // frames waiting to be written, oldest first
+    std::deque<Frame> m_queue;
+    // pixel arrays of written frames, reused so they aren't reallocated
+    std::vector<std::vector<unsigned char>> m_spare;
+    // the number of frames written
+    unsigned long long m_written;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Creates the framebuffer and pixel buffers
+    @param width the width of the frames in pixels
+    @param height the height of the frames in pixels
+    @return if the framebuffer is complete */
+    bool create(unsigned width, unsigned height);
+
+    /** Deletes the framebuffer and pixel buffers */
+    void destroy();
+
+    /** Maps the oldest read that hasn't been mapped and queues its frame to be
+    written */
+    void map();
+
+    /** The loop of the writing thread */
+    void run();
+
+    /** Writes a frame to a file
+    @param frame the frame to write
+    @return if the frame was written */
+    bool write(const Frame& frame) const;
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
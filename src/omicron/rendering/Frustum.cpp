@@ -0,0 +1,113 @@
+#include "Frustum.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+Frustum::Frustum() :
+    m_bounded(false) {
+}
+
+Frustum::Frustum(const util::mat::Matrix4& view,
+                 const util::mat::Matrix4& projection) :
+    m_bounded(true) {
+
+    util::mat::Matrix4 clip(projection * view);
+    const float* m = clip.data();
+
+    // the planes as normal x, y, z and distance, the unused planes at the end
+    // of the last group have everything in front of them
+    float planes[PLANE_GROUPS * 4][4];
+    for (unsigned i = PLANE_COUNT; i < PLANE_GROUPS * 4; ++i) {
+
+        planes[i][0] = planes[i][1] = planes[i][2] = 0.0f;
+        planes[i][3] = std::numeric_limits<float>::max();
+    }
+
+    // each plane is the sum or difference of the w row and another row of the
+    // clip matrix: left, right, bottom, top, near, far
+    for (unsigned i = 0; i < PLANE_COUNT; ++i) {
+
+        unsigned row = i / 2;
+        float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        for (unsigned j = 0; j < 4; ++j) {
+
+            planes[i][j] = m[j * 4 + 3] + (sign * m[j * 4 + row]);
+        }
+
+        // normalise so that distances are in world units
+        float length = sqrt(
+            (planes[i][0] * planes[i][0]) +
+            (planes[i][1] * planes[i][1]) +
+            (planes[i][2] * planes[i][2]));
+        if (length > 0.0f) {
+
+            for (unsigned j = 0; j < 4; ++j) {
+
+                planes[i][j] /= length;
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < PLANE_GROUPS; ++i) {
+
+        const float (*group)[4] = planes + (i * 4);
+        m_normalX[i]  = util::vec::Packed4(
+            group[0][0], group[1][0], group[2][0], group[3][0]);
+        m_normalY[i]  = util::vec::Packed4(
+            group[0][1], group[1][1], group[2][1], group[3][1]);
+        m_normalZ[i]  = util::vec::Packed4(
+            group[0][2], group[1][2], group[2][2], group[3][2]);
+        m_distance[i] = util::vec::Packed4(
+            group[0][3], group[1][3], group[2][3], group[3][3]);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool Frustum::intersectsSphere(const util::vec::Vector3& centre,
+                                     float               radius) const {
+
+    if (!m_bounded) {
+
+        return true;
+    }
+
+    // find the distance to four planes at a time and keep the nearest of
+    // each lane
+    util::vec::Packed4 x(centre.x);
+    util::vec::Packed4 y(centre.y);
+    util::vec::Packed4 z(centre.z);
+    util::vec::Packed4 nearest;
+    for (unsigned i = 0; i < PLANE_GROUPS; ++i) {
+
+        util::vec::Packed4 distance =
+            (m_normalX[i] * x) +
+            (m_normalY[i] * y) +
+            (m_normalZ[i] * z) +
+             m_distance[i];
+        nearest = (i == 0) ? distance :
+            util::vec::Packed4::min(nearest, distance);
+    }
+
+    float lanes[4];
+    nearest.store(lanes);
+    for (unsigned i = 0; i < 4; ++i) {
+
+        if (lanes[i] < -radius) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace omi
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef OMICRON_RENDERING_FRUSTUM_H_
+#   define OMICRON_RENDERING_FRUSTUM_H_
+
+#include "lib/Utilitron/Matrix.hpp"
+#include "lib/Utilitron/Vector.hpp"
+#include "lib/Utilitron/VectorBatch.hpp"
+
+namespace omi {
+
+/*****************************************************************************\
+| The six planes bounding the volume a camera can see, extracted from the    |
+| combined projection and view matrix so it works for both perspective and   |
+| orthographic cameras.                                                      |
+\*****************************************************************************/
+class Frustum {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /** Creates a new frustum that contains everything */
+    Frustum();
+
+    /** Creates a new frustum from the given matrices
+    @param view the view matrix of the camera
+    @param projection the projection matrix of the camera */
+    Frustum(const util::mat::Matrix4& view,
+            const util::mat::Matrix4& projection);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return if any part of the given sphere is inside the frustum
+    @param centre the world space centre of the sphere
+    @param radius the radius of the sphere */
+    bool intersectsSphere(const util::vec::Vector3& centre,
+                                float               radius) const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 CONSTANTS
+    //--------------------------------------------------------------------------
+
+    // the number of planes in the frustum
+    static const unsigned PLANE_COUNT = 6;
+    // the number of groups of four planes that are tested together
+    static const unsigned PLANE_GROUPS = 2;
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // is false if the frustum contains everything
+    bool m_bounded;
+    // the components of the planes' normals and their distances packed four
+    // planes at a time, normals point inwards
+    util::vec::Packed4 m_normalX[PLANE_GROUPS];
+    util::vec::Packed4 m_normalY[PLANE_GROUPS];
+    util::vec::Packed4 m_normalZ[PLANE_GROUPS];
+    util::vec::Packed4 m_distance[PLANE_GROUPS];
+};
+
+} // namespace omi
+
+#endif
@@ -1,12 +1,19 @@
 #include "RenderLists.hpp"
 
+#include <sstream>
+
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
 //                                  CONSTRUCTOR
 //------------------------------------------------------------------------------
 
-RenderLists::RenderLists() {
+RenderLists::RenderLists() :
+    m_drawCount  (0),
+    m_culledCount(0) {
 }
 
 //------------------------------------------------------------------------------
@@ -20,18 +27,69 @@ RenderLists::~RenderLists() {
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
-void RenderLists::render(Camera* camera) {
+void RenderLists::cull(Camera* camera) {
 
-    // apply the camera
+    OMI_PROFILE_SCOPE("RenderLists::cull");
+
+    // with no camera there is nothing to cull against
+    Frustum frustum;
     if (camera != NULL) {
 
-        camera->apply();
+        frustum = Frustum(
+            camera->getViewMatrix(), camera->getProjectionMatrix());
+    }
+
+    m_drawCount = 0;
+    m_culledCount = 0;
+    for (t_RenderableMap::iterator it = m_drawLists.begin();
+        it != m_drawLists.end(); ++it) {
+
+        it->second.clear();
     }
 
-    // iterate over the layers
     for (t_RenderableMap::iterator it = m_renderables.begin();
         it != m_renderables.end(); ++it) {
 
+        std::vector<Renderable*>& drawList = m_drawLists[it->first];
+        for (std::vector<Renderable*>::iterator itr = it->second.begin();
+            itr != it->second.end(); ++itr) {
+
+            if (!(*itr)->visible || !(*itr)->getMaterial().isVisible()) {
+
+                continue;
+            }
+
+            util::vec::Vector3 centre;
+            float radius;
+            if ((*itr)->cullable && (*itr)->getWorldBounds(centre, radius) &&
+                !frustum.intersectsSphere(centre, radius)) {
+
+                ++m_culledCount;
+                continue;
+            }
+
+            drawList.push_back(*itr);
+            ++m_drawCount;
+        }
+    }
+}
+
+void RenderLists::render(Camera* camera) {
+
+    OMI_PROFILE_SCOPE("RenderLists::render");
+
+    // get the matrices of the camera, with no camera the identity is used
+    RenderView view;
+    if (camera != NULL) {
+
+        view.view = camera->getViewMatrix();
+        view.projection = camera->getProjectionMatrix();
+    }
+
+    // iterate over the layers
+    for (t_RenderableMap::iterator it = m_drawLists.begin();
+        it != m_drawLists.end(); ++it) {
+
         //sort the list of renderables based on their distance from the camera
         depthSorter.camera = camera;
         std::sort(it->second.begin(), it->second.end(), depthSorter);
@@ -40,14 +98,57 @@ void RenderLists::render(Camera* camera) {
         for (std::vector<Renderable*>::iterator itr = it->second.begin();
             itr != it->second.end(); ++itr) {
 
-            (*itr)->render();
+            (*itr)->render(view);
+        }
+    }
+}
+
+unsigned RenderLists::getDrawCount() const {
+
+    return m_drawCount;
+}
+
+unsigned RenderLists::getCulledCount() const {
+
+    return m_culledCount;
+}
+
+void RenderLists::updateCounters() {
+
+    static const unsigned renderableCounter =
+        counters::get("components.renderable", counters::GAUGE);
+
+    unsigned total = 0;
+    for (t_RenderableMap::iterator it = m_renderables.begin();
+        it != m_renderables.end(); ++it) {
+
+        if (m_layerCounters.find(it->first) == m_layerCounters.end()) {
+
+            std::stringstream name;
+            name << "render.layer." << it->first;
+            m_layerCounters.insert(std::make_pair(it->first,
+                counters::get(name.str(), counters::GAUGE)));
         }
+        total += it->second.size();
+    }
+    counters::set(renderableCounter, total);
+
+    // layers that have been emptied are zeroed
+    for (std::map<int, unsigned>::iterator it = m_layerCounters.begin();
+        it != m_layerCounters.end(); ++it) {
+
+        t_RenderableMap::iterator layer = m_renderables.find(it->first);
+        counters::set(it->second,
+            layer == m_renderables.end() ? 0 : layer->second.size());
     }
 }
 
 void RenderLists::clear() {
 
     m_renderables.clear();
+    m_drawLists.clear();
+    m_drawCount = 0;
+    m_culledCount = 0;
 }
 
 void RenderLists::addRenderable(Renderable* renderable) {
@@ -91,6 +192,11 @@ void RenderLists::removeRenderable(Renderable* renderable) {
             ++it;
         }
     }
+
+    // don't draw the renderable if it was removed since the last cull
+    std::vector<Renderable*>& drawList = m_drawLists[layer];
+    drawList.erase(std::remove(drawList.begin(), drawList.end(), renderable),
+        drawList.end());
 }
 
 } // namespace omi
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 #include "src/omicron/component/Camera.hpp"
 #include "src/omicron/component/renderable/Renderable.hpp"
+#include "src/omicron/rendering/Frustum.hpp"
 
 namespace omi {
 
@@ -27,19 +28,31 @@ struct RenderableDepthSorter {
     /** The sorting function */
     bool operator ()(Renderable* a, Renderable* b) {
 
-        // compared based on their distances from the camera
-        float distanceA = util::vec::distance(
-            a->getTransform()->translation,
-            camera->getTransform()->translation
+        // compared based on their distances from the camera, squared
+        // distances sort the same way without the square roots
+        float distanceA = util::vec::distanceSquared(
+            positionOf(a),
+            camera->getTransform()->computeTranslation()
         );
 
-        float distanceB = util::vec::distance(
-            b->getTransform()->translation,
-            camera->getTransform()->translation
+        float distanceB = util::vec::distanceSquared(
+            positionOf(b),
+            camera->getTransform()->computeTranslation()
         );
 
         return distanceA < distanceB;
     }
+
+    /** @return the position of the renderable, renderables without a
+    transform are drawn at the origin */
+    static util::vec::Vector3 positionOf(Renderable* renderable) {
+
+        if (renderable->getTransform() == NULL) {
+
+            return util::vec::Vector3();
+        }
+        return renderable->getTransform()->computeTranslation();
+    }
 };
 
 /*************************************************************************\
@@ -73,11 +86,27 @@ public:
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    /** Renders all of the renderable components contained within the render
-    lists
+    /** Finds the renderables that will be drawn this frame, skipping those
+    that are hidden or outside of the camera's view
+    @param camera the camera to cull against, nothing is culled if this is
+                  NULL */
+    void cull(Camera* camera);
+
+    /** Renders the renderable components found by the last cull
     @param the camera to use for rendering */
     void render(Camera* camera);
 
+    /** @return the number of renderables found to be drawn by the last cull */
+    unsigned getDrawCount() const;
+
+    /** @return the number of visible renderables skipped by the last cull
+    because they were outside of the camera's view */
+    unsigned getCulledCount() const;
+
+    /** Updates the performance counters of the number of renderables in each
+    layer */
+    void updateCounters();
+
     /** Removes all components from the render lists */
     void clear();
 
@@ -97,9 +126,18 @@ private:
 
     // all renderable components grouped by layer
     t_RenderableMap m_renderables;
+    // the renderable components to draw this frame grouped by layer
+    t_RenderableMap m_drawLists;
+    // the number of renderables found to be drawn by the last cull
+    unsigned m_drawCount;
+    // the number of renderables culled by the last cull
+    unsigned m_culledCount;
 
     // the depth sorter
     RenderableDepthSorter depthSorter;
+
+    // the counters of the number of renderables in each layer
+    std::map<int, unsigned> m_layerCounters;
 };
 
 } // namespace omi
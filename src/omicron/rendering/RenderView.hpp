@@ -0,0 +1,27 @@
+#ifndef OMICRON_RENDERING_RENDERVIEW_H_
+#   define OMICRON_RENDERING_RENDERVIEW_H_
+
+#include "lib/Utilitron/Matrix.hpp"
+
+namespace omi {
+
+/*****************************************************************************\
+| The view and projection matrices that renderables are drawn with for a      |
+| frame. These are computed on the CPU once per frame and uploaded to each    |
+| shader as uniforms instead of going through the OpenGL matrix stack.        |
+\*****************************************************************************/
+struct RenderView {
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    //! transforms from world space into camera space
+    util::mat::Matrix4 view;
+    //! transforms from camera space into clip space
+    util::mat::Matrix4 projection;
+};
+
+} // namespace omi
+
+#endif
@@ -1,5 +1,7 @@
 #include "Renderer.hpp"
 
+#include "src/omicron/debug/Counters.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
@@ -7,7 +9,10 @@ namespace omi {
 //------------------------------------------------------------------------------
 
 Renderer::Renderer() :
-    m_camera(NULL) {
+    m_camera          (NULL),
+    m_drawCount       (0),
+    m_totalDrawCount  (0),
+    m_totalCulledCount(0) {
 
     // initialise
     init();
@@ -26,17 +31,51 @@ Renderer::~Renderer() {
 
 void Renderer::render() {
 
+    static const unsigned drawCounter =
+        counters::get("render.draws", counters::PER_FRAME);
+    static const unsigned culledCounter =
+        counters::get("render.culled", counters::PER_FRAME);
+    static const unsigned cameraCounter =
+        counters::get("components.camera", counters::GAUGE);
+
+    // find and count the renderables drawn this frame, culling runs headless
+    // too so that its cost shows up in performance runs
+    m_renderLists->cull(m_camera);
+    m_drawCount = m_renderLists->getDrawCount();
+    m_totalDrawCount += m_drawCount;
+    counters::add(drawCounter, m_drawCount);
+    m_totalCulledCount += m_renderLists->getCulledCount();
+    counters::add(culledCounter, m_renderLists->getCulledCount());
+    counters::set(cameraCounter, m_camera != NULL ? 1 : 0);
+    m_renderLists->updateCounters();
+
+    // there is no OpenGL context when running headless
+    if (systemSettings.isHeadless()) {
+
+        return;
+    }
+
     // update any settings that have changed
     applySettings();
 
+    // render into the capture framebuffer instead of the window
+    if (m_capture) {
+
+        m_capture->begin();
+    }
+
     // clear the window
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    glLoadIdentity();
-
     // render the render lists
     m_renderLists->render(m_camera);
 
+    // show the frame and read it back to be written
+    if (m_capture) {
+
+        m_capture->end();
+    }
+
     // swap the buffers
     // TODO:?
 }
@@ -70,6 +109,50 @@ void Renderer::removeRenderable(Renderable* renderable) {
     m_renderLists->removeRenderable(renderable);
 }
 
+unsigned Renderer::getDrawCount() const {
+
+    return m_drawCount;
+}
+
+unsigned long long Renderer::getTotalDrawCount() const {
+
+    return m_totalDrawCount;
+}
+
+unsigned long long Renderer::getTotalCulledCount() const {
+
+    return m_totalCulledCount;
+}
+
+void Renderer::startCapture(
+        const std::string&    directory,
+              capture::Format format) {
+
+    // there is nothing rendered to capture when running headless
+    if (systemSettings.isHeadless()) {
+
+        std::cout << "RENDERER: frames can't be captured when running " <<
+            "headless" << std::endl;
+        return;
+    }
+
+    m_capture = std::unique_ptr<FrameCapture>(
+        new FrameCapture(directory, format));
+}
+
+void Renderer::finishCapture() {
+
+    if (!m_capture) {
+
+        return;
+    }
+
+    m_capture->finish();
+    std::cout << "RENDERER: captured " << m_capture->getWritten() <<
+        " frames to " << m_capture->getDirectory() << std::endl;
+    m_capture.reset();
+}
+
 //------------------------------------------------------------------------------
 //                            PRIVATE MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
@@ -95,6 +178,15 @@ void Renderer::applySettings() {
 
 void Renderer::init() {
 
+    // create the render lists
+    m_renderLists = std::unique_ptr<RenderLists>(new RenderLists());
+
+    // there is no OpenGL context when running headless
+    if (systemSettings.isHeadless()) {
+
+        return;
+    }
+
     // apply the render settings
     applySettings();
 
@@ -107,9 +199,6 @@ void Renderer::init() {
 
     // initialise DevIL
     ilInit();
-
-    // create the render lists
-    m_renderLists = std::unique_ptr<RenderLists>(new RenderLists());
 }
 
 } // namespace omi
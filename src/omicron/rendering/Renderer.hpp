@@ -11,13 +11,15 @@
 class RenderSettings;
 
 #include "src/omicron/Omicron.hpp"
+#include "src/omicron/rendering/FrameCapture.hpp"
 #include "src/omicron/rendering/RenderLists.hpp"
 
 namespace omi {
 
 /****************************************************************************\
 | The hub class controlling all rendering in Omicron. Rendering is performed |
-| using OpenGL.                                                              |
+| using OpenGL. When Omicron is running headless no OpenGL calls are made    |
+| and the renderer only counts the draws each frame would have made.         |
 \****************************************************************************/
 class Renderer {
 private:
@@ -69,6 +71,23 @@ public:
     @param renderable the renderable to remove */
     void removeRenderable(Renderable* renderable);
 
+    /** @return the number of renderables drawn in the last frame */
+    unsigned getDrawCount() const;
+
+    /** @return the total number of renderables drawn in all frames */
+    unsigned long long getTotalDrawCount() const;
+
+    /** @return the total number of renderables culled in all frames */
+    unsigned long long getTotalCulledCount() const;
+
+    /** Starts writing every rendered frame to files
+    @param directory the directory to write frames to
+    @param format the format to write frames in */
+    void startCapture(const std::string& directory, capture::Format format);
+
+    /** Writes the frames still being captured and stops capturing */
+    void finishCapture();
+
 private:
 
     //--------------------------------------------------------------------------
@@ -79,6 +98,15 @@ private:
     std::unique_ptr<RenderLists> m_renderLists;
     // the camera the used for perspective
     Camera* m_camera;
+    // writes rendered frames to files, null if frames aren't captured
+    std::unique_ptr<FrameCapture> m_capture;
+
+    // the number of renderables drawn in the last frame
+    unsigned m_drawCount;
+    // the total number of renderables drawn in all frames
+    unsigned long long m_totalDrawCount;
+    // the total number of renderables culled in all frames
+    unsigned long long m_totalCulledCount;
 
     //--------------------------------------------------------------------------
     //                          PRIVATE MEMBER FUNCTIONS
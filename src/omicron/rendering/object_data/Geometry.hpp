@@ -1,6 +1,7 @@
 #ifndef OMICRON_RENDERING_OBJECT_DATA_GEOMETRY_H_
 #   define OMICRON_RENDERING_OBJECT_DATA_GEOMETRY_H_
 
+#include <memory>
 #include <vector>
 
 #include "lib/Utilitron/Vector.hpp"
@@ -66,9 +67,19 @@ public:
         vertices = other.vertices;
         uv       = other.uv;
         normals  = other.normals;
+
+        return *this;
     }
 };
 
+//------------------------------------------------------------------------------
+//                                TYPE DEFINITIONS
+//------------------------------------------------------------------------------
+
+// shared geometry, the resource it came from is kept until the last handle is
+// destroyed
+typedef std::shared_ptr<Geometry> t_GeometryHandle;
+
 } // namespace omi
 
 #endif
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Animation.hpp"
 
+#include "src/omicron/Omicron.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
@@ -20,7 +22,7 @@ Animation::Animation(
     :
     m_textures     (textures),
     m_frameRate    (frameRate),
-    m_frameLength  (1000 / frameRate),
+    m_frameLength  (util::time::NS_IN_SEC / frameRate),
     m_frame        (0),
     m_repeat       (repeat),
     m_ended        (false),
@@ -41,6 +43,7 @@ Animation::Animation(Animation& other) :
     m_accumTime    (0) {
 
     m_visible = true;
+    m_residency = other.m_residency;
 }
 
 //------------------------------------------------------------------------------
@@ -65,6 +68,9 @@ const Animation& Animation::operator=(const Animation& other) {
     m_lastFrameTime = -1;
     m_accumTime     = 0;
     m_visible       = other.m_visible;
+    m_residency     = other.m_residency;
+
+    return *this;
 }
 
 //------------------------------------------------------------------------------
@@ -83,11 +89,11 @@ void Animation::update() {
     // get time for the first time
     if (m_lastFrameTime < 0) {
 
-        m_lastFrameTime = util::time::getCurrentTime();
+        m_lastFrameTime = fpsManager.getTime();
     }
 
     // update the frame if one or more has passed
-    util::int64 currentTime = util::time::getCurrentTime();
+    util::int64 currentTime = fpsManager.getTime();
     if (currentTime - m_lastFrameTime >= m_frameLength) {
 
         // update the amount of frames we need to
@@ -107,8 +113,9 @@ void Animation::update() {
             return;
         }
 
-        // update the time of the last frame
-        m_lastFrameTime = currentTime +
+        // update the time of the last frame, keeping the time already spent
+        // in the current frame
+        m_lastFrameTime = currentTime -
             ((currentTime - m_lastFrameTime) % m_frameLength);
     }
 
@@ -121,4 +128,9 @@ tex::Type Animation::getType() const {
     return tex::ANIMATION;
 }
 
+const t_TextureList& Animation::getFrames() const {
+
+    return m_textures;
+}
+
 } // namsepace omi
@@ -62,6 +62,9 @@ public:
     /** #Override */
     tex::Type getType() const;
 
+    /** @return the OpenGL pointers to the textures of each frame */
+    const t_TextureList& getFrames() const;
+
 private:
 
     //--------------------------------------------------------------------------
@@ -73,7 +76,7 @@ private:
 
     // the framerate of the animation
     unsigned m_frameRate;
-    // the frame length of the animation in ms
+    // the frame length of the animation in nanoseconds
     util::int64 m_frameLength;
     // the current frame of the animation
     unsigned m_frame;
@@ -83,7 +86,7 @@ private:
     // is true if the animation has ended
     bool m_ended;
 
-    // the time the last frame begin
+    // the engine time the last frame began in nanoseconds
     util::int64 m_lastFrameTime;
     // the accumulated time from the last frame
     util::int64 m_accumTime;
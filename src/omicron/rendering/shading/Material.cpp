@@ -15,7 +15,7 @@ Material::Material()
 
 Material::Material(const Shader&             a_shader,
                    const util::vec::Vector4& a_colour,
-                         Texture*            a_texture)
+                         t_TextureHandle     a_texture)
     :
     shader (a_shader),
     colour (a_colour),
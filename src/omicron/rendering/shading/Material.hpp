@@ -22,8 +22,8 @@ public:
     Shader shader;
     //! the colour of the material
     util::vec::Vector4 colour;
-    //! a pointer to the texture of the material
-    Texture* texture;
+    //! the texture of the material, may be empty
+    t_TextureHandle texture;
 
     //--------------------------------------------------------------------------
     //                                CONSTRUCTORS
@@ -39,7 +39,7 @@ public:
     @param a_texture the texture of the material */
     Material(const Shader&             a_shader,
              const util::vec::Vector4& a_colour,
-                   Texture*            a_texture);
+                   t_TextureHandle     a_texture);
 
     /** Creates a copy of the given material
     @param other the material to copy from */
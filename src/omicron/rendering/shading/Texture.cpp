@@ -7,18 +7,21 @@ namespace omi {
 //------------------------------------------------------------------------------
 
 Texture::Texture() :
-    m_id     (0),
-    m_visible(true) {
+    m_id       (0),
+    m_visible  (true),
+    m_residency(NULL) {
 }
 
 Texture::Texture(GLuint id) :
-    m_id     (id),
-    m_visible(true) {
+    m_id       (id),
+    m_visible  (true),
+    m_residency(NULL) {
 }
 
 Texture::Texture(const Texture& other) :
-    m_id     (other.m_id),
-    m_visible(true) {
+    m_id       (other.m_id),
+    m_visible  (true),
+    m_residency(other.m_residency) {
 }
 
 //------------------------------------------------------------------------------
@@ -34,8 +37,9 @@ Texture::~Texture() {
 
 const Texture& Texture::operator=(const Texture& other) {
 
-    m_id =      other.m_id;
-    m_visible = other.m_visible;
+    m_id =        other.m_id;
+    m_visible =   other.m_visible;
+    m_residency = other.m_residency;
 
     return *this;
 }
@@ -64,4 +68,17 @@ bool Texture::isVisible() const {
     return m_visible;
 }
 
+void Texture::use() {
+
+    if (m_residency != NULL) {
+
+        m_residency->use();
+    }
+}
+
+void Texture::setResidency(tex::Residency* residency) {
+
+    m_residency = residency;
+}
+
 } // namespace omi
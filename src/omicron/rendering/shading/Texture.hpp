@@ -2,6 +2,7 @@
 #   define OMICRON_RENDERING_SHADING_TEXTURE_H_
 
 #include <GL/glew.h>
+#include <memory>
 #include <SFML/OpenGL.hpp>
 
 #include "lib/Utilitron/Vector.hpp"
@@ -14,7 +15,33 @@ namespace tex {
     enum Type {
 
         TEXTURE,
-        ANIMATION
+        ANIMATION,
+        ATLAS
+    };
+
+    // the formats textures can be compressed to in video memory
+    enum Compression {
+
+        UNCOMPRESSED,
+        // 4 bits per pixel, no alpha
+        BC1,
+        // 8 bits per pixel with alpha
+        BC3
+    };
+
+    /**************************************************************\
+    | Told whenever a texture is used so that whatever owns it can |
+    | manage its video memory.                                     |
+    \**************************************************************/
+    class Residency {
+    public:
+
+        virtual ~Residency() {
+        }
+
+        /** Called when the texture is about to be bound, the texture must be
+        in video memory once this returns */
+        virtual void use() = 0;
     };
 }
 
@@ -43,7 +70,7 @@ public:
     //                                 DESTRUCTOR
     //--------------------------------------------------------------------------
 
-    ~Texture();
+    virtual ~Texture();
 
     //--------------------------------------------------------------------------
     //                                 OPERATORS
@@ -67,6 +94,14 @@ public:
     /** @return if the texture is visible */
     bool isVisible() const;
 
+    /** Marks the texture as used, restoring it to video memory if it was
+    evicted. This should be called before the texture is bound. */
+    void use();
+
+    /** Sets what is told when this texture and copies of it are used
+    @param residency the residency to tell, or NULL for none */
+    void setResidency(tex::Residency* residency);
+
 protected:
 
     //--------------------------------------------------------------------------
@@ -78,8 +113,19 @@ protected:
 
     // if the texture is visible
     bool m_visible;
+
+    // told when the texture is used, may be NULL
+    tex::Residency* m_residency;
 };
 
+//------------------------------------------------------------------------------
+//                                TYPE DEFINITIONS
+//------------------------------------------------------------------------------
+
+// a shared copy of a texture, the resource it came from is kept until the last
+// handle is destroyed
+typedef std::shared_ptr<Texture> t_TextureHandle;
+
 } // namespace omi
 
 #endif
\ No newline at end of file
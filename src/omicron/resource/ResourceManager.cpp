@@ -1,5 +1,11 @@
 #include "ResourceManager.hpp"
 
+#include <algorithm>
+
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+#include "src/omicron/resource/TextureResidency.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
@@ -7,6 +13,7 @@ namespace omi {
 //------------------------------------------------------------------------------
 
 t_ResourceMap ResourceManager::m_resources;
+std::vector<Resource*> ResourceManager::m_pendingRelease;
 
 //------------------------------------------------------------------------------
 //                            PUBLIC MEMBER FUNCTIONS
@@ -18,6 +25,27 @@ t_ResourceMap ResourceManager::m_resources;
 
 void ResourceManager::load(resource_group::ResourceGroup resourceGroup) {
 
+    OMI_PROFILE_SCOPE("ResourceManager::load");
+
+    static const unsigned loadCounter =
+        counters::get("resource.loads", counters::PER_FRAME);
+
+    // submit every shader in the group before any are finished so the driver
+    // can compile them in parallel
+    t_ResourceMap::iterator shaders = m_resources.find(SHADER);
+    if (shaders != m_resources.end()) {
+
+        for (t_ResourceGroup::iterator it =  shaders->second.begin();
+                                       it != shaders->second.end()  ;
+                                     ++it                          ) {
+
+            if (it->second->getGroup() == resourceGroup) {
+
+                dynamic_cast<ShaderResource*>(it->second.get())->submit();
+            }
+        }
+    }
+
     for (unsigned i = 0; i < m_resources.size(); ++i) {
 
         for (t_ResourceGroup::iterator it =  m_resources[i].begin();
@@ -25,11 +53,57 @@ void ResourceManager::load(resource_group::ResourceGroup resourceGroup) {
                                      ++it                        ) {
             // check the resource group
             if (it->second->getGroup() == resourceGroup) {
+                // the group is wanted again so don't release it later
+                m_pendingRelease.erase(
+                    std::remove(m_pendingRelease.begin(),
+                        m_pendingRelease.end(), it->second.get()),
+                    m_pendingRelease.end());
                 // load
+                if (!it->second->isLoaded()) {
+
+                    counters::add(loadCounter);
+                }
                 it->second->load();
             }
         }
     }
+
+    printMemory(resourceGroup);
+
+    // report the video memory used by the group's textures
+    t_ResourceMap::iterator textures = m_resources.find(TEXTURE);
+    if (textures != m_resources.end() && !systemSettings.isHeadless()) {
+
+        loader::TextureMemory memory = { 0, 0 };
+        for (t_ResourceGroup::iterator it =  textures->second.begin();
+                                       it != textures->second.end()  ;
+                                     ++it                           ) {
+
+            if (it->second->getGroup() == resourceGroup) {
+
+                const loader::TextureMemory& texture =
+                    dynamic_cast<TextureResource*>(
+                        it->second.get())->getMemory();
+                memory.bytes += texture.bytes;
+                memory.uncompressedBytes += texture.uncompressedBytes;
+            }
+        }
+        if (memory.uncompressedBytes > 0) {
+
+            std::cout << "RESOURCE MANAGER: textures use " <<
+                (memory.bytes / 1024) << "KB of video memory, " <<
+                (memory.uncompressedBytes / 1024) << "KB uncompressed" <<
+                std::endl;
+            if (TextureResidency::getBudget() > 0 &&
+                memory.bytes > TextureResidency::getBudget()) {
+
+                std::cout << "RESOURCE MANAGER: the group's textures are " <<
+                    "over the budget of " <<
+                    (TextureResidency::getBudget() / 1024) << "KB, the " <<
+                    "least recently used will be evicted" << std::endl;
+            }
+        }
+    }
 }
 
 void ResourceManager::release(resource_group::ResourceGroup resourceGroup) {
@@ -40,14 +114,113 @@ void ResourceManager::release(resource_group::ResourceGroup resourceGroup) {
                                        it != m_resources[i].end()  ;
                                      ++it                        ) {
             // check the resource group
-            if (it->second->getGroup() == resourceGroup) {
-                // release
+            if (it->second->getGroup() != resourceGroup) {
+
+                continue;
+            }
+            // resources with handles still in use are released once the last
+            // is dropped
+            if (it->second->getUsers() > 0) {
+
+                if (std::find(m_pendingRelease.begin(),
+                        m_pendingRelease.end(), it->second.get()) ==
+                    m_pendingRelease.end()) {
+
+                    m_pendingRelease.push_back(it->second.get());
+                }
+            }
+            else {
+
                 it->second->release();
             }
         }
     }
 }
 
+void ResourceManager::collect() {
+
+    OMI_PROFILE_SCOPE("ResourceManager::collect");
+
+    for (std::vector<Resource*>::iterator it = m_pendingRelease.begin();
+         it != m_pendingRelease.end();) {
+
+        if ((*it)->getUsers() == 0) {
+
+            (*it)->release();
+            it = m_pendingRelease.erase(it);
+        }
+        else {
+
+            ++it;
+        }
+    }
+}
+
+//-------------------------------MEMORY FUNCTIONS-------------------------------
+
+
+ResourceMemory ResourceManager::getMemory(
+        resource_group::ResourceGroup resourceGroup,
+        ResourceType                  type) {
+
+    ResourceMemory memory = { 0, 0 };
+    t_ResourceMap::iterator resources = m_resources.find(type);
+    if (resources == m_resources.end()) {
+
+        return memory;
+    }
+
+    for (t_ResourceGroup::iterator it =  resources->second.begin();
+                                   it != resources->second.end()  ;
+                                 ++it                            ) {
+
+        if (it->second->getGroup() == resourceGroup &&
+            it->second->isLoaded()) {
+
+            ResourceMemory resource = it->second->getMemoryUsage();
+            memory.cpuBytes += resource.cpuBytes;
+            memory.gpuBytes += resource.gpuBytes;
+        }
+    }
+    return memory;
+}
+
+ResourceMemory ResourceManager::getMemory(
+              ResourceType type,
+        const std::string& id) {
+
+    ResourceMemory memory = { 0, 0 };
+    t_ResourceMap::iterator resources = m_resources.find(type);
+    if (resources == m_resources.end()) {
+
+        return memory;
+    }
+
+    t_ResourceGroup::iterator resource = resources->second.find(id);
+    if (resource != resources->second.end() && resource->second->isLoaded()) {
+
+        memory = resource->second->getMemoryUsage();
+    }
+    return memory;
+}
+
+void ResourceManager::printMemory(resource_group::ResourceGroup resourceGroup) {
+
+    for (unsigned i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+
+        ResourceType type = static_cast<ResourceType>(i);
+        ResourceMemory memory = getMemory(resourceGroup, type);
+        if (memory.cpuBytes == 0 && memory.gpuBytes == 0) {
+
+            continue;
+        }
+
+        std::cout << "RESOURCE MANAGER: " << typeName(type) << " use " <<
+            (memory.cpuBytes / 1024) << "KB of main memory and " <<
+            (memory.gpuBytes / 1024) << "KB of video memory" << std::endl;
+    }
+}
+
 //--------------------------------GET FUNCTIONS---------------------------------
 
 
@@ -69,7 +242,7 @@ Shader ResourceManager::getShader(const std::string& id) {
             m_resources[SHADER][id].get())->get();
 }
 
-Texture* ResourceManager::getTexture(const std::string& id) {
+t_TextureHandle ResourceManager::getTexture(const std::string& id) {
 
     // create the textures group if we need to
     createGroup(TEXTURE);
@@ -82,9 +255,15 @@ Texture* ResourceManager::getTexture(const std::string& id) {
         // TODO: throw an exception
     }
 
-    // cast the resource and return
-    return dynamic_cast<TextureResource*>(
-            m_resources[TEXTURE][id].get())->get();
+    // cast the resource and hold it until the copy is deleted
+    TextureResource* resource =
+        dynamic_cast<TextureResource*>(m_resources[TEXTURE][id].get());
+    resource->acquire();
+    return t_TextureHandle(resource->get(), [resource](Texture* texture) {
+
+        delete texture;
+        resource->drop();
+    });
 }
 
 Material ResourceManager::getMaterial(const std::string& id) {
@@ -105,7 +284,7 @@ Material ResourceManager::getMaterial(const std::string& id) {
             m_resources[MATERIAL][id].get())->get();
 }
 
-Geometry* ResourceManager::getGeometry(const std::string& id) {
+t_GeometryHandle ResourceManager::getGeometry(const std::string& id) {
 
     // create the geometry group if we need to
     createGroup(GEOMETRY);
@@ -118,9 +297,15 @@ Geometry* ResourceManager::getGeometry(const std::string& id) {
         // TODO: throw an exception
     }
 
-    // cast the resource and return
-    return dynamic_cast<GeometryResource*>(
-            m_resources[GEOMETRY][id].get())->get();
+    // cast the resource and hold it until the handle is dropped, the
+    // geometry itself is owned by the resource
+    GeometryResource* resource =
+        dynamic_cast<GeometryResource*>(m_resources[GEOMETRY][id].get());
+    resource->acquire();
+    return t_GeometryHandle(resource->get(), [resource](Geometry*) {
+
+        resource->drop();
+    });
 }
 
 Mesh* ResourceManager::getMesh(const std::string& id,
@@ -163,6 +348,28 @@ Sprite* ResourceManager::getSprite(const std::string& id,
             m_resources[SPRITE][id].get())->get(componentId, transform);
 }
 
+ParticleSystem* ResourceManager::getParticleSystem(
+        const std::string& id,
+        const std::string& componentId) {
+
+    // create the particle system group if we need to
+    createGroup(PARTICLE_SYSTEM);
+
+    // check if the particle system is in the map
+    if (m_resources[PARTICLE_SYSTEM].find(id) ==
+        m_resources[PARTICLE_SYSTEM].end()) {
+
+        std::cout << "unable to find particle system in resource manager" <<
+            std::endl;
+
+        // TODO: throw an exception
+    }
+
+    // cast the resource and return
+    return dynamic_cast<ParticleSystemResource*>(
+            m_resources[PARTICLE_SYSTEM][id].get())->get(componentId);
+}
+
 unsigned ResourceManager::getSound(const std::string& id) {
 
     // create the sound group if we need to
@@ -237,6 +444,40 @@ void ResourceManager::addTexture(
             resourceGroup, filePath, frameRate, repeat, begin, end))));
 }
 
+void ResourceManager::addTextureAtlas(
+        const std::string&                  id,
+              resource_group::ResourceGroup resourceGroup,
+        const std::string&                  filePath,
+              unsigned                      begin,
+              unsigned                      end) {
+
+    // create the textures group if we need to
+    createGroup(TEXTURE);
+
+    // insert in to the map
+    m_resources[TEXTURE].insert(std::make_pair(id,
+        t_ResourcePtr(new TextureResource(
+            resourceGroup, filePath, begin, end))));
+}
+
+void ResourceManager::setTextureCompression(
+        const std::string&     id,
+              tex::Compression compression) {
+
+    // create the textures group if we need to
+    createGroup(TEXTURE);
+
+    // check if the texture is in the map
+    if (m_resources[TEXTURE].find(id) == m_resources[TEXTURE].end()) {
+
+        std::cout << "unable to find texture in resource manager" << std::endl;
+        return;
+    }
+
+    dynamic_cast<TextureResource*>(
+        m_resources[TEXTURE][id].get())->setCompression(compression);
+}
+
 void ResourceManager::addMaterial(
     const std::string&                  id,
           resource_group::ResourceGroup resourceGroup,
@@ -575,11 +816,40 @@ void ResourceManager::addTextureMaterialSprite(
     addSprite(  id, resourceGroup, layer, id, size, texSize, texOffset);
 }
 
+void ResourceManager::addParticleSystem(
+        const std::string&                  id,
+              resource_group::ResourceGroup resourceGroup,
+              int                           layer,
+        const std::string&                  material,
+        const util::vec::Vector2&           size,
+              unsigned                      frames,
+              float                         frameRate) {
+
+    // create the particle system group if we need to
+    createGroup(PARTICLE_SYSTEM);
+
+    // insert in to the map
+    m_resources[PARTICLE_SYSTEM].insert(
+        std::make_pair(
+            id,
+            t_ResourcePtr(new ParticleSystemResource(
+                resourceGroup,
+                layer,
+                material,
+                size,
+                frames,
+                frameRate
+            ))
+        )
+    );
+}
+
 void ResourceManager::addSound(
         const std::string&                  id,
               resource_group::ResourceGroup resourceGroup,
         const std::string&                  filePath,
-              unsigned                      instances) {
+              unsigned                      instances,
+              unsigned                      priority) {
 
     // create the sound group if we need to
     createGroup(SOUND);
@@ -591,7 +861,8 @@ void ResourceManager::addSound(
             t_ResourcePtr(new SoundResource(
                 resourceGroup,
                 filePath,
-                instances
+                instances,
+                priority
             ))
         )
     );
@@ -611,4 +882,20 @@ void ResourceManager::createGroup(ResourceType type) {
     }
 }
 
+const char* ResourceManager::typeName(ResourceType type) {
+
+    switch (type) {
+
+        case SHADER:          return "shaders";
+        case TEXTURE:         return "textures";
+        case MATERIAL:        return "materials";
+        case GEOMETRY:        return "geometry";
+        case MESH:            return "meshes";
+        case SPRITE:          return "sprites";
+        case PARTICLE_SYSTEM: return "particle systems";
+        case SOUND:           return "sounds";
+        default:              return "resources";
+    }
+}
+
 } // namespace omi
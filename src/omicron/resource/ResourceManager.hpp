@@ -3,14 +3,17 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "lib/Utilitron/MacroUtil.hpp"
 
 #include "src/omicron/component/renderable/Mesh.hpp"
+#include "src/omicron/component/renderable/ParticleSystem.hpp"
 #include "src/omicron/component/renderable/Sprite.hpp"
 #include "src/omicron/resource/type/GeometryResource.hpp"
 #include "src/omicron/resource/type/MaterialResource.hpp"
 #include "src/omicron/resource/type/MeshResource.hpp"
+#include "src/omicron/resource/type/ParticleSystemResource.hpp"
 #include "src/omicron/resource/type/Resource.hpp"
 #include "src/omicron/resource/type/ShaderResource.hpp"
 #include "src/omicron/resource/type/SoundResource.hpp"
@@ -40,6 +43,8 @@ private:
 
     DISALLOW_CONSTRUCTION(ResourceManager);
 
+public:
+
     //--------------------------------------------------------------------------
     //                                ENUMERATORS
     //--------------------------------------------------------------------------
@@ -53,11 +58,11 @@ private:
         GEOMETRY,
         MESH,
         SPRITE,
-        SOUND
+        PARTICLE_SYSTEM,
+        SOUND,
+        RESOURCE_TYPE_COUNT
     };
 
-public:
-
     //--------------------------------------------------------------------------
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
@@ -70,9 +75,37 @@ public:
     #NOTE: this function will only return once all resources are loaded */
     static void load(resource_group::ResourceGroup resourceGroup);
 
-    /** Releases the resources within the given group */
+    /** Releases the resources within the given group. Resources that still
+    have handles in use are released by collect once the last is dropped. */
     static void release(resource_group::ResourceGroup resourceGroup);
 
+    /** Releases the resources whose release was deferred and no longer have
+    any users. This should be called once per frame. */
+    static void collect();
+
+    //----------------------------MEMORY FUNCTIONS------------------------------
+
+
+    /** Gets the memory used by the loaded resources of a type within a group
+    @param resourceGroup the resource group to measure
+    @param type the type of resources to measure
+    @return the memory used */
+    static ResourceMemory getMemory(
+            resource_group::ResourceGroup resourceGroup,
+            ResourceType                  type);
+
+    /** Gets the memory used by a single loaded resource
+    @param type the type of the resource
+    @param id the identifier of the resource
+    @return the memory used, zero if the resource is not loaded */
+    static ResourceMemory getMemory(
+                  ResourceType type,
+            const std::string& id);
+
+    /** Prints the memory used by each type of resource within a group
+    @param resourceGroup the resource group to report */
+    static void printMemory(resource_group::ResourceGroup resourceGroup);
+
     //------------------------------GET FUNCTIONS-------------------------------
 
 
@@ -81,10 +114,11 @@ public:
     @return the requested shader */
     static Shader getShader(const std::string& id);
 
-    /** Gets the texture with the given identifier if it exists
+    /** Gets a copy of the texture with the given identifier if it exists
     @param id the identifier of the texture
-    @return the requested texture */
-    static Texture* getTexture(const std::string& id);
+    @return a handle to the copy, the texture is not released while it is
+            held */
+    static t_TextureHandle getTexture(const std::string& id);
 
     /** Gets the material with the given identifier if it exists
     @param id the identifier of the material
@@ -93,8 +127,9 @@ public:
 
     /** Gets the geometry with the given identifier if it exists
     @param id the identifier of the geometry
-    @return the requested geometry */
-    static Geometry* getGeometry(const std::string& id);
+    @return a handle to the geometry, the geometry is not released while it is
+            held */
+    static t_GeometryHandle getGeometry(const std::string& id);
 
     /** Gets the mesh with the given identifier if it exists
     @param id the identifier of the mesh
@@ -114,6 +149,13 @@ public:
                              const std::string& componentId,
                                    Transform*   transform);
 
+    /** Gets a new particle system with the given identifier if it exists
+    @param id the identifier of the particle system
+    @param componentId the component identifier to use for the particle system
+    @return a new particle system */
+    static ParticleSystem* getParticleSystem(const std::string& id,
+                                             const std::string& componentId);
+
     /** Gets the id of the sound with the given identifier if it exists
     @param id the identifier of the sound */
     static unsigned getSound(const std::string& id);
@@ -159,6 +201,28 @@ public:
               unsigned                      begin,
               unsigned                      end);
 
+    /** Adds a texture atlas to the resource map, the frames of the image
+    sequence are stacked vertically in a single texture
+    @param id the identifier of the texture resource
+    @param resourceGroup the resource group of the texture
+    @param filePath the path to the image file to use for the texture
+    @param begin the first frame of the sequence
+    @param end the last frame of the sequence */
+    static void addTextureAtlas(
+        const std::string&                  id,
+              resource_group::ResourceGroup resourceGroup,
+        const std::string&                  filePath,
+              unsigned                      begin,
+              unsigned                      end);
+
+    /** Sets the format a texture is compressed to in video memory, this must
+    be called before the texture is loaded
+    @param id the identifier of the texture resource
+    @param compression the compression to use */
+    static void setTextureCompression(
+        const std::string&     id,
+              tex::Compression compression);
+
 
     /** Adds a material to the resource map
     @param id the identifier of the material resource
@@ -459,16 +523,37 @@ public:
         const util::vec::Vector2&           texSize,
         const util::vec::Vector2&           texOffset);
 
+    /** Adds a particle system to the resource map
+    @param id the identifier of the particle system resource
+    @param resourceGroup the resource group of the particle system
+    @param layer the layer of the particles
+    @param material the resource id of the particles' material, its texture
+                    should be an atlas
+    @param size the size of each particle
+    @param frames the number of frames in the material's texture atlas
+    @param frameRate the playback speed of the animation */
+    static void addParticleSystem(
+        const std::string&                  id,
+              resource_group::ResourceGroup resourceGroup,
+              int                           layer,
+        const std::string&                  material,
+        const util::vec::Vector2&           size,
+              unsigned                      frames,
+              float                         frameRate);
+
     /** Adds a sound to the resource map
     @param id the identifier of the resource
     @param resourceGroup the resource group of the sound
     @param filePath the location of the sound
-    @param instances the number of instances of sound to create */
+    @param instances the number of instances of the sound that can play at once
+    @param priority the priority of the sound, higher priority sounds may take
+           the voices of lower priority sounds */
     static void addSound(
         const std::string&                  id,
               resource_group::ResourceGroup resourceGroup,
         const std::string&                  filePath,
-              unsigned                      instances);
+              unsigned                      instances,
+              unsigned                      priority);
 
 private:
 
@@ -478,6 +563,8 @@ private:
 
     // the map of all resources
     static t_ResourceMap m_resources;
+    // resources that were released while they still had users
+    static std::vector<Resource*> m_pendingRelease;
 
     //--------------------------------------------------------------------------
     //                          PRIVATE MEMBER FUNCTIONS
@@ -486,6 +573,9 @@ private:
     /** Checks if a resource type group exists in the map, if not create it
     @param type the resource type to check if it exists*/
     static void createGroup(ResourceType type);
+
+    /** @return the name of a resource type for messages */
+    static const char* typeName(ResourceType type);
 };
 
 } // namespace omi
@@ -0,0 +1,129 @@
+#include "TextureResidency.hpp"
+
+#include <algorithm>
+
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+#include "src/omicron/resource/type/TextureResource.hpp"
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+unsigned long long TextureResidency::m_budget = 0;
+unsigned long long TextureResidency::m_frame = 0;
+unsigned long long TextureResidency::m_evictions = 0;
+unsigned long long TextureResidency::m_reloads = 0;
+std::vector<TextureResource*> TextureResidency::m_textures;
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void TextureResidency::setBudget(unsigned long long bytes) {
+
+    m_budget = bytes;
+}
+
+unsigned long long TextureResidency::getBudget() {
+
+    return m_budget;
+}
+
+unsigned long long TextureResidency::getFrame() {
+
+    return m_frame;
+}
+
+void TextureResidency::track(TextureResource* texture) {
+
+    if (std::find(m_textures.begin(), m_textures.end(), texture) ==
+        m_textures.end()) {
+
+        m_textures.push_back(texture);
+    }
+}
+
+void TextureResidency::untrack(TextureResource* texture) {
+
+    m_textures.erase(
+        std::remove(m_textures.begin(), m_textures.end(), texture),
+        m_textures.end());
+}
+
+void TextureResidency::restore(TextureResource* texture) {
+
+    static const unsigned reloadCounter =
+        counters::get("texture.reloads", counters::PER_FRAME);
+
+    texture->restore();
+    ++m_reloads;
+    counters::add(reloadCounter);
+}
+
+void TextureResidency::endFrame() {
+
+    OMI_PROFILE_SCOPE("TextureResidency::endFrame");
+
+    static const unsigned residentCounter =
+        counters::get("texture.resident_bytes", counters::GAUGE);
+    static const unsigned evictedCounter =
+        counters::get("texture.evicted", counters::GAUGE);
+    static const unsigned evictionCounter =
+        counters::get("texture.evictions", counters::PER_FRAME);
+
+    Stats stats = getStats();
+    while (m_budget > 0 && stats.residentBytes > m_budget) {
+
+        // find the least recently used texture that wasn't used this frame
+        TextureResource* oldest = NULL;
+        for (std::vector<TextureResource*>::iterator it = m_textures.begin();
+             it != m_textures.end(); ++it) {
+
+            if (!(*it)->isEvicted() && (*it)->getLastUsed() < m_frame &&
+                (oldest == NULL ||
+                 (*it)->getLastUsed() < oldest->getLastUsed())) {
+
+                oldest = *it;
+            }
+        }
+        if (oldest == NULL) {
+
+            break;
+        }
+
+        stats.residentBytes -= oldest->getMemory().bytes;
+        --stats.resident;
+        ++stats.evicted;
+        oldest->evict();
+        ++m_evictions;
+        counters::add(evictionCounter);
+    }
+
+    counters::set(residentCounter, stats.residentBytes);
+    counters::set(evictedCounter, stats.evicted);
+    ++m_frame;
+}
+
+TextureResidency::Stats TextureResidency::getStats() {
+
+    Stats stats = { 0, 0, 0, m_evictions, m_reloads };
+    for (std::vector<TextureResource*>::const_iterator it = m_textures.begin();
+         it != m_textures.end(); ++it) {
+
+        if ((*it)->isEvicted()) {
+
+            ++stats.evicted;
+        }
+        else {
+
+            ++stats.resident;
+            stats.residentBytes += (*it)->getMemory().bytes;
+        }
+    }
+    return stats;
+}
+
+} // namespace omi
\ No newline at end of file
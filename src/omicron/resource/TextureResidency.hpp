@@ -0,0 +1,112 @@
+#ifndef OMICRON_RESOURCE_TEXTURERESIDENCY_H_
+#   define OMICRON_RESOURCE_TEXTURERESIDENCY_H_
+
+#include <vector>
+
+#include "lib/Utilitron/MacroUtil.hpp"
+
+namespace omi {
+
+class TextureResource;
+
+/****************************************************************************\
+| Keeps the video memory used by loaded textures within a budget. Textures   |
+| record the frame they were last bound in, and at the end of each frame the |
+| least recently used are evicted until the budget is met. An evicted        |
+| texture keeps its OpenGL id and is reloaded the next time it is bound, so  |
+| copies of it held by materials never need to know.                         |
+|                                                                            |
+| Textures bound during the current frame are never evicted, so the budget   |
+| can be exceeded for a frame that uses more textures than fit within it.    |
+\****************************************************************************/
+class TextureResidency {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                RESTRICTIONS
+    //--------------------------------------------------------------------------
+
+    DISALLOW_CONSTRUCTION(TextureResidency);
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                  STRUCTS
+    //--------------------------------------------------------------------------
+
+    //! a snapshot of the state of every loaded texture
+    struct Stats {
+
+        // the number of loaded textures in video memory
+        unsigned resident;
+        // the number of loaded textures that have been evicted
+        unsigned evicted;
+        // the video memory used by the resident textures in bytes
+        unsigned long long residentBytes;
+        // the number of times a texture has been evicted
+        unsigned long long evictions;
+        // the number of times an evicted texture has been reloaded
+        unsigned long long reloads;
+    };
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** Sets the video memory textures may use
+    @param bytes the budget in bytes, or 0 for no budget */
+    static void setBudget(unsigned long long bytes);
+
+    /** @return the video memory textures may use in bytes, 0 if there is no
+    budget */
+    static unsigned long long getBudget();
+
+    /** @return the number of the current frame, used to order textures by when
+    they were last used */
+    static unsigned long long getFrame();
+
+    /** #Hidden
+    Starts tracking a texture that has been loaded
+    @param texture the texture to track */
+    static void track(TextureResource* texture);
+
+    /** #Hidden
+    Stops tracking a texture that has been released
+    @param texture the texture to stop tracking */
+    static void untrack(TextureResource* texture);
+
+    /** #Hidden
+    Reloads a texture that has been evicted
+    @param texture the texture to reload */
+    static void restore(TextureResource* texture);
+
+    /** Evicts the least recently used textures until the budget is met and
+    begins the next frame. This should be called once at the end of each
+    frame. */
+    static void endFrame();
+
+    /** @return the current state of every loaded texture */
+    static Stats getStats();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the video memory textures may use, 0 for no budget
+    static unsigned long long m_budget;
+    // the number of the current frame
+    static unsigned long long m_frame;
+    // the number of evictions and reloads since the start
+    static unsigned long long m_evictions;
+    static unsigned long long m_reloads;
+
+    // every loaded texture, there are few enough that finding the least
+    // recently used by searching is cheaper than keeping them ordered
+    static std::vector<TextureResource*> m_textures;
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
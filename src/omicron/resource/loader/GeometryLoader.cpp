@@ -10,6 +10,8 @@ namespace loader {
 
 Geometry* geoFromWavefront(const std::string& filePath) {
 
+    OMI_PROFILE_SCOPE("loader::geoFromWavefront");
+
     // the unsorted lists of geometry data
     t_VertexArray vertices;
     t_UVArray     uv;
@@ -12,6 +12,8 @@
 #include "lib/Utilitron/StringUtil.hpp"
 #include "lib/Utilitron/Vector.hpp"
 
+#include "src/omicron/Omicron.hpp"
+#include "src/omicron/debug/Profiler.hpp"
 #include "src/omicron/rendering/object_data/Geometry.hpp"
 #include "src/omicron/rendering/shading/Animation.hpp"
 #include "src/omicron/rendering/shading/Material.hpp"
@@ -25,12 +27,52 @@ namespace omi {
 \***********************************************/
 namespace loader {
 
+//------------------------------------------------------------------------------
+//                                    STRUCTS
+//------------------------------------------------------------------------------
+
+/***************************************************************************\
+| A shader that has been handed to the driver but may still be compiling.   |
+| Nothing about the shader is queried until it is finished so the driver is |
+| free to compile many at once.                                             |
+\***************************************************************************/
+struct PendingShader {
+
+    // the path to the vertex shader
+    std::string vertexPath;
+    // the path to the fragment shader
+    std::string fragmentPath;
+    // the path of the shader's binary in the cache, empty if not cached
+    std::string cachePath;
+    // the OpenGL shader and program objects
+    GLuint vertex;
+    GLuint fragment;
+    GLuint program;
+    // if the program was loaded from a cached binary
+    bool cached;
+    // the time spent on the shader so far in microseconds
+    util::int64 time;
+};
+
+// the video memory used by loaded textures
+struct TextureMemory {
+
+    // the bytes of video memory used
+    unsigned bytes;
+    // the bytes the same textures would use as uncompressed RGBA
+    unsigned uncompressedBytes;
+};
+
 //------------------------------------------------------------------------------
 //                                   FUNCTIONS
 //------------------------------------------------------------------------------
 
 //--------------------------------SHADER LOADERS--------------------------------
 
+/** Sets the directory linked shader programs are cached in
+@param directory the cache directory, or empty to disable the cache */
+void setShaderCacheDirectory(const std::string& directory);
+
 /** Loads a shader from seperate file paths for each shader
 @param vertexPath the path to the vertex shader
 @param fragmentPath the path to the fragment shader */
@@ -38,22 +80,119 @@ Shader loadShaderFromFiles(
         const std::string& vertexPath,
         const std::string& fragmentPath);
 
+/** Starts loading a shader, either from the binary cache or by submitting
+its sources to be compiled and linked. This does not wait for the driver.
+@param vertexPath the path to the vertex shader
+@param fragmentPath the path to the fragment shader
+@return the shader to pass to finishShader */
+PendingShader beginShader(
+        const std::string& vertexPath,
+        const std::string& fragmentPath);
+
+/** Waits for a pending shader, checks it, and stores newly linked programs in
+the binary cache
+@param pending the shader returned by beginShader
+@return the loaded shader */
+Shader finishShader(PendingShader& pending);
+
 //-------------------------------TEXTURE LOADERS--------------------------------
 
+/** Sets the directory block compressed textures are cached in
+@param directory the cache directory, or empty to disable the cache */
+void setTextureCacheDirectory(const std::string& directory);
+
 /** Loads a texture from an image file
 @param filePath the path to the image
+@param compression the format to compress the texture to, the texture is
+                   loaded uncompressed if the result is too different from
+                   the image
+@param memory returns the video memory used by the texture
 @return the loaded texture */
-Texture* textureFromImage(const std::string& filePath);
+Texture* textureFromImage(
+        const std::string&     filePath,
+              tex::Compression compression,
+              TextureMemory&   memory);
 
 /** Loads an animation from an image sequence
 @param filePath the path of the sequence (omitting the frame number)
 @param frameRate the playback speed of the animation
 @param repeat if the animation should repeat 
 @param begin the beginning frame of the animation
-@param end the ending frame of the animation */
+@param end the ending frame of the animation
+@param compression the format to compress each frame to
+@param memory returns the video memory used by the animation */
 Texture* animationFromImage(
     const std::string& filePath, unsigned frameRate,
-    bool repeat, unsigned begin, unsigned end);
+    bool repeat, unsigned begin, unsigned end,
+    tex::Compression compression, TextureMemory& memory);
+
+/** Loads an image sequence into a single texture with the frames stacked
+vertically, the first frame at the bottom. Every frame must be the same size.
+@param filePath the path of the sequence (omitting the frame number)
+@param begin the first frame of the sequence
+@param end the last frame of the sequence
+@param memory returns the video memory used by the atlas
+@return the loaded texture */
+Texture* atlasFromImage(
+    const std::string& filePath, unsigned begin, unsigned end,
+    TextureMemory& memory);
+
+/** Loads an image file into an existing texture, used to restore a texture
+that was evicted without invalidating copies of it
+@param textureId the OpenGL id of the texture
+@param filePath the path to the image
+@param compression the format to compress the texture to
+@param memory returns the video memory used by the texture */
+void reloadTexture(
+              GLuint           textureId,
+        const std::string&     filePath,
+              tex::Compression compression,
+              TextureMemory&   memory);
+
+/** Loads an image sequence into the existing textures of an animation
+@param textures the OpenGL ids of each frame of the animation
+@param filePath the path of the sequence (omitting the frame number)
+@param begin the beginning frame of the animation
+@param compression the format to compress each frame to
+@param memory returns the video memory used by the animation */
+void reloadAnimation(
+        const t_TextureList&   textures,
+        const std::string&     filePath,
+              unsigned         begin,
+              tex::Compression compression,
+              TextureMemory&   memory);
+
+/** Loads an image sequence into an existing atlas
+@param textureId the OpenGL id of the atlas
+@param filePath the path of the sequence (omitting the frame number)
+@param begin the first frame of the sequence
+@param end the last frame of the sequence
+@param memory returns the video memory used by the atlas */
+void reloadAtlas(
+              GLuint         textureId,
+        const std::string&   filePath,
+              unsigned       begin,
+              unsigned       end,
+              TextureMemory& memory);
+
+/** Frees the video memory used by a texture. The texture's id stays valid
+and can be loaded into again.
+@param textureId the OpenGL id of the texture */
+void evictTexture(GLuint textureId);
+
+/** Builds the mip-map chain of an image on the job system's threads. Colours
+are filtered premultiplied by their alpha so transparent pixels don't bleed
+into the visible ones.
+@param pixels the RGBA pixels of the full size image
+@param width the width of the image
+@param height the height of the image
+@param levels returns the RGBA pixels of each level below the full size image,
+              down to 1x1 */
+void generateMipmaps(
+        const unsigned char*                            pixels,
+              unsigned                                  width,
+              unsigned                                  height,
+              std::vector<std::vector<unsigned char> >& levels);
 
 //-------------------------------MATERIAL LOADER--------------------------------
 
@@ -1,74 +1,321 @@
 #include "Loaders.hpp"
 
+#include <algorithm>
+#include <vector>
+
+#include "src/omicron/debug/Counters.hpp"
+
 namespace omi {
 
 namespace loader {
 
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+namespace {
+
+// the directory linked programs are cached in
+static std::string cacheDirectory = "res/gfx/shader/cache/";
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** @return if the driver is able to save and restore linked programs */
+bool binariesSupported() {
+
+    if (!GLEW_ARB_get_program_binary) {
+
+        return false;
+    }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+/** @return a string identifying the driver, binaries from one driver can't be
+used by another */
+std::string driverString() {
+
+    std::string driver;
+    const GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    for (unsigned i = 0; i < 3; ++i) {
+
+        const GLubyte* name = glGetString(names[i]);
+        if (name != NULL) {
+
+            driver += reinterpret_cast<const char*>(name);
+        }
+        driver += '\n';
+    }
+    return driver;
+}
+
+/** Finds the path a program is cached at from its sources and the driver
+@param vertexSource the source of the vertex shader
+@param fragmentSource the source of the fragment shader
+@return the path of the cached binary */
+std::string cachePathFor(
+        const std::string& vertexSource,
+        const std::string& fragmentSource) {
+
+    static const std::string driver = driverString();
+
+    std::stringstream path;
+    path << cacheDirectory << std::hex;
+    path.width(16);
+    path.fill('0');
+    path << util::str::hash(
+        vertexSource + '\0' + fragmentSource + '\0' + driver) << ".bin";
+    return path.str();
+}
+
+/** Creates a program from a cached binary
+@param filePath the path to the cached binary
+@return the program or 0 if there is no usable binary */
+GLuint programFromCache(const std::string& filePath) {
+
+    std::string contents;
+    util::file::fileToString(filePath, contents);
+    if (contents.size() <= sizeof(GLenum)) {
+
+        return 0;
+    }
+
+    // the binary format is stored before the binary
+    GLenum format;
+    std::copy(contents.begin(), contents.begin() + sizeof(GLenum),
+        reinterpret_cast<char*>(&format));
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(
+        program, format, contents.data() + sizeof(GLenum),
+        static_cast<GLsizei>(contents.size() - sizeof(GLenum)));
+    return program;
+}
+
+/** Writes a linked program to the cache
+@param program the linked program
+@param filePath the path to write the binary to */
+void programToCache(GLuint program, const std::string& filePath) {
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+
+        return;
+    }
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, NULL, &format, &binary[0]);
+
+    std::ofstream file(filePath.c_str(), std::ios::out | std::ios::binary);
+    if (!file.good()) {
+
+        std::cout << "SHADER LOADER: unable to write cache file " <<
+            filePath << std::endl;
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&format), sizeof(GLenum));
+    file.write(&binary[0], length);
+}
+
+/** Submits a shader's sources to be compiled and linked without waiting for
+the result
+@param pending the shader to compile
+@param vertexSource the source of the vertex shader
+@param fragmentSource the source of the fragment shader */
+void submitSources(
+              PendingShader& pending,
+        const std::string&   vertexSource,
+        const std::string&   fragmentSource) {
+
+    // create the shader and program objects
+    pending.program  = glCreateProgram();
+    pending.vertex   = glCreateShader(GL_VERTEX_SHADER);
+    pending.fragment = glCreateShader(GL_FRAGMENT_SHADER);
+    pending.cached   = false;
+
+    // load shader source code into OpenGL
+    const GLchar* vertex = vertexSource.c_str();
+    const GLchar* fragment = fragmentSource.c_str();
+    glShaderSource(pending.vertex,   1, &vertex,   NULL);
+    glShaderSource(pending.fragment, 1, &fragment, NULL);
+
+    // compile the shaders, attach them, and link the program
+    glCompileShader(pending.vertex);
+    glCompileShader(pending.fragment);
+    glAttachShader(pending.program, pending.vertex);
+    glAttachShader(pending.program, pending.fragment);
+    if (!pending.cachePath.empty()) {
+
+        glProgramParameteri(
+            pending.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(pending.program);
+}
+
+/** Prints the info log of a shader that failed to compile
+@param shader the shader to check
+@param filePath the path the shader was loaded from */
+void checkCompile(GLuint shader, const std::string& filePath) {
+
+    GLint result;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &result);
+    if (result == GL_FALSE) {
+
+        GLint length;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length + 1, '\0');
+        glGetShaderInfoLog(shader, length, NULL, &log[0]);
+
+        std::cout << "error compiling shader " << filePath << ". Log:" <<
+            std::endl;
+        std::cout << &log[0] << std::endl;
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void setShaderCacheDirectory(const std::string& directory) {
+
+    cacheDirectory = directory;
+    if (!cacheDirectory.empty() &&
+        cacheDirectory[cacheDirectory.size() - 1] != '/') {
+
+        cacheDirectory += '/';
+    }
+}
+
 Shader loadShaderFromFiles(
         const std::string& vertexPath,
         const std::string& fragmentPath) {
 
-    // create the shader and program objects
-    GLuint program        = glCreateProgram();
-    GLuint vertexShader   = glCreateShader(GL_VERTEX_SHADER);
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-
-    // read the files into char strings
-    std::string vertexContents;
-    util::file::fileToString(vertexPath, vertexContents);
-    const GLchar* vertexSource =
-        reinterpret_cast<const GLchar*>(vertexContents.c_str());
-    std::string fragmentContents;
-    util::file::fileToString(fragmentPath, fragmentContents);
-    const GLchar* fragmentSource =
-        reinterpret_cast<const GLchar*>(fragmentContents.c_str());
+    PendingShader pending = beginShader(vertexPath, fragmentPath);
+    return finishShader(pending);
+}
 
-    // load shader source code into OpenGL
-    glShaderSource(vertexShader,   1, &vertexSource,   NULL);
-    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
+PendingShader beginShader(
+        const std::string& vertexPath,
+        const std::string& fragmentPath) {
 
-    // compile the vertex shader
-    glCompileShader(vertexShader);
-    // int vLength = 0;
-    // int vMaxLength;
-    // glGetShaderiv(vertexShader, GL_INFO_LOG_LENGTH, &vMaxLength);
-    // char vertexInfoLog[vMaxLength];
-    // glGetShaderInfoLog(vertexShader, vMaxLength, &vLength, vertexInfoLog);
+    OMI_PROFILE_SCOPE("loader::beginShader");
 
-    // compile the fragment shader
-    glCompileShader(fragmentShader);
+    PendingShader pending;
+    pending.vertexPath   = vertexPath;
+    pending.fragmentPath = fragmentPath;
+    pending.vertex       = 0;
+    pending.fragment     = 0;
+    pending.program      = 0;
+    pending.cached       = false;
+    pending.time         = 0;
 
-    // attach the shaders to the program
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
+    // there is no OpenGL context to load into when running headless
+    if (systemSettings.isHeadless()) {
 
-    // link the program
-    glLinkProgram(program);
+        return pending;
+    }
+
+    util::int64 start = profile::now();
+
+    // read the files into strings
+    std::string vertexSource;
+    util::file::fileToString(vertexPath, vertexSource);
+    std::string fragmentSource;
+    util::file::fileToString(fragmentPath, fragmentSource);
+
+    // use the cached binary if there is one
+    if (!cacheDirectory.empty() && binariesSupported()) {
+
+        pending.cachePath = cachePathFor(vertexSource, fragmentSource);
+        pending.program = programFromCache(pending.cachePath);
+        pending.cached = pending.program != 0;
+    }
+    if (!pending.cached) {
+
+        submitSources(pending, vertexSource, fragmentSource);
+    }
+
+    pending.time += profile::now() - start;
+    return pending;
+}
+
+Shader finishShader(PendingShader& pending) {
+
+    OMI_PROFILE_SCOPE("loader::finishShader");
+
+    static const unsigned hitCounter =
+        counters::get("shader.cache_hits", counters::PER_FRAME);
+    static const unsigned missCounter =
+        counters::get("shader.cache_misses", counters::PER_FRAME);
+
+    if (systemSettings.isHeadless()) {
+
+        return Shader();
+    }
+
+    util::int64 start = profile::now();
 
-    // check to make sure the shaders have compiled correctly
     GLint result;
-    glGetProgramiv(program, GL_LINK_STATUS, &result);
+    glGetProgramiv(pending.program, GL_LINK_STATUS, &result);
+
+    // the driver may reject a binary even when it matches, so compile the
+    // sources instead
+    if (pending.cached && result == GL_FALSE) {
+
+        glDeleteProgram(pending.program);
+        std::string vertexSource;
+        util::file::fileToString(pending.vertexPath, vertexSource);
+        std::string fragmentSource;
+        util::file::fileToString(pending.fragmentPath, fragmentSource);
+        submitSources(pending, vertexSource, fragmentSource);
+        glGetProgramiv(pending.program, GL_LINK_STATUS, &result);
+    }
+    counters::add(pending.cached ? hitCounter : missCounter);
+
+    // check to make sure the shaders have compiled correctly
+    if (!pending.cached) {
+
+        checkCompile(pending.vertex, pending.vertexPath);
+        checkCompile(pending.fragment, pending.fragmentPath);
+    }
     if (result == GL_FALSE) {
 
         GLint length;
         char* log;
 
         // get the program info log
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        glGetProgramiv(pending.program, GL_INFO_LOG_LENGTH, &length);
         log = new char[length];
-        glGetProgramInfoLog(program, length, &result, log);
+        glGetProgramInfoLog(pending.program, length, &result, log);
 
         std::cout << "error compiling shader. Log:" << std::endl;
         std::cout << log << std::endl;
+        delete[] log;
 
         // clean up
-        glDeleteProgram(program);
-        program = 0;
+        glDeleteProgram(pending.program);
+        pending.program = 0;
 
         // TODO: freak out and throw an exception
     }
+    else if (!pending.cached && !pending.cachePath.empty()) {
+
+        programToCache(pending.program, pending.cachePath);
+    }
+
+    pending.time += profile::now() - start;
+    std::cout << "SHADER LOADER: " << pending.vertexPath << ", " <<
+        pending.fragmentPath << (pending.cached ? " loaded from cache in " :
+        " compiled in ") << (static_cast<float>(pending.time) / 1000.0f) <<
+        "ms" << std::endl;
 
-    return Shader(vertexShader, fragmentShader, program);
+    return Shader(pending.vertex, pending.fragment, pending.program);
 }
 
 } // namespace loader
@@ -1,11 +1,415 @@
 #include "Loaders.hpp"
 
+#include "lib/Utilitron/ImageUtil.hpp"
+
 namespace omi {
 
 namespace loader {
 
-GLuint loadTexture(const std::string& filePath) {
+//------------------------------------------------------------------------------
+//                                   VARIABLES
+//------------------------------------------------------------------------------
+
+namespace {
+
+// the directory compressed textures are cached in
+static std::string cacheDirectory = "res/gfx/texture/cache/";
+
+// the largest root mean square error a texture may have once compressed,
+// textures that are worse than this are loaded uncompressed
+static const float MAX_COMPRESSION_ERROR = 10.0f;
+
+// changes whenever the encoder or the cache layout does so that old cache
+// files are not used
+static const unsigned ENCODER_VERSION = 2;
+
+// the number of rows of a mip-map level halved by each job
+static const unsigned MIPMAP_ROWS_PER_JOB = 16;
+
+//------------------------------------------------------------------------------
+//                                     TYPES
+//------------------------------------------------------------------------------
+
+// the pixels or compressed blocks of each level of a mip-map chain
+typedef std::vector<std::vector<unsigned char> > t_Levels;
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/** @return the number of bytes in a block of the compression */
+unsigned blockBytes(tex::Compression compression) {
+
+    return compression == tex::BC1 ?
+        util::img::BC1_BLOCK_BYTES : util::img::BC3_BLOCK_BYTES;
+}
+
+/** @return the name of the compression for messages */
+const char* compressionName(tex::Compression compression) {
+
+    return compression == tex::BC1 ? "BC1" : "BC3";
+}
+
+/** @return the number of levels in the full mip-map chain of an image
+@param width the width of the image
+@param height the height of the image */
+unsigned chainLevels(unsigned width, unsigned height) {
+
+    unsigned levels = 1;
+    while (width > 1 || height > 1) {
+
+        width  = std::max(width  / 2, 1U);
+        height = std::max(height / 2, 1U);
+        ++levels;
+    }
+    return levels;
+}
+
+/** @return the number of bytes in the full mip-map chain of an image
+@param width the width of the image
+@param height the height of the image
+@param pixelBytes the number of bytes in each pixel */
+unsigned chainBytes(unsigned width, unsigned height, unsigned pixelBytes) {
+
+    unsigned bytes = 0;
+    while (true) {
+
+        bytes += width * height * pixelBytes;
+        if (width == 1 && height == 1) {
+
+            return bytes;
+        }
+        width  = std::max(width  / 2, 1U);
+        height = std::max(height / 2, 1U);
+    }
+}
+
+/** Sets the wrapping and filtering of the bound texture */
+void setParameters() {
+
+    // set clamps
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // set the filtering modes
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+/** Finds the path a compressed texture is cached at from the contents of its
+image file
+@param filePath the path to the image
+@param compression the format the texture was requested in, the cached
+                   texture may be in another
+@return the path of the cached texture or empty if caching is disabled */
+std::string cachePathFor(
+        const std::string&     filePath,
+              tex::Compression compression) {
+
+    if (cacheDirectory.empty()) {
+
+        return "";
+    }
+
+    std::string contents;
+    util::file::fileToString(filePath, contents);
+    std::stringstream key;
+    key << contents << '\0' << ENCODER_VERSION << '\0' << compression;
+
+    std::stringstream path;
+    path << cacheDirectory << std::hex;
+    path.width(16);
+    path.fill('0');
+    path << util::str::hash(key.str()) << ".bc";
+    return path.str();
+}
+
+/** Reads a compressed texture from the cache
+@param filePath the path to the cached texture
+@param compression returns the format the texture is compressed in, or
+                   UNCOMPRESSED if it was too poor to compress and should be
+                   loaded uncompressed
+@param width returns the width of the texture
+@param height returns the height of the texture
+@param levels returns the blocks of each mip-map level
+@return if the texture was in the cache and is consistent */
+bool readCache(
+        const std::string&      filePath,
+              tex::Compression& compression,
+              unsigned&         width,
+              unsigned&         height,
+              t_Levels&         levels) {
+
+    std::ifstream file(filePath.c_str(), std::ios::in | std::ios::binary);
+    unsigned format = 0;
+    unsigned count = 0;
+    file.read(reinterpret_cast<char*>(&format), sizeof(unsigned));
+    file.read(reinterpret_cast<char*>(&width),  sizeof(unsigned));
+    file.read(reinterpret_cast<char*>(&height), sizeof(unsigned));
+    file.read(reinterpret_cast<char*>(&count),  sizeof(unsigned));
+    if (!file.good() || format > tex::BC3) {
+
+        return false;
+    }
+    compression = static_cast<tex::Compression>(format);
+
+    // rejected textures are only marked so they aren't compressed again
+    if (compression == tex::UNCOMPRESSED) {
+
+        levels.clear();
+        return count == 0;
+    }
+
+    // the chain must be complete and each level the size of its blocks
+    if (width == 0 || height == 0 || count != chainLevels(width, height)) {
 
+        return false;
+    }
+    levels.resize(count);
+    unsigned levelWidth  = width;
+    unsigned levelHeight = height;
+    for (unsigned i = 0; i < count; ++i) {
+
+        unsigned size = 0;
+        file.read(reinterpret_cast<char*>(&size), sizeof(unsigned));
+        unsigned expected = ((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) *
+            blockBytes(compression);
+        if (!file.good() || size != expected) {
+
+            return false;
+        }
+        levels[i].resize(size);
+        file.read(reinterpret_cast<char*>(&levels[i][0]), size);
+        levelWidth  = std::max(levelWidth  / 2, 1U);
+        levelHeight = std::max(levelHeight / 2, 1U);
+    }
+    return file.good();
+}
+
+/** Writes a compressed texture to the cache
+@param filePath the path to write the texture to
+@param compression the format the texture is compressed in, or UNCOMPRESSED
+                   to mark that it is too poor to compress
+@param width the width of the texture
+@param height the height of the texture
+@param levels the blocks of each mip-map level, empty if it is uncompressed */
+void writeCache(
+        const std::string&     filePath,
+              tex::Compression compression,
+              unsigned         width,
+              unsigned         height,
+        const t_Levels&        levels) {
+
+    std::ofstream file(filePath.c_str(), std::ios::out | std::ios::binary);
+    if (!file.good()) {
+
+        std::cout << "TEXTURE LOADER: unable to write cache file " <<
+            filePath << std::endl;
+        return;
+    }
+
+    unsigned format = compression;
+    unsigned count = static_cast<unsigned>(levels.size());
+    file.write(reinterpret_cast<const char*>(&format), sizeof(unsigned));
+    file.write(reinterpret_cast<const char*>(&width),  sizeof(unsigned));
+    file.write(reinterpret_cast<const char*>(&height), sizeof(unsigned));
+    file.write(reinterpret_cast<const char*>(&count),  sizeof(unsigned));
+    for (unsigned i = 0; i < count; ++i) {
+
+        unsigned size = static_cast<unsigned>(levels[i].size());
+        file.write(reinterpret_cast<const char*>(&size), sizeof(unsigned));
+        file.write(reinterpret_cast<const char*>(&levels[i][0]), size);
+    }
+}
+
+/** Compresses an image and its mip-map chain
+@param pixels the RGBA pixels of the image
+@param width the width of the image
+@param height the height of the image
+@param compression the format to compress to
+@param levels returns the blocks of each mip-map level
+@return the root mean square error of the compressed image */
+float compressImage(
+        const unsigned char*   pixels,
+              unsigned         width,
+              unsigned         height,
+              tex::Compression compression,
+              t_Levels&        levels) {
+
+    OMI_PROFILE_SCOPE("loader::compressImage");
+
+    bool alpha = compression == tex::BC3;
+    levels.assign(1, std::vector<unsigned char>());
+
+    // only the full size image is checked
+    std::vector<unsigned char> decoded;
+    if (alpha) {
+
+        util::img::compressBC3(pixels, width, height, levels[0]);
+        util::img::decompressBC3(&levels[0][0], width, height, decoded);
+    }
+    else {
+
+        util::img::compressBC1(pixels, width, height, levels[0]);
+        util::img::decompressBC1(&levels[0][0], width, height, decoded);
+    }
+    float error = util::img::rootMeanSquareError(
+        pixels, &decoded[0], width * height, alpha);
+    if (error > MAX_COMPRESSION_ERROR) {
+
+        return error;
+    }
+
+    // compress the rest of the chain a level per job
+    t_Levels mipmaps;
+    generateMipmaps(pixels, width, height, mipmaps);
+    levels.resize(mipmaps.size() + 1);
+    jobSystem.parallelFor(
+        static_cast<unsigned>(mipmaps.size()), 1, [&] (unsigned i) {
+
+        unsigned levelWidth  = std::max(width  >> (i + 1), 1U);
+        unsigned levelHeight = std::max(height >> (i + 1), 1U);
+        if (alpha) {
+
+            util::img::compressBC3(
+                &mipmaps[i][0], levelWidth, levelHeight, levels[i + 1]);
+        }
+        else {
+
+            util::img::compressBC1(
+                &mipmaps[i][0], levelWidth, levelHeight, levels[i + 1]);
+        }
+    });
+    return error;
+}
+
+/** Binds a texture, creating it first if it doesn't exist yet
+@param textureId the OpenGL id of the texture, or 0 to create a new one
+@return the OpenGL id of the bound texture */
+GLuint bindTexture(GLuint textureId) {
+
+    if (textureId == 0) {
+
+        glGenTextures(1, &textureId);
+    }
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    return textureId;
+}
+
+/** @return the path of a frame of an image sequence
+@param filePath the path of the sequence (omitting the frame number)
+@param frame the number of the frame */
+std::string framePath(const std::string& filePath, unsigned frame) {
+
+    // separate the filename and extension
+    unsigned divider = filePath.find_last_of('.');
+    std::stringstream ss;
+    ss << filePath.substr(0, divider) << "." << frame << "." <<
+        filePath.substr(divider + 1, filePath.length());
+    return ss.str();
+}
+
+/** Creates a texture from compressed mip-map levels
+@param textureId the texture to load into, or 0 to create a new one
+@param width the width of the texture
+@param height the height of the texture
+@param compression the format the levels are compressed in
+@param levels the blocks of each mip-map level
+@param memory returns the video memory used by the texture
+@return the OpenGL id of the texture */
+GLuint uploadCompressed(
+              GLuint           textureId,
+              unsigned         width,
+              unsigned         height,
+              tex::Compression compression,
+        const t_Levels&        levels,
+              TextureMemory&   memory) {
+
+    GLenum format = compression == tex::BC1 ?
+        GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+    textureId = bindTexture(textureId);
+
+    unsigned levelWidth  = width;
+    unsigned levelHeight = height;
+    for (unsigned i = 0; i < levels.size(); ++i) {
+
+        glCompressedTexImage2D(
+            GL_TEXTURE_2D, i, format, levelWidth, levelHeight, 0,
+            static_cast<GLsizei>(levels[i].size()), &levels[i][0]);
+        memory.bytes += static_cast<unsigned>(levels[i].size());
+        levelWidth  = std::max(levelWidth  / 2, 1U);
+        levelHeight = std::max(levelHeight / 2, 1U);
+    }
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+        static_cast<GLint>(levels.size()) - 1);
+    setParameters();
+
+    memory.uncompressedBytes += chainBytes(width, height, 4);
+    return textureId;
+}
+
+/** Loads a texture from an image file
+@param textureId the texture to load into, or 0 to create a new one
+@param filePath the path to the image
+@param compression the format to compress the texture to
+@param memory returns the video memory used by the texture
+@return the OpenGL id of the texture */
+GLuint loadTexture(
+              GLuint           textureId,
+        const std::string&     filePath,
+              tex::Compression compression,
+              TextureMemory&   memory) {
+
+    OMI_PROFILE_SCOPE("loader::loadTexture");
+
+    // there is no OpenGL context to load into when running headless
+    if (systemSettings.isHeadless()) {
+
+        return 0;
+    }
+
+    if (compression != tex::UNCOMPRESSED &&
+        !GLEW_EXT_texture_compression_s3tc) {
+
+        static bool warned = false;
+        if (!warned) {
+
+            std::cout << "TEXTURE LOADER: block compression is not " <<
+                "supported, textures will be loaded uncompressed" << std::endl;
+            warned = true;
+        }
+        compression = tex::UNCOMPRESSED;
+    }
+
+    // use the cached texture if it has been compressed before, the cache is
+    // keyed by the requested format but holds the one that was used
+    std::string cachePath;
+    if (compression != tex::UNCOMPRESSED) {
+
+        cachePath = cachePathFor(filePath, compression);
+        tex::Compression cached;
+        unsigned width;
+        unsigned height;
+        t_Levels levels;
+        if (!cachePath.empty() &&
+            readCache(cachePath, cached, width, height, levels)) {
+
+            if (cached != tex::UNCOMPRESSED) {
+
+                return uploadCompressed(
+                    textureId, width, height, cached, levels, memory);
+            }
+
+            // it was too poor to compress last time
+            compression = tex::UNCOMPRESSED;
+            cachePath.clear();
+        }
+    }
 
     //--------------------------LOAD IMAGE USING DEVIL--------------------------
 
@@ -51,19 +455,68 @@ GLuint loadTexture(const std::string& filePath) {
     //get the important parameters from the image
     int width  = ilGetInteger(IL_IMAGE_WIDTH);
     int height = ilGetInteger(IL_IMAGE_HEIGHT);
-    int type   = ilGetInteger(IL_IMAGE_TYPE);
-    int format = ilGetInteger(IL_IMAGE_FORMAT);
 
+    // the mip-maps are built from RGBA pixels
+    if (!ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE)) {
 
-    //--------------------------CREATE OPENGL TEXTURE---------------------------
+        std::cout << "TEXTURE LOADER: unable to convert " << filePath <<
+            " to RGBA" << std::endl;
+        ilBindImage(0);
+        ilDeleteImages(1, &imageId);
+        return 0;
+    }
+    data = ilGetData();
 
 
-    // the id of the texture in OpenGL
-    GLuint textureId;
+    //-----------------------------COMPRESS TEXTURE-----------------------------
 
-    // generate and bind the texture
-    glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+
+    if (compression != tex::UNCOMPRESSED) {
+
+        // BC1 would lose the alpha
+        if (compression == tex::BC1 && !util::img::isOpaque(
+                static_cast<const unsigned char*>(data), width * height)) {
+
+            std::cout << "TEXTURE LOADER: " << filePath << " has alpha, " <<
+                "using BC3 instead of BC1" << std::endl;
+            compression = tex::BC3;
+        }
+
+        t_Levels levels;
+        float error = compressImage(
+            static_cast<const unsigned char*>(data), width, height,
+            compression, levels);
+        if (error <= MAX_COMPRESSION_ERROR) {
+
+            std::cout << "TEXTURE LOADER: compressed " << filePath << " to " <<
+                compressionName(compression) << " with an error of " <<
+                error << std::endl;
+            if (!cachePath.empty()) {
+
+                writeCache(cachePath, compression, width, height, levels);
+            }
+
+            ilBindImage(0);
+            ilDeleteImages(1, &imageId);
+            return uploadCompressed(
+                textureId, width, height, compression, levels, memory);
+        }
+
+        std::cout << "TEXTURE LOADER: " << filePath << " has an error of " <<
+            error << " as " << compressionName(compression) <<
+            ", loading it uncompressed" << std::endl;
+        if (!cachePath.empty()) {
+
+            writeCache(cachePath, tex::UNCOMPRESSED, width, height, t_Levels());
+        }
+    }
+
+
+    //--------------------------CREATE OPENGL TEXTURE---------------------------
+
+
+    // generate the texture if it doesn't exist yet and bind it
+    textureId = bindTexture(textureId);
 
     // set the pixel store parameters
     glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_FALSE);
@@ -73,60 +526,295 @@ GLuint loadTexture(const std::string& filePath) {
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     // load the texture into OpenGL
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width,
-                 height, 0, format, type, data);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+    // build the mip-maps and upload each level once
+    t_Levels mipmaps;
+    generateMipmaps(
+        static_cast<const unsigned char*>(data), width, height, mipmaps);
+    for (unsigned i = 0; i < mipmaps.size(); ++i) {
+
+        glTexImage2D(GL_TEXTURE_2D, i + 1, GL_RGBA,
+                     std::max(width  >> (i + 1), 1),
+                     std::max(height >> (i + 1), 1), 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, &mipmaps[i][0]);
+    }
+    glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+        static_cast<GLint>(mipmaps.size()));
+    setParameters();
 
-    // build mip-maps
-    gluBuild2DMipmaps(GL_TEXTURE_2D, format, width, height, format, type, data);
+    unsigned bytes = chainBytes(width, height, 4);
+    memory.bytes += bytes;
+    memory.uncompressedBytes += bytes;
 
-    // set clamps
+    ilBindImage(0);
+    ilDeleteImages(1, &imageId);
+
+
+    //---------------------------RETURN THE OPENGL ID---------------------------
+
+
+    return textureId;
+}
+
+/** Loads an image sequence into a single texture with the frames stacked
+vertically
+@param textureId the texture to load into, or 0 to create a new one
+@param filePath the path of the sequence (omitting the frame number)
+@param begin the first frame of the sequence
+@param end the last frame of the sequence
+@param memory returns the video memory used by the atlas
+@return the OpenGL id of the texture */
+GLuint loadAtlas(
+              GLuint         textureId,
+        const std::string&   filePath,
+              unsigned       begin,
+              unsigned       end,
+              TextureMemory& memory) {
+
+    OMI_PROFILE_SCOPE("loader::loadAtlas");
+
+    // there is no OpenGL context to load into when running headless
+    if (systemSettings.isHeadless()) {
+
+        return 0;
+    }
+
+    // load each frame and stack it above the previous one
+    std::vector<unsigned char> pixels;
+    int width  = 0;
+    int height = 0;
+    for (unsigned i = begin; i <= end; ++i) {
+
+        std::string path = framePath(filePath, i);
+
+        ILuint imageId;
+        ilGenImages(1, &imageId);
+        ilBindImage(imageId);
+        ilEnable(IL_ORIGIN_SET);
+        ilOriginFunc(IL_ORIGIN_LOWER_LEFT);
+
+        // every frame is converted to the same format so they can be combined
+        if (!ilLoadImage((ILstring) path.c_str()) ||
+            !ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE)) {
+
+            std::cout << "TEXTURE LOADER: unable to load atlas frame " <<
+                path << std::endl;
+            ilBindImage(0);
+            ilDeleteImages(1, &imageId);
+            continue;
+        }
+
+        int frameWidth  = ilGetInteger(IL_IMAGE_WIDTH);
+        int frameHeight = ilGetInteger(IL_IMAGE_HEIGHT);
+        if (pixels.empty()) {
+
+            width  = frameWidth;
+            height = frameHeight;
+        }
+        if (frameWidth != width || frameHeight != height) {
+
+            std::cout << "TEXTURE LOADER: atlas frame " << path <<
+                " is not the same size as the first frame" << std::endl;
+        }
+        else {
+
+            const unsigned char* data = ilGetData();
+            pixels.insert(pixels.end(), data, data + (width * height * 4));
+        }
+
+        ilBindImage(0);
+        ilDeleteImages(1, &imageId);
+    }
+
+    if (pixels.empty()) {
+
+        return 0;
+    }
+
+    // the frames are stacked in order so frame i is at the i'th row of the
+    // atlas, if any were skipped the texture co-ordinates will be off
+    int frames = static_cast<int>(end - begin) + 1;
+    pixels.resize(width * height * frames * 4, 0);
+
+    textureId = bindTexture(textureId);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height * frames, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+
+    // mip-maps would blend neighbouring frames so only linear filtering is used
     glTexParameteri(
         GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(
         GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    // set the filtering modes
     glTexParameteri(
-        GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(
         GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    //---------------------------RETURN THE OPENGL ID---------------------------
-
+    memory.bytes += static_cast<unsigned>(pixels.size());
+    memory.uncompressedBytes += static_cast<unsigned>(pixels.size());
 
     return textureId;
 }
 
-Texture* textureFromImage(const std::string& filePath) {
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+void setTextureCacheDirectory(const std::string& directory) {
+
+    cacheDirectory = directory;
+    if (!cacheDirectory.empty() &&
+        cacheDirectory[cacheDirectory.size() - 1] != '/') {
 
-    return new Texture(loadTexture(filePath));
+        cacheDirectory += '/';
+    }
+}
+
+Texture* textureFromImage(
+        const std::string&     filePath,
+              tex::Compression compression,
+              TextureMemory&   memory) {
+
+    return new Texture(loadTexture(0, filePath, compression, memory));
 }
 
 Texture* animationFromImage(
     const std::string& filePath, unsigned frameRate,
-    bool repeat, unsigned begin, unsigned end) {
-
-    // separate the filename and extension
-    unsigned divider = filePath.find_last_of('.');
-    std::string filename  = filePath.substr(0, divider);
-    std::string extension = filePath.substr(divider + 1, filePath.length());
+    bool repeat, unsigned begin, unsigned end,
+    tex::Compression compression, TextureMemory& memory) {
 
     // load each texture and insert into a list
     std::vector<GLuint> textures;
     for (unsigned i = begin; i <= end; ++i) {
 
         // TODO: freak out if the file doesn't exist
+        textures.push_back(
+            loadTexture(0, framePath(filePath, i), compression, memory));
+    }
 
-        // create the texture name and load it
-        std::stringstream ss;
-        ss << filename << "." << i << "." << extension;
+    return new Animation(textures, frameRate, repeat);
+}
+
+Texture* atlasFromImage(
+    const std::string& filePath, unsigned begin, unsigned end,
+    TextureMemory& memory) {
+
+    return new Texture(loadAtlas(0, filePath, begin, end, memory));
+}
+
+void reloadTexture(
+              GLuint           textureId,
+        const std::string&     filePath,
+              tex::Compression compression,
+              TextureMemory&   memory) {
+
+    loadTexture(textureId, filePath, compression, memory);
+}
+
+void reloadAnimation(
+        const t_TextureList&   textures,
+        const std::string&     filePath,
+              unsigned         begin,
+              tex::Compression compression,
+              TextureMemory&   memory) {
+
+    for (unsigned i = 0; i < textures.size(); ++i) {
 
-        textures.push_back(loadTexture(ss.str()));
+        loadTexture(
+            textures[i], framePath(filePath, begin + i), compression, memory);
     }
+}
 
-    return new Animation(textures, frameRate, repeat);
+void reloadAtlas(
+              GLuint         textureId,
+        const std::string&   filePath,
+              unsigned       begin,
+              unsigned       end,
+              TextureMemory& memory) {
+
+    loadAtlas(textureId, filePath, begin, end, memory);
 }
 
+void evictTexture(GLuint textureId) {
+
+    if (systemSettings.isHeadless() || textureId == 0) {
+
+        return;
+    }
+
+    // respecifying each level with no size frees its storage but keeps the
+    // texture's id valid for any copies of it
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    for (GLint level = 0; ; ++level) {
+
+        GLint width = 0;
+        glGetTexLevelParameteriv(
+            GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+        if (width == 0) {
+
+            break;
+        }
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void generateMipmaps(
+        const unsigned char* pixels,
+              unsigned       width,
+              unsigned       height,
+              t_Levels&      levels) {
+
+    OMI_PROFILE_SCOPE("loader::generateMipmaps");
+
+    levels.clear();
+
+    // opaque images are the same premultiplied so the conversions are skipped
+    bool opaque = util::img::isOpaque(pixels, width * height);
+    std::vector<unsigned char> image(pixels, pixels + width * height * 4);
+    if (!opaque) {
+
+        util::img::premultiply(&image[0], width * height);
+    }
+
+    std::vector<unsigned char> half;
+    while (width > 1 || height > 1) {
+
+        unsigned halfWidth  = std::max(width  / 2, 1U);
+        unsigned halfHeight = std::max(height / 2, 1U);
+        half.resize(halfWidth * halfHeight * 4);
+
+        // the rows of the level are split between the worker threads
+        jobSystem.parallelFor(halfHeight, MIPMAP_ROWS_PER_JOB,
+            [&] (unsigned row) {
+
+            util::img::halveRows(
+                &image[0], width, height, &half[0], row, row + 1);
+        });
+        image.swap(half);
+        width  = halfWidth;
+        height = halfHeight;
+
+        // the next level is built from the premultiplied pixels
+        levels.push_back(image);
+        if (!opaque) {
+
+            util::img::unpremultiply(&levels.back()[0], width * height);
+        }
+    }
+}
+
+
 } // namespace loader
 
-} // namespace omi
+} // namespace omi
\ No newline at end of file
@@ -55,4 +55,17 @@ Geometry* GeometryResource::get() {
     return m_geometry.get();
 }
 
+ResourceMemory GeometryResource::getMemoryUsage() const {
+
+    ResourceMemory memory = { 0, 0 };
+    if (m_loaded) {
+
+        memory.cpuBytes =
+            (m_geometry->vertices.size() * sizeof(util::vec::Vector3)) +
+            (m_geometry->uv.size()       * sizeof(util::vec::Vector2)) +
+            (m_geometry->normals.size()  * sizeof(util::vec::Vector3));
+    }
+    return memory;
+}
+
 } // namepsace omi
@@ -47,6 +47,9 @@ public:
     /** @return the loaded geometry */
     Geometry* get();
 
+    /** #Override */
+    ResourceMemory getMemoryUsage() const;
+
 private:
 
     //--------------------------------------------------------------------------
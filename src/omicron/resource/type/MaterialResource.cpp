@@ -33,25 +33,7 @@ void MaterialResource::load() {
 
     if (!m_loaded) {
 
-        //check if we are using a texture or not
-        // if (m_texture.compare("")) {
-
-        //     // create material with texture
-        //     m_material = Material(
-        //         ResourceManager::getShader(m_shader),
-        //         m_colour,
-        //         ResourceManager::getTexture(m_texture)
-        //     );
-        // }
-        // else {
-
-        //     // create material without texture
-        //     m_material = Material(
-        //         ResourceManager::getShader(m_shader),
-        //         m_colour,
-        //         NULL
-        //     );
-        // }
+        // materials are created each time they are got
         m_loaded = true;
     }
 }
@@ -60,7 +42,6 @@ void MaterialResource::release() {
 
     if (m_loaded) {
 
-        m_material = Material();
         m_loaded = false;
     }
 }
@@ -74,26 +55,24 @@ Material MaterialResource::get() {
         //TODO: throw an exception
     }
 
+    // a new material is created each time so that the texture's handle is
+    // only held by the users of the material
     if (m_texture.compare("")) {
 
         // create material with texture
-        m_material = Material(
+        return Material(
             ResourceManager::getShader(m_shader),
             m_colour,
             ResourceManager::getTexture(m_texture)
         );
     }
-    else {
 
-        // create material without texture
-        m_material = Material(
-            ResourceManager::getShader(m_shader),
-            m_colour,
-            NULL
-        );
-    }
-
-    return m_material;
+    // create material without texture
+    return Material(
+        ResourceManager::getShader(m_shader),
+        m_colour,
+        t_TextureHandle()
+    );
 }
 
 } // namespace omi
@@ -64,9 +64,6 @@ private:
     util::vec::Vector4 m_colour;
     // the resource id of the texture
     std::string m_texture;
-
-    // the omicron material
-    Material m_material;
 };
 
 } // namespace omi
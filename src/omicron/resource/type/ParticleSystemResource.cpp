@@ -0,0 +1,69 @@
+#include "ParticleSystemResource.hpp"
+
+namespace omi {
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+ParticleSystemResource::ParticleSystemResource(
+              resource_group::ResourceGroup resourceGroup,
+              int                           layer,
+        const std::string&                  material,
+        const util::vec::Vector2&           size,
+              unsigned                      frames,
+              float                         frameRate)
+    :
+    Resource   (resourceGroup),
+    m_layer    (layer),
+    m_material (material),
+    m_size     (size),
+    m_frames   (frames),
+    m_frameRate(frameRate) {
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+ParticleSystemResource::~ParticleSystemResource() {
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ParticleSystemResource::load() {
+
+    if (!m_loaded) {
+
+        // like sprites, particle systems are created when they are needed
+        m_loaded = true;
+    }
+}
+
+void ParticleSystemResource::release() {
+
+    if (m_loaded) {
+
+        m_loaded = false;
+    }
+}
+
+ParticleSystem* ParticleSystemResource::get(const std::string& id) const {
+
+    if (!m_loaded) {
+
+        std::cout << "attempted to get unloaded particle system" << std::endl;
+
+        //TODO: throw an exception
+    }
+
+    return new ParticleSystem(
+        id, m_layer,
+        ResourceManager::getMaterial(m_material),
+        m_size, m_frames, m_frameRate
+    );
+}
+
+} // namespace omi
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef OMICRON_RESOURCE_TYPE_PARTICLE_SYSTEM_RESOURCE_H_
+#   define OMICRON_RESOURCE_TYPE_PARTICLE_SYSTEM_RESOURCE_H_
+
+#include "src/omicron/resource/ResourceManager.hpp"
+
+class ResourceManager;
+
+#include "src/omicron/component/renderable/ParticleSystem.hpp"
+#include "src/omicron/resource/type/Resource.hpp"
+
+namespace omi {
+
+/*****************************************************\
+| Contains the needed data to load a particle system. |
+\*****************************************************/
+class ParticleSystemResource : public Resource {
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /** Creates a particle system resource
+    @param resourceGroup the resource group of the particle system
+    @param layer the layer of the particles
+    @param material the resource id of the particles' material
+    @param size the size of each particle
+    @param frames the number of frames in the material's texture atlas
+    @param frameRate the playback speed of the animation */
+    ParticleSystemResource(
+              resource_group::ResourceGroup resourceGroup,
+              int                           layer,
+        const std::string&                  material,
+        const util::vec::Vector2&           size,
+              unsigned                      frames,
+              float                         frameRate);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~ParticleSystemResource();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** #Override */
+    void load();
+
+    /** #Override */
+    void release();
+
+    /** @return a new particle system
+    @param id the component identifier of the particle system */
+    ParticleSystem* get(const std::string& id) const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                                 VARIABLES
+    //--------------------------------------------------------------------------
+
+    // the layer of the particles
+    int m_layer;
+    // the resource id of the particles' material
+    std::string m_material;
+    // the size of each particle
+    util::vec::Vector2 m_size;
+    // the number of frames in the texture atlas
+    unsigned m_frames;
+    // the playback speed of the animation
+    float m_frameRate;
+};
+
+} // namespace omi
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef OMICRON_RESOURCE_TYPE_RESOURCE_H_
 #   define OMICRON_RESOURCE_TYPE_RESOURCE_H_
 
+#include <atomic>
 #include <GL/glew.h>
 #include <iostream>
 #include <SFML/OpenGL.hpp>
@@ -12,10 +13,27 @@
 
 namespace omi {
 
-/**********************************************************************\
-| Abstract base class for all resources. Defines loading and releasing |
-| functions, and resource group access.                                |
-\**********************************************************************/
+//------------------------------------------------------------------------------
+//                                    STRUCTS
+//------------------------------------------------------------------------------
+
+//! the memory used by loaded resources
+struct ResourceMemory {
+
+    // the bytes of main memory used
+    unsigned long long cpuBytes;
+    // the bytes of video memory used
+    unsigned long long gpuBytes;
+};
+
+/***************************************************************************\
+| Abstract base class for all resources. Defines loading and releasing      |
+| functions, and resource group access.                                     |
+|                                                                           |
+| Resources count the handles to them that are in use. The resource manager |
+| defers releasing a resource that still has users until the last one drops |
+| it.                                                                       |
+\***************************************************************************/
 class Resource {
 private:
 
@@ -35,7 +53,8 @@ public:
     @param resourceGroup the resource group the resource is within */
     Resource(resource_group::ResourceGroup resourceGroup) :
         m_loaded       (false),
-        m_resourceGroup(resourceGroup) {
+        m_resourceGroup(resourceGroup),
+        m_users        (0) {
     }
 
     //--------------------------------------------------------------------------
@@ -67,6 +86,31 @@ public:
         return m_loaded;
     }
 
+    /** @return the memory used by the loaded resource */
+    virtual ResourceMemory getMemoryUsage() const {
+
+        ResourceMemory memory = { 0, 0 };
+        return memory;
+    }
+
+    /** Adds a user of the resource, this may be called from any thread */
+    void acquire() {
+
+        ++m_users;
+    }
+
+    /** Removes a user of the resource, this may be called from any thread */
+    void drop() {
+
+        --m_users;
+    }
+
+    /** @return the number of users of the resource */
+    unsigned getUsers() const {
+
+        return m_users;
+    }
+
 protected:
 
     //--------------------------------------------------------------------------
@@ -77,6 +121,8 @@ protected:
     bool m_loaded;
     // the resource group the resource is within
     resource_group::ResourceGroup m_resourceGroup;
+    // the number of handles to the resource that are in use
+    std::atomic<unsigned> m_users;
 };
 
 } // namespace omi
@@ -13,7 +13,8 @@ ShaderResource::ShaderResource(
     :
     Resource      (resourceGroup),
     m_vertexPath  (vertexPath),
-    m_fragmentPath(fragmentPath) {
+    m_fragmentPath(fragmentPath),
+    m_submitted   (false) {
 }
 
 //------------------------------------------------------------------------------
@@ -27,11 +28,22 @@ ShaderResource::~ShaderResource() {
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
+void ShaderResource::submit() {
+
+    if (!m_loaded && !m_submitted) {
+
+        m_pending = loader::beginShader(m_vertexPath, m_fragmentPath);
+        m_submitted = true;
+    }
+}
+
 void ShaderResource::load() {
 
     if (!m_loaded) {
 
-        m_shader = loader::loadShaderFromFiles(m_vertexPath, m_fragmentPath);
+        submit();
+        m_shader = loader::finishShader(m_pending);
+        m_submitted = false;
         m_loaded = true;
     }
 }
@@ -40,9 +52,12 @@ void ShaderResource::release() {
 
     if (m_loaded) {
 
-        glDeleteShader(m_shader.getVertexShader());
-        glDeleteShader(m_shader.getFragmentShader());
-        glDeleteProgram(m_shader.getProgram());
+        if (!systemSettings.isHeadless()) {
+
+            glDeleteShader(m_shader.getVertexShader());
+            glDeleteShader(m_shader.getFragmentShader());
+            glDeleteProgram(m_shader.getProgram());
+        }
         m_shader = Shader();
         m_loaded = false;
     }
@@ -34,6 +34,10 @@ public:
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
+    /** Hands the shader to the driver to compile without waiting for it, the
+    shader is finished by load */
+    void submit();
+
     /** #Override */
     void load();
 
@@ -54,6 +58,11 @@ private:
     // the path to the fragment shader
     std::string m_fragmentPath;
 
+    // if the shader has been submitted but not yet finished
+    bool m_submitted;
+    // the shader while it is being compiled
+    loader::PendingShader m_pending;
+
     // the omicron shader
     Shader m_shader;
 };
@@ -9,10 +9,12 @@ namespace omi {
 SoundResource::SoundResource(
               resource_group::ResourceGroup resourceGroup,
         const std::string&                  filePath,
-              unsigned                      instances) :
+              unsigned                      instances,
+              unsigned                      priority) :
     Resource   (resourceGroup),
     m_filePath (filePath),
-    m_instances(instances) {
+    m_instances(instances),
+    m_priority (priority) {
 }
 
 //------------------------------------------------------------------------------
@@ -31,7 +33,7 @@ void SoundResource::load() {
     if (!m_loaded) {
 
         // add to the sound pool and get the id back
-        m_id = SoundPool::load(m_filePath, m_instances);
+        m_id = SoundPool::load(m_filePath, m_instances, m_priority);
         m_loaded = true;
     }
 }
@@ -58,4 +60,14 @@ unsigned SoundResource::get() const {
     return m_id;
 }
 
+ResourceMemory SoundResource::getMemoryUsage() const {
+
+    ResourceMemory memory = { 0, 0 };
+    if (m_loaded) {
+
+        memory.cpuBytes = SoundPool::getBytes(m_id);
+    }
+    return memory;
+}
+
 } // namespace omi
\ No newline at end of file
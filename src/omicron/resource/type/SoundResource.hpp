@@ -19,12 +19,14 @@ public:
     /** Creates a new sound resource
     @param resourceGroup the resource group the sound is within
     @param filePath the location of the sound to load
-    @param instances the number of instances of this sound to be stored in the
-           sound pool */
+    @param instances the number of instances of this sound that can play at
+           once
+    @param priority the priority of the sound when voices are stolen */
     SoundResource(
                   resource_group::ResourceGroup resourceGroup,
             const std::string&                  filePath,
-                  unsigned                      instances);
+                  unsigned                      instances,
+                  unsigned                      priority);
 
     //--------------------------------------------------------------------------
     //                                 DESTRUCTOR
@@ -45,6 +47,9 @@ public:
     /** @return the id of the sound */
     unsigned get() const;
 
+    /** #Override */
+    ResourceMemory getMemoryUsage() const;
+
 private:
 
     //--------------------------------------------------------------------------
@@ -53,8 +58,10 @@ private:
 
     // the file path to the sound
     std::string m_filePath;
-    // the number of instances of this sound to store in the pool
+    // the number of instances of this sound that can play at once
     unsigned m_instances;
+    // the priority of the sound
+    unsigned m_priority;
 
     // the id of the sound
     unsigned m_id;
@@ -1,5 +1,8 @@
 #include "TextureResource.hpp"
 
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/resource/TextureResidency.hpp"
+
 namespace omi {
 
 //------------------------------------------------------------------------------
@@ -10,9 +13,15 @@ TextureResource::TextureResource(
               resource_group::ResourceGroup resourceGroup,
         const std::string&                  filePath)
     :
-    Resource  (resourceGroup),
-    m_type    (tex::TEXTURE),
-    m_filePath(filePath)       {        
+    Resource     (resourceGroup),
+    m_type       (tex::TEXTURE),
+    m_filePath   (filePath),
+    m_compression(tex::UNCOMPRESSED),
+    m_evicted    (false),
+    m_lastUsed   (0) {
+
+    m_memory.bytes = 0;
+    m_memory.uncompressedBytes = 0;
 }
 
 TextureResource::TextureResource(
@@ -23,13 +32,40 @@ TextureResource::TextureResource(
               unsigned                      begin,
               unsigned                      end)
     :
-    Resource   (resourceGroup),
-    m_type     (tex::ANIMATION),
-    m_filePath (filePath),
-    m_frameRate(frameRate),
-    m_repeat   (repeat),
-    m_begin    (begin),
-    m_end      (end) {
+    Resource     (resourceGroup),
+    m_type       (tex::ANIMATION),
+    m_filePath   (filePath),
+    m_frameRate  (frameRate),
+    m_repeat     (repeat),
+    m_begin      (begin),
+    m_end        (end),
+    m_compression(tex::UNCOMPRESSED),
+    m_evicted    (false),
+    m_lastUsed   (0) {
+
+    m_memory.bytes = 0;
+    m_memory.uncompressedBytes = 0;
+}
+
+TextureResource::TextureResource(
+              resource_group::ResourceGroup resourceGroup,
+        const std::string&                  filePath,
+              unsigned                      begin,
+              unsigned                      end)
+    :
+    Resource     (resourceGroup),
+    m_type       (tex::ATLAS),
+    m_filePath   (filePath),
+    m_frameRate  (0),
+    m_repeat     (false),
+    m_begin      (begin),
+    m_end        (end),
+    m_compression(tex::UNCOMPRESSED),
+    m_evicted    (false),
+    m_lastUsed   (0) {
+
+    m_memory.bytes = 0;
+    m_memory.uncompressedBytes = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -47,22 +83,38 @@ void TextureResource::load() {
 
     if (!m_loaded) {
 
+        m_memory.bytes = 0;
+        m_memory.uncompressedBytes = 0;
         switch (m_type) {
 
             case tex::TEXTURE: {
 
-                m_texture = std::unique_ptr<Texture>(
-                    loader::textureFromImage(m_filePath));
+                m_texture = std::unique_ptr<Texture>(loader::textureFromImage(
+                    m_filePath, m_compression, m_memory));
                 break;
             }
             case tex::ANIMATION: {
 
                 m_texture = std::unique_ptr<Texture>(loader::animationFromImage(
-                    m_filePath, m_frameRate, m_repeat, m_begin, m_end));
+                    m_filePath, m_frameRate, m_repeat, m_begin, m_end,
+                    m_compression, m_memory));
+                break;
+            }
+            case tex::ATLAS: {
+
+                m_texture = std::unique_ptr<Texture>(loader::atlasFromImage(
+                    m_filePath, m_begin, m_end, m_memory));
                 break;
             }
         }
+        countMemory(1);
         m_loaded = true;
+
+        // copies of the texture tell this resource when they are used
+        m_texture->setResidency(this);
+        m_evicted = false;
+        m_lastUsed = TextureResidency::getFrame();
+        TextureResidency::track(this);
     }
 }
 
@@ -70,9 +122,18 @@ void TextureResource::release() {
 
     if (m_loaded) {
 
-        GLuint id = m_texture->getId();
-        glDeleteTextures(1, &id);
+        TextureResidency::untrack(this);
+        if (!systemSettings.isHeadless()) {
+
+            t_TextureList ids = getIds();
+            glDeleteTextures(static_cast<GLsizei>(ids.size()), &ids[0]);
+        }
         m_texture = std::unique_ptr<Texture>();
+
+        countMemory(-1);
+        m_memory.bytes = 0;
+        m_memory.uncompressedBytes = 0;
+        m_evicted = false;
         m_loaded = false;
     }
 }
@@ -100,4 +161,118 @@ Texture* TextureResource::get() const {
     return tex;
 }
 
+const loader::TextureMemory& TextureResource::getMemory() const {
+
+    return m_memory;
+}
+
+ResourceMemory TextureResource::getMemoryUsage() const {
+
+    ResourceMemory memory = { 0, m_memory.bytes };
+    return memory;
+}
+
+void TextureResource::setCompression(tex::Compression compression) {
+
+    m_compression = compression;
+}
+
+void TextureResource::use() {
+
+    m_lastUsed = TextureResidency::getFrame();
+    if (m_evicted) {
+
+        TextureResidency::restore(this);
+    }
+}
+
+void TextureResource::evict() {
+
+    if (!m_loaded || m_evicted) {
+
+        return;
+    }
+
+    t_TextureList ids = getIds();
+    for (t_TextureList::const_iterator it = ids.begin();
+         it != ids.end(); ++it) {
+
+        loader::evictTexture(*it);
+    }
+
+    countMemory(-1);
+    m_memory.bytes = 0;
+    m_memory.uncompressedBytes = 0;
+    m_evicted = true;
+}
+
+void TextureResource::restore() {
+
+    OMI_PROFILE_SCOPE("TextureResource::restore");
+
+    if (!m_evicted) {
+
+        return;
+    }
+
+    // load into the same ids so copies of the texture stay valid
+    switch (m_type) {
+
+        case tex::TEXTURE: {
+
+            loader::reloadTexture(
+                m_texture->getId(), m_filePath, m_compression, m_memory);
+            break;
+        }
+        case tex::ANIMATION: {
+
+            loader::reloadAnimation(
+                getIds(), m_filePath, m_begin, m_compression, m_memory);
+            break;
+        }
+        case tex::ATLAS: {
+
+            loader::reloadAtlas(
+                m_texture->getId(), m_filePath, m_begin, m_end, m_memory);
+            break;
+        }
+    }
+    countMemory(1);
+    m_evicted = false;
+}
+
+bool TextureResource::isEvicted() const {
+
+    return m_evicted;
+}
+
+unsigned long long TextureResource::getLastUsed() const {
+
+    return m_lastUsed;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+t_TextureList TextureResource::getIds() const {
+
+    if (m_type == tex::ANIMATION) {
+
+        return dynamic_cast<Animation*>(m_texture.get())->getFrames();
+    }
+    return t_TextureList(1, m_texture->getId());
+}
+
+void TextureResource::countMemory(long long sign) {
+
+    static const unsigned bytesCounter =
+        counters::get("texture.bytes", counters::GAUGE);
+    static const unsigned uncompressedCounter =
+        counters::get("texture.uncompressed_bytes", counters::GAUGE);
+
+    counters::add(bytesCounter, sign * m_memory.bytes);
+    counters::add(uncompressedCounter, sign * m_memory.uncompressedBytes);
+}
+
 } // namespace omi
\ No newline at end of file
@@ -8,10 +8,12 @@
 
 namespace omi {
 
-/*********************************************\
-| Contains the needed data to load a texture. |
-\*********************************************/
-class TextureResource : public Resource {
+/*********************************************************************\
+| Contains the needed data to load a texture. Loaded textures may be  |
+| evicted from video memory by the texture residency and are reloaded |
+| into the same OpenGL textures the next time they are used.          |
+\*********************************************************************/
+class TextureResource : public Resource, public tex::Residency {
 public:
 
     //--------------------------------------------------------------------------
@@ -38,6 +40,16 @@ public:
                           unsigned                      begin,
                           unsigned                      end);
 
+    /** Creates a texture atlas resource from an image sequence
+    @param resourceGroup the resource group of the texture
+    @param filePath the path to the image file to use for the texture
+    @param begin the first frame of the sequence
+    @param end the last frame of the sequence */
+    TextureResource(      resource_group::ResourceGroup resourceGroup,
+                    const std::string&                  filePath,
+                          unsigned                      begin,
+                          unsigned                      end);
+
     //--------------------------------------------------------------------------
     //                                 DESTRUCTOR
     //--------------------------------------------------------------------------
@@ -57,6 +69,35 @@ public:
     /** @return the loaded texture */
     Texture* get() const;
 
+    /** @return the video memory used by the texture, zero until loaded */
+    const loader::TextureMemory& getMemory() const;
+
+    /** #Override */
+    ResourceMemory getMemoryUsage() const;
+
+    /** Sets the format the texture is compressed to in video memory. This
+    is ignored for atlases and takes effect the next time the texture is
+    loaded.
+    @param compression the compression to use */
+    void setCompression(tex::Compression compression);
+
+    /** #Override */
+    void use();
+
+    /** #Hidden
+    Frees the video memory of the loaded texture, keeping its OpenGL ids */
+    void evict();
+
+    /** #Hidden
+    Reloads an evicted texture into its OpenGL ids */
+    void restore();
+
+    /** @return if the texture is loaded but not in video memory */
+    bool isEvicted() const;
+
+    /** @return the frame the texture was last used in */
+    unsigned long long getLastUsed() const;
+
 private:
 
     //--------------------------------------------------------------------------
@@ -74,8 +115,29 @@ private:
     unsigned m_begin;
     unsigned m_end;
 
+    // the format the texture is compressed to
+    tex::Compression m_compression;
+    // the video memory used by the loaded texture
+    loader::TextureMemory m_memory;
+    // if the texture has been evicted from video memory
+    bool m_evicted;
+    // the frame the texture was last used in
+    unsigned long long m_lastUsed;
+
     // the omicron texture
     std::unique_ptr<Texture> m_texture;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /** @return the OpenGL ids of the loaded texture, one for each frame of an
+    animation */
+    t_TextureList getIds() const;
+
+    /** Adds or removes the texture's video memory from the counters
+    @param sign 1 to add the memory, -1 to remove it */
+    void countMemory(long long sign);
 };
 
 } // namespace omi
@@ -1,7 +1,21 @@
 #include "Scene.hpp"
 
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
+
 namespace omi {
 
+namespace {
+
+//------------------------------------------------------------------------------
+//                                   CONSTANTS
+//------------------------------------------------------------------------------
+
+// the number of parallel safe entities updated by a single job
+static const unsigned PARALLEL_GRAIN = 32;
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
@@ -48,6 +62,8 @@ bool Scene::removeEntity(Entity* entity) {
 
 void Scene::updateEntities() {
 
+    OMI_PROFILE_SCOPE("Scene::updateEntities");
+
     // find all the new entities and remove entities marked for removal
     std::vector<Entity*> newEntities;
     for (t_EntityList::iterator it = m_entities.begin();
@@ -83,19 +99,52 @@ void Scene::updateEntities() {
         m_entities.push_back(t_EntityPtr(*it));
     }
 
-    // iterate over all the existing entities in the scene and update them
-    // and collect all dirty components
+    static const unsigned entityCounter =
+        counters::get("scene.entities", counters::GAUGE);
+    counters::set(entityCounter, m_entities.size());
+
+    // split the entities into those that can be updated in parallel and
+    // those that must be updated serially
+    std::vector<Entity*> parallelEntities;
+    std::vector<Entity*> serialEntities;
     for (t_EntityList::iterator it = m_entities.begin();
          it != m_entities.end(); ++it) {
 
+        if ((*it)->isParallelSafe()) {
+
+            parallelEntities.push_back(it->get());
+        }
+        else {
+
+            serialEntities.push_back(it->get());
+        }
+    }
+
+    // update the parallel safe entities across the job system, new entities
+    // and removals are buffered by each entity so there is nothing to merge
+    jobSystem.parallelFor(parallelEntities.size(), PARALLEL_GRAIN,
+        [&parallelEntities] (unsigned i) {
+
+        parallelEntities[i]->update();
+    });
+
+    // then update the entities that may touch other entities
+    for (std::vector<Entity*>::iterator it = serialEntities.begin();
+         it != serialEntities.end(); ++it) {
+
         (*it)->update();
+    }
+
+    // collect all dirty components
+    for (t_EntityList::iterator it = m_entities.begin();
+         it != m_entities.end(); ++it) {
 
         // find new components
         for (std::vector<Component*>::iterator itc =
             (*it)->getComponents().newComponents.begin();
             itc != (*it)->getComponents().newComponents.end(); ++itc) {
 
-            newComponents.insert(*itc);
+            newComponents.push_back(*itc);
         }
         (*it)->getComponents().newComponents.clear();
         // find components to be removed
@@ -109,7 +158,7 @@ void Scene::updateEntities() {
 
         // find components to be removed
         if ((*it)->shouldRemove()) {
-            
+
             (*it)->getComponents().copyToList(removeComponents);
         }
     }
@@ -2,7 +2,6 @@
 #   define OMICRON_SCENE_SCENE_H_
 
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "src/omicron/Omicron.hpp"
@@ -26,9 +25,8 @@ public:
     //                                 VARIABLES
     //--------------------------------------------------------------------------
 
-    // TODO: why is this a set NO!
-    // the set of new components
-    std::set<Component*> newComponents;
+    // the list of new components in the order they were added
+    std::vector<Component*> newComponents;
     // the list of components to be removed
     std::vector<Component*> removeComponents;
 
@@ -11,7 +11,8 @@ AudioSettings::AudioSettings() :
     m_soundDisabled(false),
     m_musicDisabled(false),
     m_soundVolume  (1.0f),
-    m_musicVolume  (1.0f) {
+    m_musicVolume  (1.0f),
+    m_voiceCount   (32) {
 }
 
 //------------------------------------------------------------------------------
@@ -50,6 +51,11 @@ float AudioSettings::getMusicVolume() const {
     return m_musicVolume;
 }
 
+unsigned AudioSettings::getVoiceCount() const {
+
+    return m_voiceCount;
+}
+
 void AudioSettings::setSoundDisabled(bool disabled) {
 
     m_soundDisabled = disabled;
@@ -74,4 +80,10 @@ void AudioSettings::setMusicVolume(float volume) {
     m_change = true;
 }
 
+void AudioSettings::setVoiceCount(unsigned count) {
+
+    m_voiceCount = count;
+    m_change = true;
+}
+
 } // namespace omi
\ No newline at end of file
@@ -52,6 +52,9 @@ public:
     /** @return the master volume of music */
     float getMusicVolume() const;
 
+    /** @return the number of sounds that can play at once */
+    unsigned getVoiceCount() const;
+
     /** @param disabled whether sounds are disabled or not */
     void setSoundDisabled(bool disabled);
 
@@ -64,6 +67,9 @@ public:
     /** @param volume the master volume for music */
     void setMusicVolume(float volume);
 
+    /** @param count the number of sounds that can play at once */
+    void setVoiceCount(unsigned count);
+
 private:
 
     //--------------------------------------------------------------------------
@@ -81,6 +87,8 @@ private:
     float m_soundVolume;
     // the volume of music
     float m_musicVolume;
+    // the number of sounds that can play at once
+    unsigned m_voiceCount;
 };
 
 } // namespace omi
@@ -9,7 +9,8 @@ namespace omi {
 SystemSettings::SystemSettings() :
     m_change(true),
     m_cursorHidden(false),
-    m_cursorLocked(false) {
+    m_cursorLocked(false),
+    m_headless(false) {
 }
 
 //------------------------------------------------------------------------------
@@ -45,6 +46,11 @@ const util::vec::Vector2& SystemSettings::getCursorLockedPos() const {
     return m_cursorLockPos;
 }
 
+bool SystemSettings::isHeadless() const {
+
+    return m_headless;
+}
+
 void SystemSettings::setCursorHidden(bool hidden) {
 
     m_cursorHidden = hidden;
@@ -63,4 +69,9 @@ void SystemSettings::setCursorLockPosition(const util::vec::Vector2& pos) {
     m_change = true;
 }
 
+void SystemSettings::setHeadless(bool headless) {
+
+    m_headless = headless;
+}
+
 } // namespace omi
\ No newline at end of file
@@ -53,6 +53,9 @@ public:
     /** @return the position the mouse is locked */
     const util::vec::Vector2& getCursorLockedPos() const;
 
+    /** @return if Omicron is running without a window, renderer, or audio */
+    bool isHeadless() const;
+
     /** Sets if the cursor should be hidden */
     void setCursorHidden(bool hidden);
 
@@ -63,6 +66,12 @@ public:
     enabled */
     void setCursorLockPosition(const util::vec::Vector2& pos);
 
+    /** Sets if Omicron should run without a window, renderer, or audio. In
+    headless mode nothing is drawn or played, draw calls are only counted and
+    input is only read from replays.
+    #WARNING: this must be set before Omicron is initialised */
+    void setHeadless(bool headless);
+
 private:
 
     //--------------------------------------------------------------------------
@@ -78,6 +87,8 @@ private:
     bool m_cursorLocked;
     // the position to lock the cursor to if locking is enabled
     util::vec::Vector2 m_cursorLockPos;
+    // if Omicron is running without a window, renderer, or audio
+    bool m_headless;
 };
 
 } // namespace omi
@@ -7,13 +7,21 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include "lib/Utilitron/TimeUtil.hpp"
 #include "lib/Utilitron/Vector.hpp"
 
+#include "src/omicron/audio/Audio.hpp"
+#include "src/omicron/debug/Counters.hpp"
+#include "src/omicron/debug/Profiler.hpp"
 #include "src/omicron/display/Window.hpp"
 #include "src/omicron/input/Input.hpp"
+#include "src/omicron/input/Replay.hpp"
 #include "src/omicron/logic/LogicManager.hpp"
 #include "src/omicron/physics/collision_detect/CollisionDetect.hpp"
 #include "src/omicron/rendering/Renderer.hpp"
+#include "src/omicron/resource/ResourceManager.hpp"
+#include "src/omicron/resource/TextureResidency.hpp"
+#include "src/omicron/resource/loader/Loaders.hpp"
 #include "src/omicron/scene/Scene.hpp"
 #include "src/override/StartUp.hpp"
 #include "src/resource_pack/Packs.hpp"
@@ -33,6 +41,20 @@ std::unique_ptr<Renderer> renderer;
 // the logic manager
 std::unique_ptr<LogicManager> logicManager;
 
+// the number of frames to run before exiting, 0 to run forever
+unsigned long long frameLimit = 0;
+// the number of seconds to run before exiting, 0 to run forever
+float timeLimit = 0.0f;
+// the number of frames that have been run
+unsigned long long frameCount = 0;
+// the time the first frame began
+util::int64 startTime = 0;
+
+// the directory to capture frames to, empty to not capture
+std::string captureDirectory;
+// the format to capture frames in
+capture::Format captureFormat = capture::PNG;
+
 //------------------------------------------------------------------------------
 //                                   FUNCTIONS
 //------------------------------------------------------------------------------
@@ -41,6 +63,8 @@ std::unique_ptr<LogicManager> logicManager;
 them to their appropriate managers */
 void sortComponents() {
 
+    OMI_PROFILE_SCOPE("System::sortComponents");
+
     //sort the components to be removed
     for (std::vector<Component*>::iterator it =
         logicManager->getRemoveComponents().begin();
@@ -74,7 +98,7 @@ void sortComponents() {
     }
 
     // sort the new components
-    for (std::set<Component*>::iterator it =
+    for (std::vector<Component*>::iterator it =
         logicManager->getNewComponents().begin();
         it != logicManager->getNewComponents().end(); ++it) {
 
@@ -106,10 +130,49 @@ void sortComponents() {
     }
 }
 
+/** Writes the frames still being captured, whichever way the game exits,
+while the window and its context still exist */
+void finishCaptureOnExit() {
+
+    renderer->finishCapture();
+}
+
+/** Exits once the frame or time limit has been reached, reporting how many
+frames were run */
+void checkLimits() {
+
+    ++frameCount;
+
+    float elapsed = util::time::nsToMs(
+        util::time::getMonotonicTime() - startTime) / util::time::MS_IN_SEC;
+    if ((frameLimit == 0 || frameCount < frameLimit) &&
+        (timeLimit  <= 0.0f || elapsed < timeLimit)) {
+
+        return;
+    }
+
+    std::cout << "frames: " << frameCount << " draws: " <<
+        renderer->getTotalDrawCount() << " culled: " <<
+        renderer->getTotalCulledCount() << " seconds: " << elapsed <<
+        std::endl;
+    renderer->finishCapture();
+    if (TextureResidency::getBudget() > 0) {
+
+        TextureResidency::Stats stats = TextureResidency::getStats();
+        std::cout << "texture evictions: " << stats.evictions <<
+            " reloads: " << stats.reloads << " resident: " <<
+            (stats.residentBytes / 1024) << "KB of " <<
+            (TextureResidency::getBudget() / 1024) << "KB" << std::endl;
+    }
+    exit(0);
+}
+
 /** The main loop function of Omicron, controls callback to the rest of the
 engine */
 void execute() {
 
+    OMI_PROFILE_SCOPE("System::execute");
+
     // update logic
     if (logicManager->execute()) {
 
@@ -118,7 +181,7 @@ void execute() {
     }
 
     // lock the mouse if enabled
-    if (systemSettings.isCursorLocked()) {
+    if (systemSettings.isCursorLocked() && !systemSettings.isHeadless()) {
 
         sf::Mouse::setPosition(sf::Vector2i(
             static_cast<int>(systemSettings.getCursorLockedPos().x),
@@ -143,31 +206,72 @@ void execute() {
 
     // update the window
     window->update();
+
+    // release the resources whose last user was dropped this frame
+    ResourceManager::collect();
+
+    // evict the textures that haven't been used recently
+    TextureResidency::endFrame();
+
+    // record what happened this frame
+    counters::sample(fpsManager.getDeltaTime());
+
+    // stop if a limit has been reached
+    checkLimits();
 }
 
-/** Sets up Omicron */
-void init() {
+/** Sets up Omicron
+@param recordPath the file to record input to, or empty to not record
+@param replayPath the file to play input back from, or empty to not replay */
+void init(const std::string& recordPath, const std::string& replayPath) {
+
+    // seed random number generators, replays must use the recorded seed
+    unsigned seed = static_cast<unsigned>(time(NULL));
+    if (!replayPath.empty()) {
+
+        if (!replay::play(replayPath, seed)) {
 
-    // seed random number generators
-    srand(static_cast<unsigned>(time(NULL)));
+            exit(1);
+        }
+    }
+    else if (!recordPath.empty()) {
+
+        replay::record(recordPath, seed);
+    }
+    srand(seed);
 
     // run the start up script and get the first scene from it
     Scene* initScene = start_up::init();
 
     // create the window
-    window = std::unique_ptr<Window>(new Window());
+    window = std::unique_ptr<Window>(new Window(captureDirectory.empty()));
 
     // create the renderer
     renderer = std::unique_ptr<Renderer>(new Renderer());
 
     // initialise glew
-    glewInit();
+    if (!systemSettings.isHeadless()) {
+
+        glewInit();
+    }
+
+    // capture frames if enabled
+    if (!captureDirectory.empty()) {
+
+        renderer->startCapture(captureDirectory, captureFormat);
+        atexit(finishCaptureOnExit);
+    }
+
+    // create the audio backend
+    audio::init();
 
     // build the resource packs
     pack::build();
 
     // create the logic manager
     logicManager = std::unique_ptr<LogicManager>(new LogicManager(initScene));
+
+    startTime = util::time::getMonotonicTime();
 }
 
 } // namespace anonymous
@@ -180,10 +284,121 @@ void init() {
 
 int main(int argc, char** argv) {
 
-    // TODO: parse arguments
+    // parse arguments:
+    //     --record <file>    records input to the file
+    //     --replay <file>    plays back input recorded to the file
+    //     --profile <file>   writes a Chrome trace to the file at exit
+    //     --counters <file>  streams per frame counters to a CSV file
+    //     --headless         runs without a window, rendering, or audio
+    //     --audio-out <file> mixes audio in software and writes it to a WAV
+    //     --audio-null       mixes audio in software and discards it
+    //     --shader-cache <dir>
+    //                        caches linked shaders in the directory, an empty
+    //                        directory disables the cache
+    //     --texture-cache <dir>
+    //                        caches compressed textures in the directory, an
+    //                        empty directory disables the cache
+    //     --texture-budget <MB>
+    //                        evicts the least recently used textures to keep
+    //                        their video memory within the budget
+    //     --capture <dir>    writes every rendered frame to the directory
+    //     --capture-format <png|raw>
+    //                        the format to capture frames in, png by default
+    //     --fixed-tick <ms>  runs every tick at a fixed length
+    //     --frames <n>       exits after the given number of frames
+    //     --seconds <s>      exits after the given number of seconds
+    std::string recordPath;
+    std::string replayPath;
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg(argv[i]);
+        if (arg == "--record" && i + 1 < argc) {
+
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+
+            replayPath = argv[++i];
+        }
+        else if (arg == "--profile" && i + 1 < argc) {
+
+#ifdef OMICRON_PROFILE
+            omi::profile::dumpAtExit(argv[++i]);
+#else
+            ++i;
+            std::cout << "profiling is not enabled in this build" << std::endl;
+#endif
+        }
+        else if (arg == "--counters" && i + 1 < argc) {
+
+            omi::counters::stream(argv[++i]);
+        }
+        else if (arg == "--headless") {
+
+            omi::systemSettings.setHeadless(true);
+        }
+        else if (arg == "--audio-out" && i + 1 < argc) {
+
+            omi::audio::useSoftwareMixer(argv[++i]);
+        }
+        else if (arg == "--audio-null") {
+
+            omi::audio::useSoftwareMixer("");
+        }
+        else if (arg == "--shader-cache" && i + 1 < argc) {
+
+            omi::loader::setShaderCacheDirectory(argv[++i]);
+        }
+        else if (arg == "--texture-cache" && i + 1 < argc) {
+
+            omi::loader::setTextureCacheDirectory(argv[++i]);
+        }
+        else if (arg == "--texture-budget" && i + 1 < argc) {
+
+            omi::TextureResidency::setBudget(
+                strtoull(argv[++i], NULL, 10) * 1024 * 1024);
+        }
+        else if (arg == "--capture" && i + 1 < argc) {
+
+            omi::captureDirectory = argv[++i];
+        }
+        else if (arg == "--capture-format" && i + 1 < argc) {
+
+            std::string format(argv[++i]);
+            if (format == "raw") {
+
+                omi::captureFormat = omi::capture::RAW;
+            }
+            else if (format == "png") {
+
+                omi::captureFormat = omi::capture::PNG;
+            }
+            else {
+
+                std::cout << "unknown capture format: " << format << std::endl;
+            }
+        }
+        else if (arg == "--fixed-tick" && i + 1 < argc) {
+
+            omi::fpsManager.setFixedTick(
+                static_cast<float>(atof(argv[++i])));
+        }
+        else if (arg == "--frames" && i + 1 < argc) {
+
+            omi::frameLimit = strtoull(argv[++i], NULL, 10);
+        }
+        else if (arg == "--seconds" && i + 1 < argc) {
+
+            omi::timeLimit = static_cast<float>(atof(argv[++i]));
+        }
+        else {
+
+            std::cout << "unknown argument: " << arg << std::endl;
+        }
+    }
 
     // set up
-    omi::init();
+    omi::init(recordPath, replayPath);
 
     // begin
     while (true) {
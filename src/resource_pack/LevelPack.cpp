@@ -1,9 +1,17 @@
 #include "Packs.hpp"
 
+#include "src/entities/level/ShipBlueprint.hpp"
+
 namespace pack {
     
 void buildLevelPack() {
 
+    //--------------------------------------------------------------------------
+    //                              SHIP BLUEPRINTS
+    //--------------------------------------------------------------------------
+
+    ShipBlueprint::loadFile("res/data/level/ships.txt");
+
     //--------------------------------------------------------------------------
     //                                  SHADERS
     //--------------------------------------------------------------------------
@@ -115,6 +123,30 @@ void buildLevelPack() {
         util::vec::Vector2(0, 0)
     );
 
+    // the screen sized textures are by far the largest so they are kept
+    // compressed, the opaque ones as BC1 and those with alpha as BC3
+    static const char* OPAQUE_TEXTURES[] = {
+        "terrain", "terrain_grass", "terrain_grass_to_dirt",
+        "terrain_grass_to_cave", "terrain_dirt", "terrain_dirt_to_grass",
+        "terrain_dirt_to_desert", "terrain_desert", "terrain_desert_to_dirt",
+        "terrain_cave", "terrain_cave_to_grass"
+    };
+    static const char* ALPHA_TEXTURES[] = {
+        "title_screen", "insert_coin", "cave_opening"
+    };
+    for (unsigned i = 0;
+         i < sizeof(OPAQUE_TEXTURES) / sizeof(OPAQUE_TEXTURES[0]); ++i) {
+
+        omi::ResourceManager::setTextureCompression(
+            OPAQUE_TEXTURES[i], omi::tex::BC1);
+    }
+    for (unsigned i = 0;
+         i < sizeof(ALPHA_TEXTURES) / sizeof(ALPHA_TEXTURES[0]); ++i) {
+
+        omi::ResourceManager::setTextureCompression(
+            ALPHA_TEXTURES[i], omi::tex::BC3);
+    }
+
     //----------------------------------BLOCKS----------------------------------
 
     // HUB PLAYER
@@ -377,96 +409,120 @@ void buildLevelPack() {
     );
 
     //FX
-    omi::ResourceManager::addTextureMaterialSprite(
+    // the frames of each explosion are packed into one texture so all
+    // explosions of a type can be drawn at once
+    omi::ResourceManager::addTextureAtlas(
+        "bullet_explosion", resource_group::LEVEL,
+        "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png",
+        1, 19
+    );
+    omi::ResourceManager::addTextureAtlas(
+        "block_explosion", resource_group::LEVEL,
+        "res/gfx/texture/level/fx/block_explosion_1/explosion.png",
+        1, 19
+    );
+    omi::ResourceManager::addMaterial(
         "bullet_explosion_1", resource_group::LEVEL,
         "effect_shader",
         util::vec::Vector4(1.0f, 1.0f, 0.0f, 1.0f),
-        "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png",
-        60, false, 1, 19, BULLET_EXPLOSION,
+        "bullet_explosion"
+    );
+    omi::ResourceManager::addParticleSystem(
+        "bullet_explosion_1", resource_group::LEVEL,
+        BULLET_EXPLOSION, "bullet_explosion_1",
         util::vec::Vector2(2.0, 2.0),
-        util::vec::Vector2(1, 1),
-        util::vec::Vector2(0, 0)
+        19, 60.0f
     );
-    omi::ResourceManager::addTextureMaterialSprite(
+    omi::ResourceManager::addMaterial(
         "bullet_explosion_2", resource_group::LEVEL,
         "effect_shader",
         util::vec::Vector4(0.0f, 0.75f, 1.0f, 1.0f),
-        "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png",
-        60, false, 1, 19, BULLET_EXPLOSION,
+        "bullet_explosion"
+    );
+    omi::ResourceManager::addParticleSystem(
+        "bullet_explosion_2", resource_group::LEVEL,
+        BULLET_EXPLOSION, "bullet_explosion_2",
         util::vec::Vector2(2.0, 2.0),
-        util::vec::Vector2(1, 1),
-        util::vec::Vector2(0, 0)
+        19, 60.0f
     );
-    omi::ResourceManager::addTextureMaterialSprite(
+    omi::ResourceManager::addMaterial(
         "bullet_explosion_3", resource_group::LEVEL,
         "effect_shader",
         util::vec::Vector4(1.0f, 0.0f, 0.0f, 1.0f),
-        "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png",
-        60, false, 1, 19, BULLET_EXPLOSION,
+        "bullet_explosion"
+    );
+    omi::ResourceManager::addParticleSystem(
+        "bullet_explosion_3", resource_group::LEVEL,
+        BULLET_EXPLOSION, "bullet_explosion_3",
         util::vec::Vector2(2.0, 2.0),
-        util::vec::Vector2(1, 1),
-        util::vec::Vector2(0, 0)
+        19, 60.0f
     );
-    omi::ResourceManager::addTextureMaterialSprite(
+    omi::ResourceManager::addMaterial(
         "bullet_explosion_4", resource_group::LEVEL,
         "effect_shader",
         util::vec::Vector4(1.0f, 0.5f, 0.0f, 1.0f),
-        "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png",
-        60, false, 1, 19, BULLET_EXPLOSION,
+        "bullet_explosion"
+    );
+    omi::ResourceManager::addParticleSystem(
+        "bullet_explosion_4", resource_group::LEVEL,
+        BULLET_EXPLOSION, "bullet_explosion_4",
         util::vec::Vector2(2.0, 2.0),
-        util::vec::Vector2(1, 1),
-        util::vec::Vector2(0, 0)
+        19, 60.0f
     );
-    omi::ResourceManager::addTextureMaterialSprite(
+    omi::ResourceManager::addMaterial(
         "bullet_explosion_5", resource_group::LEVEL,
         "effect_shader",
         util::vec::Vector4(0.5f, 0.0f, 1.0f, 1.0f),
-        "res/gfx/texture/level/fx/bullet_explosion_1/explosion.png",
-        60, false, 1, 19, BULLET_EXPLOSION,
+        "bullet_explosion"
+    );
+    omi::ResourceManager::addParticleSystem(
+        "bullet_explosion_5", resource_group::LEVEL,
+        BULLET_EXPLOSION, "bullet_explosion_5",
         util::vec::Vector2(2.0, 2.0),
-        util::vec::Vector2(1, 1),
-        util::vec::Vector2(0, 0)
+        19, 60.0f
     );
-    omi::ResourceManager::addTextureMaterialSprite(
+    omi::ResourceManager::addMaterial(
         "block_explosion_1", resource_group::LEVEL,
         "effect_shader",
         util::vec::Vector4(0.0f, 0.0f, 0.0f, 1.0f),
-        "res/gfx/texture/level/fx/block_explosion_1/explosion.png",
-        60, false, 1, 19, BULLET_EXPLOSION,
+        "block_explosion"
+    );
+    omi::ResourceManager::addParticleSystem(
+        "block_explosion_1", resource_group::LEVEL,
+        BULLET_EXPLOSION, "block_explosion_1",
         util::vec::Vector2(4.0, 4.0),
-        util::vec::Vector2(1, 1),
-        util::vec::Vector2(0, 0)
+        19, 60.0f
     );
 
     //----------------------------------SOUNDS----------------------------------
 
     omi::ResourceManager::addSound(
         "bullet_rusty", resource_group::LEVEL,
-        "res/sound/fx/level/rusty.ogg", 3
+        "res/sound/fx/level/rusty.ogg", 3, 1
     );
     omi::ResourceManager::addSound(
         "bullet_steel", resource_group::LEVEL,
-        "res/sound/fx/level/steel.ogg", 3
+        "res/sound/fx/level/steel.ogg", 3, 1
     );
     omi::ResourceManager::addSound(
         "bullet_copper", resource_group::LEVEL,
-        "res/sound/fx/level/copper.ogg", 3
+        "res/sound/fx/level/copper.ogg", 3, 1
     );
     omi::ResourceManager::addSound(
         "bullet_titanium", resource_group::LEVEL,
-        "res/sound/fx/level/titanium.ogg", 3
+        "res/sound/fx/level/titanium.ogg", 3, 1
     );
     omi::ResourceManager::addSound(
         "bullet_silver", resource_group::LEVEL,
-        "res/sound/fx/level/silver.ogg", 3
+        "res/sound/fx/level/silver.ogg", 3, 1
     );
     omi::ResourceManager::addSound(
         "bullet_gold", resource_group::LEVEL,
-        "res/sound/fx/level/gold.ogg", 3
+        "res/sound/fx/level/gold.ogg", 3, 1
     );
     omi::ResourceManager::addSound(
         "block_explosion", resource_group::LEVEL,
-        "res/sound/fx/level/block_explosion.ogg", 4
+        "res/sound/fx/level/block_explosion.ogg", 4, 2
     );
 }
 
@@ -65,7 +65,7 @@ void buildStartUpPack() {
 
     omi::ResourceManager::addSound(
         "omicron_intro", resource_group::START_UP,
-        "res/sound/fx/start_up/omicron_intro.ogg", 1
+        "res/sound/fx/start_up/omicron_intro.ogg", 1, 3
     );
 }
 
@@ -40,7 +40,7 @@ void buildTestPack() {
 
     omi::ResourceManager::addSound(
         "test_sound_1", resource_group::TEST,
-        "res/sound/fx/test/test_sound_2.ogg", 3
+        "res/sound/fx/test/test_sound_2.ogg", 3, 1
     );
 }
 
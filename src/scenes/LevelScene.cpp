@@ -37,6 +37,7 @@ void LevelScene::init() {
     // add entities
     addEntity(new Terrain());
     addEntity(new PlayerShip());
+    addEntity(new Explosion());
 
 }
 
@@ -8,6 +8,7 @@
 #include "src/override/Values.hpp"
 
 #include "src/entities/level/EnemyShip.hpp"
+#include "src/entities/level/Explosion.hpp"
 #include "src/entities/level/PlayerShip.hpp"
 #include "src/entities/level/Terrain.hpp"
 